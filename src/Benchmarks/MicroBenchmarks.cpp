@@ -0,0 +1,520 @@
+#include "MicroBenchmarks.h"
+#include "../common/CompressedIntColumn.h"
+#include "../common/DateParser.h"
+#include "../common/FusedFilterScan.h"
+#include "../common/GeoDistance.h"
+#include "../common/MappedFile.h"
+#include "../common/NumericParser.h"
+#include "../common/RangeCount.h"
+#include "../common/SimdCsvTokenizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Values of the given CSV columns, one vector per column; the views point into file
+std::vector<std::vector<std::string_view>> readColumns(const MappedFile& file, const std::vector<size_t>& columns) {
+    std::vector<std::vector<std::string_view>> values(columns.size());
+    const char* header_end = static_cast<const char*>(memchr(file.data(), '\n', file.size()));
+    if (!header_end) return values;
+
+    size_t field_limit = 0;
+    for (size_t column : columns) field_limit = std::max(field_limit, column + 1);
+
+    SimdCsvTokenizer tokenizer(header_end + 1, file.data() + file.size());
+    SimdCsvTokenizer::Fields fields;
+    while (size_t field_count = tokenizer.nextRow(fields, field_limit)) {
+        for (size_t i = 0; i < columns.size(); i++) {
+            values[i].push_back(columns[i] < field_count ? fields[columns[i]] : std::string_view());
+        }
+    }
+    return values;
+}
+
+std::vector<std::string_view> readColumn(const MappedFile& file, size_t column) {
+    return std::move(readColumns(file, {column})[0]);
+}
+
+// Restores the std::cout formatting a benchmark changed when it returns
+class CoutFormatGuard {
+public:
+    ~CoutFormatGuard() {
+        std::cout.flags(flags);
+        std::cout.precision(precision);
+    }
+
+private:
+    std::ios_base::fmtflags flags = std::cout.flags();
+    std::streamsize precision = std::cout.precision();
+};
+
+constexpr int kRepetitions = 5;
+
+// Best of kRepetitions runs, so page faults and cold caches of the first pass don't count
+template <typename Fn>
+double timeSeconds(Fn&& fn) {
+    double best = 0;
+    for (int i = 0; i < kRepetitions; i++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+        if (i == 0 || elapsed.count() < best) best = elapsed.count();
+    }
+    return best;
+}
+
+void printResult(const char* name, double seconds, size_t items, double baseline_seconds) {
+    std::cout << "  " << std::left << std::setw(34) << name << std::right << std::setw(10) << std::fixed
+              << std::setprecision(1) << seconds * 1e9 / items << " ns/value" << std::setw(10)
+              << std::setprecision(1) << baseline_seconds / seconds << "x\n";
+    std::cout.unsetf(std::ios::fixed);
+}
+
+// The conversion the epoch-time loader used before DateParser
+time_t legacyConvertDateToEpoch(const std::string& date_str) {
+    std::tm tm = {};
+    std::istringstream ss(date_str);
+    ss >> std::get_time(&tm, "%m/%d/%Y");
+    if (ss.fail()) return 0;
+    return std::mktime(&tm);
+}
+
+enum class NumericKind { Float, Int, Long };
+
+struct NumericField {
+    const char* name;
+    size_t column;
+    NumericKind kind;
+};
+
+// The numeric columns of the crash CSV
+const NumericField kNumericFields[] = {
+    {"LATITUDE", 4, NumericKind::Float},
+    {"LONGITUDE", 5, NumericKind::Float},
+    {"NUMBER OF PERSONS INJURED", 10, NumericKind::Int},
+    {"NUMBER OF PERSONS KILLED", 11, NumericKind::Int},
+    {"NUMBER OF PEDESTRIANS INJURED", 12, NumericKind::Int},
+    {"NUMBER OF PEDESTRIANS KILLED", 13, NumericKind::Int},
+    {"NUMBER OF CYCLIST INJURED", 14, NumericKind::Int},
+    {"NUMBER OF CYCLIST KILLED", 15, NumericKind::Int},
+    {"NUMBER OF MOTORIST INJURED", 16, NumericKind::Int},
+    {"NUMBER OF MOTORIST KILLED", 17, NumericKind::Int},
+    {"COLLISION_ID", 23, NumericKind::Long},
+};
+
+// The conversion the loaders used before NumericParser: a std::string per field and an
+// exception for every empty or malformed one. Returns false when it threw.
+bool legacyParse(std::string_view field, NumericKind kind, double& value) {
+    try {
+        switch (kind) {
+            case NumericKind::Float: value = std::stof(std::string(field)); break;
+            case NumericKind::Int: value = std::stoi(std::string(field)); break;
+            case NumericKind::Long: value = double(std::stol(std::string(field))); break;
+        }
+        return true;
+    } catch (...) {
+        value = 0;
+        return false;
+    }
+}
+
+bool numericParse(std::string_view field, NumericKind kind, double& value) {
+    bool parsed = false;
+    switch (kind) {
+        case NumericKind::Float: { float v = 0.0f; parsed = NumericParser::parseFloat(field, v); value = v; break; }
+        case NumericKind::Int: { int v = 0; parsed = NumericParser::parseInt(field, v); value = v; break; }
+        case NumericKind::Long: { long v = 0; parsed = NumericParser::parseInt(field, v); value = double(v); break; }
+    }
+    return parsed;
+}
+
+// Range count over the plain column vs over its compressed form, on the middle half of the values
+template <typename T>
+void benchmarkCompressedScan(const char* name, const std::vector<T>& values) {
+    std::vector<T> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    const T low = sorted[sorted.size() / 4];
+    const T high = sorted[sorted.size() * 3 / 4];
+    CompressedIntColumn packed = CompressedIntColumn::encode(values);
+
+    size_t plain_count = 0, packed_count = 0;
+    double plain = timeSeconds([&] {
+        plain_count = 0;
+        for (T value : values) plain_count += value >= low && value <= high;
+    });
+    double compressed = timeSeconds([&] { packed_count = packed.countInRange(low, high); });
+
+    using Codec = CompressedIntColumn::Codec;
+    std::cout << "  " << name << ": " << std::fixed << std::setprecision(2) << double(sizeof(T)) << " -> "
+              << double(packed.memoryBytes()) / values.size() << " bytes/value ("
+              << double(values.size() * sizeof(T)) / packed.memoryBytes() << "x smaller; "
+              << packed.blockCount(Codec::FrameOfReference) << " frame-of-reference, " << packed.blockCount(Codec::Delta)
+              << " delta, " << packed.blockCount(Codec::Constant) << " constant blocks)\n";
+    std::cout.unsetf(std::ios::fixed);
+    printResult("    plain range count", plain, values.size(), plain);
+    printResult("    compressed range count", compressed, values.size(), plain);
+    if (plain_count != packed_count) {
+        std::cout << "    MISMATCH: plain " << plain_count << ", compressed " << packed_count << "\n";
+    }
+}
+
+// Columns are repeated up to this size so the range counts stream from memory, not cache
+constexpr size_t kStreamBytes = 64 << 20;
+
+// GB/s of RangeCount on the middle half of the values, per instruction set this CPU runs
+template <typename T>
+void benchmarkRangeCount(const char* name, std::vector<T> values) {
+    std::vector<T> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    const T low = sorted[sorted.size() / 4];
+    const T high = sorted[sorted.size() * 3 / 4];
+
+    const size_t rows = values.size();
+    const size_t target = std::max(rows, kStreamBytes / sizeof(T));
+    values.reserve(target);
+    for (size_t i = rows; i < target; i++) values.push_back(values[i - rows]);
+
+    std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1);
+    size_t expected = 0;
+    for (RangeCount::Isa isa : {RangeCount::Isa::Scalar, RangeCount::Isa::Sse42, RangeCount::Isa::Avx2,
+                                RangeCount::Isa::Avx512}) {
+        if (!RangeCount::supported(isa)) {
+            std::cout << std::setw(10) << "-";
+            continue;
+        }
+        size_t matches = 0;
+        double seconds = timeSeconds([&] { matches = RangeCount::count(values.data(), values.size(), low, high, isa); });
+        if (isa == RangeCount::Isa::Scalar) expected = matches;
+        std::cout << std::setw(10) << double(values.size() * sizeof(T)) / seconds / 1e9;
+        if (matches != expected) std::cout << " (MISMATCH " << matches << " vs " << expected << ")";
+    }
+    std::cout << "\n";
+    std::cout.unsetf(std::ios::fixed);
+}
+
+} // namespace
+
+void MicroBenchmarks::runAll(const std::string& filename) {
+    runDateParserBenchmark(filename);
+    std::cout << "\n";
+    runNumericParserBenchmark(filename);
+    std::cout << "\n";
+    runCompressedScanBenchmark(filename);
+    std::cout << "\n";
+    runLocationScanBenchmark(filename);
+    std::cout << "\n";
+    runRangeCountBenchmark(filename);
+    std::cout << "\n";
+    runFusedFilterBenchmark(filename);
+}
+
+void MicroBenchmarks::runDateParserBenchmark(const std::string& filename) {
+    CoutFormatGuard format_guard;
+    MappedFile file;
+    if (!file.open(filename)) return;
+    std::vector<std::string_view> dates = readColumn(file, 0);
+    if (dates.empty()) return;
+
+    std::cout << "Date parsing, " << dates.size() << " crash dates:\n";
+
+    long long checksum = 0;
+    double legacy = timeSeconds([&] {
+        for (std::string_view date : dates) checksum += legacyConvertDateToEpoch(std::string(date)) / 86400;
+    });
+    printResult("istringstream + get_time + mktime", legacy, dates.size(), legacy);
+
+    std::vector<int32_t> days(dates.size());
+    double scalar = timeSeconds([&] {
+        for (size_t i = 0; i < dates.size(); i++) days[i] = DateParser::parseDate(dates[i]);
+    });
+    for (int32_t day : days) checksum += day;
+    printResult("DateParser::parseDate", scalar, dates.size(), legacy);
+
+    double batch = timeSeconds([&] { DateParser::parseDates(dates.data(), dates.size(), days.data()); });
+    for (int32_t day : days) checksum += day;
+    std::string batch_name = std::string("DateParser::parseDates (") + DateParser::batchIsaName() + ")";
+    printResult(batch_name.c_str(), batch, dates.size(), legacy);
+
+    std::cout << "  (checksum " << checksum << ")\n";
+}
+
+void MicroBenchmarks::runNumericParserBenchmark(const std::string& filename) {
+    CoutFormatGuard format_guard;
+    MappedFile file;
+    if (!file.open(filename)) return;
+
+    std::vector<size_t> columns;
+    for (const NumericField& numeric : kNumericFields) columns.push_back(numeric.column);
+    std::vector<std::vector<std::string_view>> values = readColumns(file, columns);
+    if (values.empty() || values[0].empty()) return;
+
+    std::cout << "Numeric fields, " << values[0].size() << " rows:\n";
+    std::cout << "  " << std::left << std::setw(31) << "column" << std::right << std::setw(12) << "exceptions"
+              << std::setw(14) << "stoX ns" << std::setw(18) << "NumericParser ns" << "\n";
+
+    size_t total_fields = 0, total_exceptions = 0;
+    double total_legacy = 0, total_throwing = 0, total_numeric = 0;
+    double checksum = 0;
+    for (size_t c = 0; c < values.size(); c++) {
+        const NumericField& numeric = kNumericFields[c];
+        const std::vector<std::string_view>& fields = values[c];
+
+        // Fields the old path throws on, timed on their own to price the exceptions
+        std::vector<std::string_view> throwing;
+        for (std::string_view field : fields) {
+            double value = 0;
+            if (!legacyParse(field, numeric.kind, value)) throwing.push_back(field);
+        }
+
+        double legacy = timeSeconds([&] {
+            for (std::string_view field : fields) {
+                double value = 0;
+                legacyParse(field, numeric.kind, value);
+                checksum += value;
+            }
+        });
+        double throwing_time = throwing.empty() ? 0 : timeSeconds([&] {
+            for (std::string_view field : throwing) {
+                double value = 0;
+                legacyParse(field, numeric.kind, value);
+            }
+        });
+        size_t invalid = 0;
+        double parsed = timeSeconds([&] {
+            invalid = 0;
+            for (std::string_view field : fields) {
+                double value = 0;
+                invalid += !numericParse(field, numeric.kind, value);
+                checksum += value;
+            }
+        });
+
+        std::cout << "  " << std::left << std::setw(31) << numeric.name << std::right << std::setw(12)
+                  << throwing.size() << std::fixed << std::setprecision(1) << std::setw(14)
+                  << legacy * 1e9 / fields.size() << std::setw(18) << parsed * 1e9 / fields.size() << "\n";
+        std::cout.unsetf(std::ios::fixed);
+        if (invalid != throwing.size()) {
+            std::cout << "    (NumericParser rejected " << invalid << ": stoX also accepts a numeric prefix)\n";
+        }
+
+        total_fields += fields.size();
+        total_exceptions += throwing.size();
+        total_legacy += legacy;
+        total_throwing += throwing_time;
+        total_numeric += parsed;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Exceptions thrown: " << total_exceptions << " of " << total_fields << " fields ("
+              << 100.0 * total_exceptions / total_fields << "%)\n";
+    std::cout << "  stoX total: " << total_legacy * 1000 << " ms, of which throwing fields: " << total_throwing * 1000
+              << " ms";
+    if (total_exceptions > 0) std::cout << " (" << total_throwing * 1e9 / total_exceptions << " ns per exception)";
+    std::cout << "\n";
+    std::cout << "  NumericParser total: " << total_numeric * 1000 << " ms (" << total_legacy / total_numeric
+              << "x faster)\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << "  (checksum " << checksum << ")\n";
+}
+
+void MicroBenchmarks::runCompressedScanBenchmark(const std::string& filename) {
+    CoutFormatGuard format_guard;
+    MappedFile file;
+    if (!file.open(filename)) return;
+    std::vector<std::vector<std::string_view>> values = readColumns(file, {0, 10, 23});
+    if (values.empty() || values[0].empty()) return;
+
+    const size_t rows = values[0].size();
+    std::vector<int32_t> dates(rows);
+    DateParser::parseDates(values[0].data(), rows, dates.data());
+    std::vector<int> injured(rows);
+    std::vector<long> collision_ids(rows);
+    for (size_t i = 0; i < rows; i++) {
+        injured[i] = NumericParser::toInt(values[1][i]);
+        collision_ids[i] = NumericParser::toInt<long>(values[2][i]);
+    }
+
+    std::cout << "Compressed column scans, " << rows << " rows, " << CompressedIntColumn::kBlockRows
+              << "-row blocks:\n";
+    benchmarkCompressedScan("CRASH DATE (days)", dates);
+    benchmarkCompressedScan("NUMBER OF PERSONS INJURED", injured);
+    benchmarkCompressedScan("COLLISION_ID", collision_ids);
+}
+
+void MicroBenchmarks::runLocationScanBenchmark(const std::string& filename) {
+    CoutFormatGuard format_guard;
+    MappedFile file;
+    if (!file.open(filename)) return;
+    std::vector<std::vector<std::string_view>> values = readColumns(file, {4, 5});
+    if (values.empty() || values[0].empty()) return;
+
+    const size_t rows = values[0].size();
+    std::vector<float> latitudes(rows), longitudes(rows);
+    for (size_t i = 0; i < rows; i++) {
+        latitudes[i] = NumericParser::toFloat(values[0][i]);
+        longitudes[i] = NumericParser::toFloat(values[1][i]);
+    }
+
+    // Lower Manhattan, 2 km: a few percent of the rows, like a typical neighbourhood query
+    constexpr double kLat = 40.7128, kLon = -74.0060, kRadiusKm = 2;
+    const GeoCircle circle = GeoDistance::circle(kLat, kLon, kRadiusKm);
+    const float radius_degrees = float(kRadiusKm / GeoDistance::kKmPerDegree);
+    std::cout << "Location radius counts, " << rows << " rows, " << kRadiusKm << " km around (" << kLat << ", "
+              << kLon << "):\n";
+
+    size_t legacy_count = 0, haversine_count = 0, scalar_count = 0, kernel_count = 0;
+    double legacy = timeSeconds([&] {
+        legacy_count = 0;
+        for (size_t i = 0; i < rows; i++) {
+            float dist = std::sqrt(std::pow(latitudes[i] - float(kLat), 2) + std::pow(longitudes[i] - float(kLon), 2));
+            legacy_count += dist <= radius_degrees;
+        }
+    });
+    double haversine = timeSeconds([&] {
+        haversine_count = 0;
+        for (size_t i = 0; i < rows; i++) {
+            if (!std::isfinite(latitudes[i]) || !std::isfinite(longitudes[i])) continue;
+            haversine_count += GeoDistance::haversineKm(kLat, kLon, latitudes[i], longitudes[i]) <= kRadiusKm;
+        }
+    });
+    double scalar = timeSeconds([&] {
+        scalar_count = 0;
+        for (size_t i = 0; i < rows; i++) scalar_count += GeoDistance::contains(circle, latitudes[i], longitudes[i]);
+    });
+    double kernel = timeSeconds([&] {
+        kernel_count = GeoDistance::countWithin(latitudes.data(), longitudes.data(), rows, circle);
+    });
+
+    printResult("pow/sqrt in degrees (old)", legacy, rows, legacy);
+    printResult("haversine", haversine, rows, legacy);
+    printResult("GeoDistance::contains", scalar, rows, legacy);
+    std::string kernel_name = std::string("GeoDistance::countWithin (") + GeoDistance::isaName() + ")";
+    printResult(kernel_name.c_str(), kernel, rows, legacy);
+    std::cout << "  Matches: haversine " << haversine_count << ", GeoDistance " << kernel_count
+              << ", old degree test " << legacy_count << "\n";
+    if (scalar_count != kernel_count) {
+        std::cout << "  MISMATCH: scalar " << scalar_count << ", " << GeoDistance::isaName() << " " << kernel_count
+                  << "\n";
+    }
+}
+
+void MicroBenchmarks::runRangeCountBenchmark(const std::string& filename) {
+    CoutFormatGuard format_guard;
+    MappedFile file;
+    if (!file.open(filename)) return;
+    std::vector<std::vector<std::string_view>> values = readColumns(file, {0, 1, 4, 10, 23});
+    if (values.empty() || values[0].empty()) return;
+
+    const size_t rows = values[0].size();
+    std::vector<int32_t> dates(rows);
+    DateParser::parseDates(values[0].data(), rows, dates.data());
+    std::vector<uint16_t> times(rows);
+    std::vector<float> latitudes(rows);
+    std::vector<uint8_t> injured(rows);
+    std::vector<int64_t> collision_ids(rows);
+    for (size_t i = 0; i < rows; i++) {
+        times[i] = DateParser::parseTimeOfDay(values[1][i]);
+        latitudes[i] = NumericParser::toFloat(values[2][i]);
+        injured[i] = uint8_t(std::clamp(NumericParser::toInt(values[3][i]), 0, 255));
+        collision_ids[i] = NumericParser::toInt<int64_t>(values[4][i]);
+    }
+
+    std::cout << "Range counts in GB/s (best ISA: " << RangeCount::isaName(RangeCount::bestIsa()) << "), columns repeated to "
+              << (kStreamBytes >> 20) << " MB:\n";
+    std::cout << "  " << std::left << std::setw(28) << "column" << std::right;
+    for (RangeCount::Isa isa : {RangeCount::Isa::Scalar, RangeCount::Isa::Sse42, RangeCount::Isa::Avx2,
+                                RangeCount::Isa::Avx512}) {
+        std::cout << std::setw(10) << RangeCount::isaName(isa);
+    }
+    std::cout << "\n";
+    benchmarkRangeCount("CRASH DATE (int32 days)", std::move(dates));
+    benchmarkRangeCount("COLLISION_ID (int64)", std::move(collision_ids));
+    benchmarkRangeCount("LATITUDE (float)", std::move(latitudes));
+    benchmarkRangeCount("PERSONS INJURED (uint8)", std::move(injured));
+    benchmarkRangeCount("CRASH TIME (uint16 minutes)", std::move(times));
+}
+
+void MicroBenchmarks::runFusedFilterBenchmark(const std::string& filename) {
+    CoutFormatGuard format_guard;
+    MappedFile file;
+    if (!file.open(filename)) return;
+    std::vector<std::vector<std::string_view>> values = readColumns(file, {0, 4, 5, 10});
+    if (values.empty() || values[0].empty()) return;
+
+    // Repeated to kStreamBytes of the four columns, so every pass streams from memory
+    const size_t rows = values[0].size();
+    constexpr size_t kRowBytes = sizeof(int32_t) + sizeof(int) + 2 * sizeof(float);
+    const size_t target = std::max(rows, kStreamBytes / kRowBytes);
+    std::vector<int32_t> dates(target);
+    std::vector<int> injured(target);
+    std::vector<float> latitudes(target), longitudes(target);
+    DateParser::parseDates(values[0].data(), rows, dates.data());
+    for (size_t i = 0; i < rows; i++) {
+        latitudes[i] = NumericParser::toFloat(values[1][i]);
+        longitudes[i] = NumericParser::toFloat(values[2][i]);
+        injured[i] = NumericParser::toInt(values[3][i]);
+    }
+    for (size_t i = rows; i < target; i++) {
+        dates[i] = dates[i - rows];
+        injured[i] = injured[i - rows];
+        latitudes[i] = latitudes[i - rows];
+        longitudes[i] = longitudes[i - rows];
+    }
+
+    CrashFilters filters;
+    filters.first_day = DateParser::parseDate("01/01/2015");
+    filters.last_day = DateParser::parseDate("12/31/2016");
+    filters.min_injured = 1;
+    filters.max_injured = 3;
+    filters.circle = GeoDistance::circle(40.7128, -74.0060, 2);
+    std::cout << "Date + injury + location counts, " << target << " rows (" << (target * kRowBytes >> 20)
+              << " MB of columns), " << FusedFilterScan::kBlockRows << "-row blocks:\n";
+
+    CrashFilterCounts separate, fused;
+    double three_passes = timeSeconds([&] {
+        separate.date = RangeCount::count(dates.data(), target, filters.first_day, filters.last_day);
+        separate.injury = RangeCount::count(injured.data(), target, filters.min_injured, filters.max_injured);
+        separate.location = GeoDistance::countWithin(latitudes.data(), longitudes.data(), target, filters.circle);
+    });
+    double combined_pass = timeSeconds([&] {
+        separate.all = 0;
+        for (size_t i = 0; i < target; i++) {
+            separate.all += dates[i] >= filters.first_day && dates[i] <= filters.last_day &&
+                            injured[i] >= filters.min_injured && injured[i] <= filters.max_injured &&
+                            GeoDistance::contains(filters.circle, latitudes[i], longitudes[i]);
+        }
+    });
+    double one_pass = timeSeconds([&] {
+        fused = FusedFilterScan::count(dates.data(), injured.data(), latitudes.data(), longitudes.data(), target, filters);
+    });
+
+    // Bytes each approach reads: every column once per pass over it
+    const double column_bytes = double(target * kRowBytes);
+    auto print = [&](const char* name, double seconds, double bytes) {
+        std::cout << "  " << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << seconds * 1000 << " ms" << std::setw(8) << std::setprecision(0)
+                  << bytes / (1 << 20) << " MB read" << std::setw(8) << std::setprecision(1)
+                  << (three_passes + combined_pass) / seconds << "x\n";
+        std::cout.unsetf(std::ios::fixed);
+    };
+    print("separate counts (no combined count)", three_passes, column_bytes);
+    print("separate counts + combined pass", three_passes + combined_pass, 2 * column_bytes);
+    print("fused (one pass)", one_pass, column_bytes);
+    std::cout << "  Counts: date " << fused.date << ", injury " << fused.injury << ", location " << fused.location
+              << ", all " << fused.all << "\n";
+    if (separate.date != fused.date || separate.injury != fused.injury || separate.location != fused.location ||
+        separate.all != fused.all) {
+        std::cout << "  MISMATCH: separate " << separate.date << "/" << separate.injury << "/" << separate.location
+                  << "/" << separate.all << "\n";
+    }
+}
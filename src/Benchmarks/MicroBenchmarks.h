@@ -0,0 +1,32 @@
+#ifndef MICRO_BENCHMARKS_H
+#define MICRO_BENCHMARKS_H
+
+#include <string>
+
+// Single-threaded micro-benchmarks over the columns of the real CSV
+class MicroBenchmarks {
+public:
+    static void runAll(const std::string& filename);
+
+    // std::get_time + std::mktime (the old loader path) vs DateParser, scalar and batch
+    static void runDateParserBenchmark(const std::string& filename);
+
+    // std::stof/stoi/stol with try/catch vs NumericParser; counts the exceptions the old path throws
+    static void runNumericParserBenchmark(const std::string& filename);
+
+    // Range counts over plain columns vs CompressedIntColumn, with the compression achieved
+    static void runCompressedScanBenchmark(const std::string& filename);
+
+    // Location radius counts: the old per-row pow/sqrt in degrees vs GeoDistance, scalar and
+    // dispatched, checked against haversine
+    static void runLocationScanBenchmark(const std::string& filename);
+
+    // RangeCount throughput in GB/s per instruction set, for each column width it supports
+    static void runRangeCountBenchmark(const std::string& filename);
+
+    // Date + injury + location counts as separate passes (plus a pass for the combined count)
+    // vs FusedFilterScan's one cache-blocked pass, on columns repeated past the caches
+    static void runFusedFilterBenchmark(const std::string& filename);
+};
+
+#endif // MICRO_BENCHMARKS_H
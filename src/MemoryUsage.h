@@ -6,6 +6,25 @@
 
 class MemoryUsage {
 public:
+    static size_t getResidentSizeMB() {
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+            return 0;
+        }
+        return info.resident_size / (1024 * 1024);
+    }
+
+    // Highest resident size the process has reached so far
+    static size_t getPeakResidentSizeMB() {
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+            return 0;
+        }
+        return info.resident_size_max / (1024 * 1024);
+    }
+
     static void printMemoryUsage(const std::string& methodName) {
         mach_task_basic_info info;
         mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
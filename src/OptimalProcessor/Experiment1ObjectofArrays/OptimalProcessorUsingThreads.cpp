@@ -1,4 +1,7 @@
 #include "OptimalProcessorUsingThreads.h"
+#include "../../common/GeoDistance.h"
+#include "../../common/NumericParser.h"
+#include "../../common/RangeCount.h"
 #include <iostream>
 #include <sstream>
 #include <fstream>
@@ -41,10 +44,10 @@ void OptimalProcessorUsingThreads::loadData(const std::string& filename) {
         std::getline(ss, record.zip_code, ',');
 
         std::getline(ss, token, ',');
-        record.latitude = token.empty() ? 0.0f : std::stof(token);
+        record.latitude = NumericParser::toFloat(token);
 
         std::getline(ss, token, ',');
-        record.longitude = token.empty() ? 0.0f : std::stof(token);
+        record.longitude = NumericParser::toFloat(token);
 
         std::getline(ss, record.location, ',');
         std::getline(ss, record.on_street_name, ',');
@@ -52,20 +55,15 @@ void OptimalProcessorUsingThreads::loadData(const std::string& filename) {
         std::getline(ss, record.off_street_name, ',');
 
         std::getline(ss, token, ',');
-        try { record.persons_injured = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.persons_injured = 0; }
+        record.persons_injured = NumericParser::toInt(token);
 
-        try { record.cyclists_injured = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.cyclists_injured = 0; }
+        record.cyclists_injured = NumericParser::toInt(token);
 
-        try { record.cyclists_killed = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.cyclists_killed = 0; }
+        record.cyclists_killed = NumericParser::toInt(token);
 
-        try { record.motorists_injured = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.motorists_injured = 0; }
+        record.motorists_injured = NumericParser::toInt(token);
 
-        try { record.motorists_killed = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.motorists_killed = 0; }
+        record.motorists_killed = NumericParser::toInt(token);
 
         std::getline(ss, record.contributing_factor_vehicle_1, ',');
         std::getline(ss, record.contributing_factor_vehicle_2, ',');
@@ -73,8 +71,7 @@ void OptimalProcessorUsingThreads::loadData(const std::string& filename) {
         std::getline(ss, record.contributing_factor_vehicle_4, ',');
         std::getline(ss, record.contributing_factor_vehicle_5, ',');
 
-        try { record.collision_id= token.empty() ? 0 : std::stol(token); }
-        catch (const std::exception&) { record.collision_id = 0; }
+        record.collision_id = NumericParser::toInt<long>(token);
         std::getline(ss, record.vehicle_type_code_1, ',');
         std::getline(ss, record.vehicle_type_code_2, ',');
         std::getline(ss, record.vehicle_type_code_3, ',');
@@ -161,12 +158,7 @@ int OptimalProcessorUsingThreads::getCrashesByInjuryCountRange(int min_injuries,
     // std::vector<CrashRecord> filtered_crashes;
     int crash_count = 0;
 
-    #pragma omp parallel for reduction(+:crash_count)
-    for (size_t i = 0; i < persons_injured.size(); i++) {
-        if (persons_injured[i] >= min_injuries && persons_injured[i] <= max_injuries) {
-            crash_count++;
-        }
-    }
+    crash_count = int(RangeCount::countColumn(persons_injured, min_injuries, max_injuries));
 
     auto end = std::chrono::high_resolution_clock::now();
     injury_range_Searching_duration = end - start;
@@ -179,13 +171,7 @@ int OptimalProcessorUsingThreads::getCrashesByLocationRange(float lat, float lon
     // std::vector<CrashRecord> filtered_crashes;
     int crash_count = 0;
 
-    #pragma omp parallel for reduction(+:crash_count)
-    for (size_t i = 0; i < latitudes.size(); i++) {
-        float dist = std::sqrt(std::pow(latitudes[i] - lat, 2) + std::pow(longitudes[i] - lon, 2));
-        if (dist <= radius) {
-            crash_count++;
-        }
-    }
+    crash_count = int(GeoDistance::countWithin(latitudes, longitudes, GeoDistance::circle(lat, lon, radius)));
 
     auto end = std::chrono::high_resolution_clock::now();
     location_range_Searching_duration = end - start;
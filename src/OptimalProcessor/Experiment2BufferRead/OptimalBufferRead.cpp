@@ -1,4 +1,7 @@
 #include "OptimalBufferRead.h"
+#include "../../common/GeoDistance.h"
+#include "../../common/NumericParser.h"
+#include "../../common/RangeCount.h"
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -72,12 +75,10 @@ void OptimalBufferRead::processLinesParallel(const std::vector<std::string>& lin
         std::getline(ss, record.zip_code, ',');
 
         std::getline(ss, token, ',');
-        try { record.latitude = token.empty() ? 0.0f : std::stof(token); }
-        catch (...) { record.latitude = 0.0f; }
+        record.latitude = NumericParser::toFloat(token);
 
         std::getline(ss, token, ',');
-        try { record.longitude = token.empty() ? 0.0f : std::stof(token); }
-        catch (...) { record.longitude = 0.0f; }
+        record.longitude = NumericParser::toFloat(token);
 
         std::getline(ss, record.location, ',');
         std::getline(ss, record.on_street_name, ',');
@@ -85,24 +86,18 @@ void OptimalBufferRead::processLinesParallel(const std::vector<std::string>& lin
         std::getline(ss, record.off_street_name, ',');
 
         std::getline(ss, token, ',');
-        try { record.persons_injured = token.empty() ? 0 : std::stoi(token); }
-        catch (...) { record.persons_injured = 0; }
+        record.persons_injured = NumericParser::toInt(token);
 
         std::getline(ss, token, ',');
-        try { record.persons_killed = token.empty() ? 0 : std::stoi(token); }
-        catch (...) { record.persons_killed = 0; }
+        record.persons_killed = NumericParser::toInt(token);
 
-        try { record.cyclists_injured = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.cyclists_injured = 0; }
+        record.cyclists_injured = NumericParser::toInt(token);
 
-        try { record.cyclists_killed = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.cyclists_killed = 0; }
+        record.cyclists_killed = NumericParser::toInt(token);
 
-        try { record.motorists_injured = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.motorists_injured = 0; }
+        record.motorists_injured = NumericParser::toInt(token);
 
-        try { record.motorists_killed = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.motorists_killed = 0; }
+        record.motorists_killed = NumericParser::toInt(token);
 
         std::getline(ss, record.contributing_factor_vehicle_1, ',');
         std::getline(ss, record.contributing_factor_vehicle_2, ',');
@@ -110,8 +105,7 @@ void OptimalBufferRead::processLinesParallel(const std::vector<std::string>& lin
         std::getline(ss, record.contributing_factor_vehicle_4, ',');
         std::getline(ss, record.contributing_factor_vehicle_5, ',');
 
-        try { record.collision_id= token.empty() ? 0 : std::stol(token); }
-        catch (const std::exception&) { record.collision_id = 0; }
+        record.collision_id = NumericParser::toInt<long>(token);
         std::getline(ss, record.vehicle_type_code_1, ',');
         std::getline(ss, record.vehicle_type_code_2, ',');
         std::getline(ss, record.vehicle_type_code_3, ',');
@@ -190,12 +184,7 @@ int OptimalBufferRead::getCrashesByInjuryCountRange(int min_injuries, int max_in
     auto start = std::chrono::high_resolution_clock::now();
     int crash_count = 0;
 
-    #pragma omp parallel for reduction(+:crash_count)
-    for (size_t i = 0; i < persons_injured.size(); i++) {
-        if (persons_injured[i] >= min_injuries && persons_injured[i] <= max_injuries) {
-            crash_count++;
-        }
-    }
+    crash_count = int(RangeCount::countColumn(persons_injured, min_injuries, max_injuries));
 
     auto end = std::chrono::high_resolution_clock::now();
     injury_range_Searching_duration = end - start;
@@ -206,13 +195,7 @@ int OptimalBufferRead::getCrashesByLocationRange(float lat, float lon, float rad
     auto start = std::chrono::high_resolution_clock::now();
     int crash_count = 0;
 
-    #pragma omp parallel for reduction(+:crash_count)
-    for (size_t i = 0; i < latitudes.size(); i++) {
-        float dist = std::sqrt(std::pow(latitudes[i] - lat, 2) + std::pow(longitudes[i] - lon, 2));
-        if (dist <= radius) {
-            crash_count++;
-        }
-    }
+    crash_count = int(GeoDistance::countWithin(latitudes, longitudes, GeoDistance::circle(lat, lon, radius)));
 
     auto end = std::chrono::high_resolution_clock::now();
     location_range_Searching_duration = end - start;
@@ -1,4 +1,7 @@
 #include "ProcessorUsingPartialRead.h"
+#include "../../common/GeoDistance.h"
+#include "../../common/NumericParser.h"
+#include "../../common/RangeCount.h"
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -9,10 +12,13 @@
 #include <sstream>
 #include <sys/mman.h>
 #include <unistd.h>
+#include <cstring>
 #include "../../MemoryUsage.h"
+#include "../../common/SimdCsvTokenizer.h"
+#include "../../common/ParallelCsvSplitter.h"
 
-
-
+ProcessorUsingPartialRead::ProcessorUsingPartialRead(bool use_simd_tokenizer)
+    : use_simd_tokenizer(use_simd_tokenizer) {}
 
 
 void ProcessorUsingPartialRead::loadData(const std::string& filename) {
@@ -84,6 +90,7 @@ void ProcessorUsingPartialRead::loadData(const std::string& filename) {
 void ProcessorUsingPartialRead::processFileParallel(char* data, size_t file_size) {
     int num_threads = std::thread::hardware_concurrency();
     std::cout << "Using " << num_threads << " threads for parallel processing.\n";
+    std::cout << "Tokenizer: " << (use_simd_tokenizer ? SimdCsvTokenizer::isaName() : "scalar byte loop") << "\n";
 
     // Thread-local buffers
     std::vector<std::vector<std::string>> crash_dates_local(num_threads);
@@ -111,25 +118,26 @@ void ProcessorUsingPartialRead::processFileParallel(char* data, size_t file_size
     std::vector<std::vector<std::string>> vehicle_type_code_6_local(num_threads);
 
 
-    size_t chunk_size = file_size / num_threads;
+    const char* file_end = data + file_size;
+    // Skip the header row, then hand every thread a row-aligned chunk
+    const char* header_end = static_cast<const char*>(memchr(data, '\n', file_size));
+    const char* rows_begin = header_end ? header_end + 1 : file_end;
+
+    auto split_start = std::chrono::high_resolution_clock::now();
+    std::vector<const char*> chunk_bounds = use_simd_tokenizer
+        ? ParallelCsvSplitter::split(rows_begin, file_end, num_threads)
+        : ParallelCsvSplitter::splitNaive(rows_begin, file_end, num_threads);
+    std::chrono::duration<double> split_duration = std::chrono::high_resolution_clock::now() - split_start;
+    std::cout << "Chunk split (" << (use_simd_tokenizer ? "quote-aware" : "naive") << "): "
+              << split_duration.count() * 1000 << " ms, "
+              << (file_size / (1024.0 * 1024.0)) / split_duration.count() << " MB/s\n";
 
     #pragma omp parallel num_threads(num_threads)
     {
         int thread_id = omp_get_thread_num();
-        char* start_pos = data + (thread_id * chunk_size);
-        char* end_pos = (thread_id == num_threads - 1) ? data + file_size : start_pos + chunk_size;
+        const char* start_pos = chunk_bounds[thread_id];
+        const char* chunk_end = chunk_bounds[thread_id + 1];
 
-        // Ensure each thread starts at the beginning of a new line
-        if (thread_id != 0) {
-            while (*start_pos != '\n' && start_pos < end_pos) {
-                start_pos++;
-            }
-            if (start_pos < end_pos) {
-                start_pos++;
-            }
-        }
-
-        char* line_start = start_pos;
         auto& local_crash_dates = crash_dates_local[thread_id];
         auto& local_persons_injured = persons_injured_local[thread_id];
         auto& local_latitudes = latitudes_local[thread_id];
@@ -154,123 +162,73 @@ void ProcessorUsingPartialRead::processFileParallel(char* data, size_t file_size
         auto& local_vehicle_type_code_5 = vehicle_type_code_5_local[thread_id];
         auto& local_vehicle_type_code_6 = vehicle_type_code_6_local[thread_id];
 
+        // Fields are indexed by column, so both tokenizers share the same row materialization
+        auto appendRow = [&](const SimdCsvTokenizer::Fields& fields, size_t field_count) {
+            auto field = [&](size_t col) { return col < field_count ? fields[col] : std::string_view(); };
 
-        while (line_start < end_pos) {
-            char* line_end = line_start;
-            while (line_end < end_pos && *line_end != '\n') {
-                line_end++;
-            }
-            if (line_end >= end_pos) break;
-
-            std::string_view line(line_start, line_end - line_start);
-            line_start = line_end + 1; // Move to next line
-
-            size_t col_index = 0;
-            size_t pos = 0;
-            std::string_view token;
-            float lat = 0.0f, lon = 0.0f;
-            int injured = 0;
-            std::string crash_date;
-            std::string crash_time;
-            std::string borough;
-            std:: string zip_code;
-            std::string locations;
-            std::string on_street_name;
-            std::string cross_street_name;
-            std::string off_street_name;
-            int number_of_persons_injured = 0;
-            int number_of_persons_killed = 0;
-            int number_of_pedestrians_injured = 0;
-            int number_of_pedestrians_killed = 0;
-            int number_of_cyclists_injured = 0;
-            int number_of_cyclists_killed = 0;
-            int number_of_motorists_injured = 0;
-            int number_of_motorists_killed = 0;
-            std::string contributing_factor_vehicle_1;
-            std::string contributing_factor_vehicle_2;
-            std::string contributing_factor_vehicle_3;
-            std::string contributing_factor_vehicle_4;
-            std::string contributing_factor_vehicle_5;
-            std::string vehicle_type_code_1;
-            std::string vehicle_type_code_2;
-            std::string vehicle_type_code_3;
-            std:: string vehicle_type_code_4;
-            std::string vehicle_type_code_5;
-            std::string vehicle_type_code_6;
-            long collision_id = 0;
-
-            while (pos < line.size()) {
-                size_t next_pos = line.find(',', pos);
-                if (next_pos == std::string::npos) next_pos = line.size();
-                token = line.substr(pos, next_pos - pos);
-                pos = next_pos + 1;
-
-                switch (col_index) {
-                    case 0: crash_date = std::string(token); break;
-                    case 1: crash_time = std::string(token); break;
-                    case 2: borough = std::string(token); break;
-                    case 3: zip_code = std::string(token); break;
-                    case 4: try { lat = std::stof(std::string(token)); } catch (...) { lat = 0.0f; } break;
-                    case 5: try { lon = std::stof(std::string(token)); } catch (...) { lon = 0.0f; } break;
-                    case 6: locations = std::string(token); break;
-                    case 7: on_street_name = std::string(token); break;
-                    case 8: cross_street_name = std::string(token); break;
-                    case 9: off_street_name = std::string(token); break;
-                    case 10: try {
-                        number_of_persons_injured = std::stoi(std::string(token));
-                    } catch (...) {
-                        number_of_persons_injured = 0;
-                    } break;
-                    case 11: try { number_of_persons_killed = std::stoi(std::string(token)); } catch (...) { number_of_persons_killed = 0; } break;
-                    case 12: try { number_of_pedestrians_injured = std::stoi(std::string(token)); } catch (...) { number_of_pedestrians_injured = 0; } break;
-                    case 13: try { number_of_pedestrians_killed = std::stoi(std::string(token)); } catch (...) { number_of_pedestrians_killed = 0; } break;
-                    case 14: try { number_of_cyclists_injured = std::stoi(std::string(token)); } catch (...) { number_of_cyclists_injured = 0; } break;
-                    case 15: try { number_of_cyclists_killed = std::stoi(std::string(token)); } catch (...) { number_of_cyclists_killed = 0; } break;
-                    case 16: try { number_of_motorists_injured = std::stoi(std::string(token)); } catch (...) { number_of_motorists_injured = 0; } break;
-                    case 17: try { number_of_motorists_killed = std::stoi(std::string(token)); } catch (...) { number_of_motorists_killed = 0; } break;
-                    case 18: contributing_factor_vehicle_1 = std::string(token); break;
-                    case 19: contributing_factor_vehicle_2 = std::string(token); break;
-                    case 20: contributing_factor_vehicle_3 = std::string(token); break;
-                    case 21: contributing_factor_vehicle_4 = std::string(token); break;
-                    case 22: contributing_factor_vehicle_5 = std::string(token); break;
-                    case 23: try { collision_id = std::stol(std::string(token)); } catch (...) { collision_id = 0; } break;
-                    case 24: vehicle_type_code_1 = std::string(token); break;
-                    case 25: vehicle_type_code_2 = std::string(token); break;
-                    case 26: vehicle_type_code_3 = std::string(token); break;
-                    case 27: vehicle_type_code_4 = std::string(token); break;
-                    case 28: vehicle_type_code_5 = std::string(token); break;
-                    case 29: vehicle_type_code_6 = std::string(token); break;
-                    case 30: try { injured = std::stoi(std::string(token)); } catch (...) { injured = 0; } break;
-                }
-
-                col_index++;
-                if (col_index > 30) break; // Only process required columns
-            }
+            float lat = NumericParser::toFloat(field(4));
+            float lon = NumericParser::toFloat(field(5));
+            long collision_id = NumericParser::toInt<long>(field(23));
+            int injured = NumericParser::toInt(field(10));
 
-            local_crash_dates.push_back(crash_date);
+            local_crash_dates.emplace_back(field(0));
             local_latitudes.push_back(lat);
             local_longitudes.push_back(lon);
             local_persons_injured.push_back(injured);
-            local_crash_time.push_back(crash_time);
-            local_borough.push_back(borough);
-            local_zip_code.push_back(zip_code);
-            local_locations.push_back(locations);
-            local_on_street_name.push_back(on_street_name);
-            local_cross_street_name.push_back(cross_street_name);
-            local_off_street_name.push_back(off_street_name);
-            local_contributing_factor_vehicle_1.push_back(contributing_factor_vehicle_1);
-            local_contributing_factor_vehicle_2.push_back(contributing_factor_vehicle_2);
-            local_contributing_factor_vehicle_3.push_back(contributing_factor_vehicle_3);
-            local_contributing_factor_vehicle_4.push_back(contributing_factor_vehicle_4);
-            local_contributing_factor_vehicle_5.push_back(std::string(contributing_factor_vehicle_5));
+            local_crash_time.emplace_back(field(1));
+            local_borough.emplace_back(field(2));
+            local_zip_code.emplace_back(field(3));
+            local_locations.emplace_back(field(6));
+            local_on_street_name.emplace_back(field(7));
+            local_cross_street_name.emplace_back(field(8));
+            local_off_street_name.emplace_back(field(9));
+            local_contributing_factor_vehicle_1.emplace_back(field(18));
+            local_contributing_factor_vehicle_2.emplace_back(field(19));
+            local_contributing_factor_vehicle_3.emplace_back(field(20));
+            local_contributing_factor_vehicle_4.emplace_back(field(21));
+            local_contributing_factor_vehicle_5.emplace_back(field(22));
             local_collision_ids.push_back(collision_id);
-            local_vehicle_type_code_1.push_back(std::string(vehicle_type_code_1));
-            local_vehicle_type_code_2.push_back(std::string(vehicle_type_code_2));
-            local_vehicle_type_code_3.push_back(std::string(vehicle_type_code_3));
-            local_vehicle_type_code_4.push_back(std::string(vehicle_type_code_4));
-            local_vehicle_type_code_5.push_back(std::string(vehicle_type_code_5));
-            local_vehicle_type_code_6.push_back(std::string(vehicle_type_code_6));
-
+            local_vehicle_type_code_1.emplace_back(field(24));
+            local_vehicle_type_code_2.emplace_back(field(25));
+            local_vehicle_type_code_3.emplace_back(field(26));
+            local_vehicle_type_code_4.emplace_back(field(27));
+            local_vehicle_type_code_5.emplace_back(field(28));
+            local_vehicle_type_code_6.emplace_back(field(29));
+        };
+
+        SimdCsvTokenizer::Fields fields;
+        if (use_simd_tokenizer) {
+            SimdCsvTokenizer tokenizer(start_pos, chunk_end);
+            while (size_t field_count = tokenizer.nextRow(fields)) {
+                if (field_count > 1) appendRow(fields, field_count);
+            }
+        } else {
+            // Scalar baseline: one byte at a time, with the same quote handling and field rules
+            // as the SIMD tokenizer, so both load the same columns
+            const char* row_start = start_pos;
+            while (row_start < chunk_end) {
+                size_t field_count = 0;
+                bool in_quotes = false;
+                const char* field_start = row_start;
+                const char* pos = row_start;
+                for (; pos < chunk_end; pos++) {
+                    if (*pos == '"') {
+                        in_quotes = !in_quotes;
+                    } else if (!in_quotes && (*pos == ',' || *pos == '\n')) {
+                        if (field_count < SimdCsvTokenizer::kMaxFields) {
+                            fields[field_count++] = SimdCsvTokenizer::fieldView(field_start, pos);
+                        }
+                        field_start = pos + 1;
+                        if (*pos == '\n') break;
+                    }
+                }
+                if (pos == chunk_end && field_count < SimdCsvTokenizer::kMaxFields) {
+                    // Last row of the chunk has no trailing newline
+                    fields[field_count++] = SimdCsvTokenizer::fieldView(field_start, chunk_end);
+                }
+                row_start = pos + 1;
+                if (field_count > 1) appendRow(fields, field_count);
+            }
         }
     }
 
@@ -350,12 +308,7 @@ int ProcessorUsingPartialRead::getCrashesByInjuryCountRange(int min_injuries, in
     auto start = std::chrono::high_resolution_clock::now();
     int crash_count = 0;
 
-    #pragma omp parallel for reduction(+:crash_count)
-    for (size_t i = 0; i < persons_injured.size(); i++) {
-        if (persons_injured[i] >= min_injuries && persons_injured[i] <= max_injuries) {
-            crash_count++;
-        }
-    }
+    crash_count = int(RangeCount::countColumn(persons_injured, min_injuries, max_injuries));
 
     auto end = std::chrono::high_resolution_clock::now();
     injury_range_Searching_duration = end - start;
@@ -366,13 +319,7 @@ int ProcessorUsingPartialRead::getCrashesByLocationRange(float lat, float lon, f
     auto start = std::chrono::high_resolution_clock::now();
     int crash_count = 0;
 
-    #pragma omp parallel for reduction(+:crash_count)
-    for (size_t i = 0; i < latitudes.size(); i++) {
-        float dist = std::sqrt(std::pow(latitudes[i] - lat, 2) + std::pow(longitudes[i] - lon, 2));
-        if (dist <= radius) {
-            crash_count++;
-        }
-    }
+    crash_count = int(GeoDistance::countWithin(latitudes, longitudes, GeoDistance::circle(lat, lon, radius)));
 
     auto end = std::chrono::high_resolution_clock::now();
     location_range_Searching_duration = end - start;
@@ -42,10 +42,14 @@ private:
     std::chrono::duration<double> injury_range_Searching_duration = {};
     std::chrono::duration<double> location_range_Searching_duration = {};
 
+    bool use_simd_tokenizer;
+
     void processLinesParallel(const std::vector<std::string>& lines);
     void processFileParallel(char* data, size_t file_size);
 
 public:
+    // use_simd_tokenizer = false keeps a scalar byte-loop splitter as a baseline
+    explicit ProcessorUsingPartialRead(bool use_simd_tokenizer = true);
     void loadData(const std::string& filename) override;
     int getCrashesInDateRange(const std::string& start_date, const std::string& end_date) override;
     int getCrashesByInjuryCountRange(int min_injuries, int max_injuries) override;
@@ -1,55 +1,347 @@
 #include "ProcessorUsingEpochTime.h"
+#include "../../common/NumericParser.h"
+#include <array>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <vector>
 #include <unordered_map>
 #include <thread>
 #include <omp.h>
-#include <fcntl.h>
-#include <sstream>
-#include <sys/mman.h>
-#include <unistd.h>
+#include <cstring>
+#include <algorithm>
+#include <bit>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include "../../MemoryUsage.h"
-ProcessorUsingEpochTime::ProcessorUsingEpochTime() {}  // 🔹 Fixes the missing vtable issue!
+#include "../../common/SimdCsvTokenizer.h"
+#include "../../common/ParallelCsvSplitter.h"
+#include "../../common/DateParser.h"
+#include "../../common/RadixSort.h"
+#include "../../common/RangeCount.h"
+// Casualty counts stored as uint8_t columns; persons_injured keeps an int column for its
+// zone maps, value index and compression. Columns are in CSV order, so each one's field
+// number is its CrashColumn value.
+constexpr std::array<CrashColumn, 7> kCasualtyColumns = {
+    CrashColumn::PersonsKilled,   CrashColumn::PedestriansInjured, CrashColumn::PedestriansKilled,
+    CrashColumn::CyclistsInjured, CrashColumn::CyclistsKilled,     CrashColumn::MotoristsInjured,
+    CrashColumn::MotoristsKilled};
+
+// Rows from which materializeRows fills records on all threads
+constexpr size_t kParallelMaterializeRows = 1024;
+
+// Columns kept as plain numeric vectors
+constexpr CrashColumnSet kFixedColumns = {
+    CrashColumn::CrashDate,          CrashColumn::PersonsInjured,    CrashColumn::PersonsKilled,
+    CrashColumn::PedestriansInjured, CrashColumn::PedestriansKilled, CrashColumn::CyclistsInjured,
+    CrashColumn::CyclistsKilled,     CrashColumn::MotoristsInjured,  CrashColumn::MotoristsKilled,
+    CrashColumn::Latitude,           CrashColumn::Longitude,         CrashColumn::CollisionId};
+
+// A casualty count saturated into a byte; false (count 0) for an empty or non-numeric field
+static bool parseCasualtyCount(std::string_view text, uint8_t& count) {
+    int value = 0;
+    const bool parsed = NumericParser::parseInt(text, value);
+    count = uint8_t(std::clamp(value, 0, int(UINT8_MAX)));
+    return parsed;
+}
+
+// [low, high] clamped to the byte range of a casualty column; an empty range stays empty (1 > 0)
+static std::pair<uint8_t, uint8_t> clampCountRange(int64_t low, int64_t high) {
+    if (low > high || high < 0 || low > UINT8_MAX) return {1, 0};
+    return {uint8_t(std::max<int64_t>(low, 0)), uint8_t(std::min<int64_t>(high, UINT8_MAX))};
+}
+
+static void printZoneScanStats(const char* column, const ZoneScanStats& stats) {
+    std::cout << "Zone map (" << column << "): " << stats.skipped << " of " << stats.blocks << " blocks skipped, "
+              << stats.full << " matched in full, " << stats.scanned() << " scanned\n";
+}
 
+// Value of one row of a column that may have been compressed
+template <typename T>
+static T valueAt(const std::vector<T>& values, const CompressedIntColumn& packed, size_t row) {
+    return packed.empty() ? values[row] : T(packed.value(row));
+}
 
-time_t convertDateToEpoch(const std::string& date_str) {
-    std::tm tm = {};
-    std::istringstream ss(date_str);
-    ss >> std::get_time(&tm, "%m/%d/%Y");
-    if (ss.fail()) {
-        std::cerr << "Error parsing date: " << date_str << std::endl;
-        return 0;  // Handle invalid date
+// The CrashRecord field of a text column, or nullptr
+static std::string* recordText(CrashRecord& record, CrashColumn column) {
+    switch (column) {
+        case CrashColumn::CrashTime: return &record.crash_time;
+        case CrashColumn::Borough: return &record.borough;
+        case CrashColumn::ZipCode: return &record.zip_code;
+        case CrashColumn::Location: return &record.location;
+        case CrashColumn::OnStreetName: return &record.on_street_name;
+        case CrashColumn::CrossStreetName: return &record.cross_street_name;
+        case CrashColumn::OffStreetName: return &record.off_street_name;
+        case CrashColumn::ContributingFactorVehicle1: return &record.contributing_factor_vehicle_1;
+        case CrashColumn::ContributingFactorVehicle2: return &record.contributing_factor_vehicle_2;
+        case CrashColumn::ContributingFactorVehicle3: return &record.contributing_factor_vehicle_3;
+        case CrashColumn::ContributingFactorVehicle4: return &record.contributing_factor_vehicle_4;
+        case CrashColumn::ContributingFactorVehicle5: return &record.contributing_factor_vehicle_5;
+        case CrashColumn::VehicleTypeCode1: return &record.vehicle_type_code_1;
+        case CrashColumn::VehicleTypeCode2: return &record.vehicle_type_code_2;
+        case CrashColumn::VehicleTypeCode3: return &record.vehicle_type_code_3;
+        case CrashColumn::VehicleTypeCode4: return &record.vehicle_type_code_4;
+        case CrashColumn::VehicleTypeCode5: return &record.vehicle_type_code_5;
+        case CrashColumn::VehicleTypeCode6: return &record.vehicle_type_code_6;
+        default: return nullptr;
     }
-    return std::mktime(&tm);  // Convert to epoch time
 }
 
+// The CrashRecord field of a uint8_t casualty column, or nullptr
+static int* recordCount(CrashRecord& record, CrashColumn column) {
+    switch (column) {
+        case CrashColumn::PersonsKilled: return &record.persons_killed;
+        case CrashColumn::PedestriansInjured: return &record.pedestrians_injured;
+        case CrashColumn::PedestriansKilled: return &record.pedestrians_killed;
+        case CrashColumn::CyclistsInjured: return &record.cyclists_injured;
+        case CrashColumn::CyclistsKilled: return &record.cyclists_killed;
+        case CrashColumn::MotoristsInjured: return &record.motorists_injured;
+        case CrashColumn::MotoristsKilled: return &record.motorists_killed;
+        default: return nullptr;
+    }
+}
 
-void ProcessorUsingEpochTime::loadData(const std::string& filename) {
-    auto start = std::chrono::high_resolution_clock::now();
+// values, or packed decoded into decoded when the column was compressed
+template <typename T>
+static const std::vector<T>& plainValues(const std::vector<T>& values, const CompressedIntColumn& packed,
+                                         std::vector<T>& decoded) {
+    if (packed.empty()) return values;
+    packed.decode(decoded);
+    return decoded;
+}
 
-    // Open the file
-    int fd = open(filename.c_str(), O_RDONLY);
-    if (fd == -1) {
-        std::cerr << "Error opening file: " << filename << std::endl;
-        return;
+// Sizes a final column for every thread's rows. A thread-local column that already holds all
+// of them (a single chunk) is adopted as is, so there is nothing left to copy.
+template <typename Column>
+static void sizeForMerge(Column& column, std::vector<Column>& parts, size_t rows, Column empty) {
+    for (Column& part : parts) {
+        if (rows > 0 && part.size() == rows) {
+            column = std::move(part);
+            part = empty;
+            return;
+        }
+    }
+    column = std::move(empty);
+    column.resize(rows);
+}
+
+// Moves a thread's rows into its slice of a column already sized for all threads, then frees them
+template <typename T>
+static void moveIntoSlice(std::vector<T>& local, std::vector<T>& column, size_t offset) {
+    std::move(local.begin(), local.end(), column.begin() + offset);
+    std::vector<T>().swap(local);
+}
+
+ProcessorUsingEpochTime::ProcessorUsingEpochTime(bool use_simd_tokenizer)
+    : use_simd_tokenizer(use_simd_tokenizer) {}  // 🔹 Fixes the missing vtable issue!
+
+void ProcessorUsingEpochTime::setColumnProjection(const CrashColumnSet& projected_columns) {
+    columns = projected_columns;
+}
+
+void ProcessorUsingEpochTime::setZeroCopyStrings(bool enabled) {
+    zero_copy_strings = enabled;
+}
+
+void ProcessorUsingEpochTime::setSnapshotPath(const std::string& path) {
+    snapshot_path = path;
+}
+
+void ProcessorUsingEpochTime::setDateClustering(bool enabled) {
+    cluster_by_date = enabled;
+}
+
+void ProcessorUsingEpochTime::setDailyCounts(bool enabled) {
+    daily_counts_enabled = enabled;
+}
+
+void ProcessorUsingEpochTime::setHourlyCounts(bool enabled) {
+    hourly_counts_enabled = enabled;
+}
+
+void ProcessorUsingEpochTime::setValueIndexes(bool enabled) {
+    value_indexes_enabled = enabled;
+}
+
+void ProcessorUsingEpochTime::setSpatialIndex(bool enabled) {
+    spatial_index_enabled = enabled;
+}
+
+void ProcessorUsingEpochTime::setCompressedColumns(bool enabled) {
+    compressed_columns = enabled;
+}
+
+const StringColumn* ProcessorUsingEpochTime::textColumn(CrashColumn column) const {
+    switch (column) {
+        case CrashColumn::CrashTime: return &crash_time;
+        case CrashColumn::ZipCode: return &zip_code;
+        case CrashColumn::Location: return &locations;
+        case CrashColumn::OnStreetName: return &on_street_name;
+        case CrashColumn::CrossStreetName: return &cross_street_name;
+        case CrashColumn::OffStreetName: return &off_street_name;
+        default: return nullptr;
+    }
+}
+
+const DictionaryColumn* ProcessorUsingEpochTime::dictionaryColumn(CrashColumn column) const {
+    switch (column) {
+        case CrashColumn::Borough: return &borough;
+        case CrashColumn::ContributingFactorVehicle1: return &contributing_factor_vehicle_1;
+        case CrashColumn::ContributingFactorVehicle2: return &contributing_factor_vehicle_2;
+        case CrashColumn::ContributingFactorVehicle3: return &contributing_factor_vehicle_3;
+        case CrashColumn::ContributingFactorVehicle4: return &contributing_factor_vehicle_4;
+        case CrashColumn::ContributingFactorVehicle5: return &contributing_factor_vehicle_5;
+        case CrashColumn::VehicleTypeCode1: return &vehicle_type_code_1;
+        case CrashColumn::VehicleTypeCode2: return &vehicle_type_code_2;
+        case CrashColumn::VehicleTypeCode3: return &vehicle_type_code_3;
+        case CrashColumn::VehicleTypeCode4: return &vehicle_type_code_4;
+        case CrashColumn::VehicleTypeCode5: return &vehicle_type_code_5;
+        case CrashColumn::VehicleTypeCode6: return &vehicle_type_code_6;
+        default: return nullptr;
+    }
+}
+
+const std::vector<uint8_t>* ProcessorUsingEpochTime::casualtyColumn(CrashColumn column) const {
+    switch (column) {
+        case CrashColumn::PersonsKilled: return &persons_killed;
+        case CrashColumn::PedestriansInjured: return &pedestrians_injured;
+        case CrashColumn::PedestriansKilled: return &pedestrians_killed;
+        case CrashColumn::CyclistsInjured: return &cyclists_injured;
+        case CrashColumn::CyclistsKilled: return &cyclists_killed;
+        case CrashColumn::MotoristsInjured: return &motorists_injured;
+        case CrashColumn::MotoristsKilled: return &motorists_killed;
+        default: return nullptr;
+    }
+}
+
+StringColumn* ProcessorUsingEpochTime::textColumn(CrashColumn column) {
+    return const_cast<StringColumn*>(std::as_const(*this).textColumn(column));
+}
+
+DictionaryColumn* ProcessorUsingEpochTime::dictionaryColumn(CrashColumn column) {
+    return const_cast<DictionaryColumn*>(std::as_const(*this).dictionaryColumn(column));
+}
+
+std::vector<uint8_t>* ProcessorUsingEpochTime::casualtyColumn(CrashColumn column) {
+    return const_cast<std::vector<uint8_t>*>(std::as_const(*this).casualtyColumn(column));
+}
+
+std::string_view ProcessorUsingEpochTime::getText(CrashColumn column, size_t row) const {
+    if (const DictionaryColumn* dictionary = dictionaryColumn(column)) {
+        return row < dictionary->size() ? (*dictionary)[row] : std::string_view();
+    }
+    const StringColumn* text = textColumn(column);
+    if (!text || row >= text->size()) return {};
+    return (*text)[row];
+}
+
+std::string ProcessorUsingEpochTime::materializeText(CrashColumn column, size_t row) const {
+    return std::string(getText(column, row));
+}
+
+void ProcessorUsingEpochTime::printTextColumnMemory() const {
+    size_t text_bytes = 0;
+    bool zero_copy = false;
+    for (size_t column = 0; column < size_t(CrashColumn::Count); column++) {
+        if (const StringColumn* text = textColumn(CrashColumn(column))) {
+            text_bytes += text->memoryBytes();
+            zero_copy |= text->isZeroCopy();
+        }
+    }
+    std::cout << "Text columns (" << (zero_copy ? "zero-copy" : "std::string") << "): "
+              << text_bytes / (1024 * 1024) << " MB";
+    if (mapping.isOpen()) {
+        std::cout << " + " << mapping.size() / (1024 * 1024) << " MB retained file mapping";
+    }
+    std::cout << "\n";
+
+    size_t dictionary_bytes = 0;
+    size_t string_equivalent_bytes = 0;
+    for (size_t column = 0; column < size_t(CrashColumn::Count); column++) {
+        if (const DictionaryColumn* dictionary = dictionaryColumn(CrashColumn(column))) {
+            dictionary_bytes += dictionary->memoryBytes();
+            string_equivalent_bytes += dictionary->stringEquivalentBytes();
+        }
     }
+    std::cout << "Dictionary columns: " << dictionary_bytes / (1024 * 1024) << " MB (as std::string: "
+              << string_equivalent_bytes / (1024 * 1024) << " MB)\n";
+}
 
-    // Get file size
-    size_t file_size = lseek(fd, 0, SEEK_END);
-    if (file_size == -1) {
-        std::cerr << "Error getting file size" << std::endl;
-        close(fd);
+
+void ProcessorUsingEpochTime::loadData(const std::string& filename) {
+    auto start = std::chrono::high_resolution_clock::now();
+    bitmap_cache.clear();
+    size_t resident_before = MemoryUsage::getResidentSizeMB();
+    auto finishLoad = [&]() {
+        if (cluster_by_date) {
+            clusterByDate();
+        }
+        if (daily_counts_enabled) {
+            daily_counts.build(crash_dates_epoch, columns.contains(CrashColumn::Borough) ? &borough : nullptr);
+            std::cout << "Daily counts: " << daily_counts.categoryCount() << " borough series, "
+                      << daily_counts.memoryBytes() / 1024 << " KB\n";
+        }
+        if (hourly_counts_enabled) {
+            if (columns.contains(CrashColumn::CrashDate) && columns.contains(CrashColumn::CrashTime)) {
+                auto cube_start = std::chrono::high_resolution_clock::now();
+                hourly_counts.build(crash_dates_epoch, crash_minutes);
+                std::chrono::duration<double> cube_duration = std::chrono::high_resolution_clock::now() - cube_start;
+                std::cout << "Hourly counts: " << hourly_counts.memoryBytes() / 1024 << " KB, "
+                          << cube_duration.count() * 1000 << " ms\n";
+            } else {
+                hourly_counts = HourlyCounts();
+                std::cerr << "Error: hourly counts need crash_date and crash_time, not built" << std::endl;
+            }
+        }
+        if (value_indexes_enabled) {
+            auto index_start = std::chrono::high_resolution_clock::now();
+            if (!persons_injured_index.build(persons_injured)) {
+                std::cout << "persons_injured spans more than " << ValueCountIndex::kMaxDomain
+                          << " values; not indexed\n";
+            }
+            std::chrono::duration<double> index_duration = std::chrono::high_resolution_clock::now() - index_start;
+            std::cout << "Value index (persons_injured): " << persons_injured_index.memoryBytes() / 1024 << " KB, "
+                      << index_duration.count() * 1000 << " ms\n";
+        }
+        if (spatial_index_enabled) {
+            auto grid_start = std::chrono::high_resolution_clock::now();
+            location_grid.build(latitudes, longitudes);
+            std::chrono::duration<double> grid_duration = std::chrono::high_resolution_clock::now() - grid_start;
+            std::cout << "Spatial grid: " << location_grid.memoryBytes() / 1024 << " KB, " << grid_duration.count() * 1000
+                      << " ms\n";
+        }
+        if (compressed_columns) {
+            compressColumns();
+        } else {
+            crash_date_zones.build(crash_dates_epoch);
+            persons_injured_zones.build(persons_injured);
+        }
+        data_load_duration = std::chrono::high_resolution_clock::now() - start;
+        MemoryUsage::printMemoryUsage("ProcessorUsingEpochTime");
+        std::cout << "Resident size added by load (" << (columns.isAll() ? "all columns" : "projected columns") << "): "
+                  << MemoryUsage::getResidentSizeMB() - resident_before << " MB\n";
+        std::cout << "Peak resident size: " << MemoryUsage::getPeakResidentSizeMB() << " MB\n";
+        printTextColumnMemory();
+        if (compressed_columns) {
+            printCompressedColumnMemory();
+        }
+    };
+
+    // 🔹 An up-to-date snapshot replaces parsing the CSV altogether
+    SnapshotSource source;
+    bool snapshot_enabled = !snapshot_path.empty() && SnapshotSource::of(filename, source);
+    if (snapshot_enabled && loadSnapshot(source)) {
+        finishLoad();
         return;
     }
 
-    // Memory-map the file
-    char* data = static_cast<char*>(mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0));
-    if (data == MAP_FAILED) {
-        std::cerr << "Error memory-mapping file" << std::endl;
-        close(fd);
+    MappedFile file;
+    if (!file.open(filename)) {
         return;
     }
+    const char* data = file.data();
+    size_t file_size = file.size();
 
     // Estimate record count based on file size (assumption: ~100 bytes per record)
     size_t estimated_records = file_size / 100;
@@ -80,68 +372,247 @@ void ProcessorUsingEpochTime::loadData(const std::string& filename) {
 
 
     // Process file in parallel
-    processFileParallel(data, file_size);
+    if (file_size > 0) {
+        processFileParallel(data, file_size);
+    }
 
-    // Cleanup
-    munmap(data, file_size);
-    close(fd);
+    // Zero-copy columns point into the mapping, so it lives as long as the processor
+    if (zero_copy_strings) {
+        mapping = std::move(file);
+    }
 
-    auto end = std::chrono::high_resolution_clock::now();
-    data_load_duration = end - start;
-    MemoryUsage::printMemoryUsage("ProcessorUsingEpochTime");
+    finishLoad();
+
+    // Written after the load is timed, so the next run can skip parsing
+    if (snapshot_enabled) {
+        saveSnapshot(source);
+    }
+}
+
+bool ProcessorUsingEpochTime::loadSnapshot(const SnapshotSource& source) {
+    ColumnSnapshot snapshot;
+    if (!snapshot.open(snapshot_path, source)) {
+        return false;
+    }
+    for (size_t column = 0; column < size_t(CrashColumn::Count); column++) {
+        const CrashColumn crash_column = CrashColumn(column);
+        const bool stored = kFixedColumns.contains(crash_column) || textColumn(crash_column) || dictionaryColumn(crash_column);
+        if (stored && columns.contains(crash_column) && !snapshot.contains(crash_column)) {
+            std::cout << "Ignoring snapshot " << snapshot_path << ": it lacks projected columns\n";
+            return false;
+        }
+    }
+
+    auto wanted = [&](CrashColumn column) { return columns.contains(column); };
+    bool loaded = true;
+    if (wanted(CrashColumn::CrashDate)) loaded &= snapshot.readFixed(CrashColumn::CrashDate, crash_dates_epoch);
+    if (wanted(CrashColumn::PersonsInjured)) loaded &= snapshot.readFixed(CrashColumn::PersonsInjured, persons_injured);
+    if (wanted(CrashColumn::Latitude)) loaded &= snapshot.readFixed(CrashColumn::Latitude, latitudes);
+    if (wanted(CrashColumn::Longitude)) loaded &= snapshot.readFixed(CrashColumn::Longitude, longitudes);
+    if (wanted(CrashColumn::CollisionId)) loaded &= snapshot.readFixed(CrashColumn::CollisionId, collision_ids);
+    for (CrashColumn column : kCasualtyColumns) {
+        if (wanted(column)) loaded &= snapshot.readFixed(column, *casualtyColumn(column));
+    }
+    if (!loaded) {
+        std::cout << "Ignoring snapshot " << snapshot_path << ": numeric column widths differ from this build\n";
+        crash_dates_epoch.clear();
+        persons_injured.clear();
+        latitudes.clear();
+        longitudes.clear();
+        collision_ids.clear();
+        for (CrashColumn column : kCasualtyColumns) casualtyColumn(column)->clear();
+        return false;
+    }
+
+    // Text columns stay in the snapshot mapping; dictionaries and codes are copied out
+    for (size_t column = 0; column < size_t(CrashColumn::Count); column++) {
+        if (!wanted(CrashColumn(column))) continue;
+        if (StringColumn* text = textColumn(CrashColumn(column))) {
+            *text = snapshot.readText(CrashColumn(column));
+        } else if (DictionaryColumn* dictionary = dictionaryColumn(CrashColumn(column))) {
+            *dictionary = snapshot.readDictionary(CrashColumn(column));
+        }
+    }
+    // Times of day are derived from the text rather than stored
+    crash_minutes.assign(crash_time.size(), DateParser::kInvalidTime);
+    #pragma omp parallel for schedule(static)
+    for (size_t row = 0; row < crash_minutes.size(); row++) crash_minutes[row] = DateParser::parseTimeOfDay(crash_time[row]);
+    mapping = snapshot.releaseMapping();
+    std::cout << "Loaded " << snapshot.rows() << " rows from snapshot " << snapshot_path << "\n";
+    return true;
+}
+
+void ProcessorUsingEpochTime::saveSnapshot(const SnapshotSource& source) const {
+    auto start = std::chrono::high_resolution_clock::now();
+    auto wanted = [&](CrashColumn column) { return columns.contains(column); };
+
+    // Snapshots hold plain values; compressed columns are decoded into these for the writer
+    std::vector<int32_t> decoded_crash_dates;
+    std::vector<int> decoded_persons_injured;
+    std::vector<long> decoded_collision_ids;
+
+    ColumnSnapshot::Writer writer;
+    if (wanted(CrashColumn::CrashDate)) {
+        writer.addFixed(CrashColumn::CrashDate, plainValues(crash_dates_epoch, packed_crash_dates, decoded_crash_dates));
+    }
+    if (wanted(CrashColumn::PersonsInjured)) {
+        writer.addFixed(CrashColumn::PersonsInjured,
+                        plainValues(persons_injured, packed_persons_injured, decoded_persons_injured));
+    }
+    if (wanted(CrashColumn::Latitude)) writer.addFixed(CrashColumn::Latitude, latitudes);
+    if (wanted(CrashColumn::Longitude)) writer.addFixed(CrashColumn::Longitude, longitudes);
+    if (wanted(CrashColumn::CollisionId)) {
+        writer.addFixed(CrashColumn::CollisionId, plainValues(collision_ids, packed_collision_ids, decoded_collision_ids));
+    }
+    for (CrashColumn column : kCasualtyColumns) {
+        if (wanted(column)) writer.addFixed(column, *casualtyColumn(column));
+    }
+    for (size_t column = 0; column < size_t(CrashColumn::Count); column++) {
+        if (!wanted(CrashColumn(column))) continue;
+        if (const StringColumn* text = textColumn(CrashColumn(column))) {
+            writer.addText(CrashColumn(column), *text);
+        } else if (const DictionaryColumn* dictionary = dictionaryColumn(CrashColumn(column))) {
+            writer.addDictionary(CrashColumn(column), *dictionary);
+        }
+    }
+
+    if (writer.write(snapshot_path, source)) {
+        std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+        SnapshotSource written;
+        SnapshotSource::of(snapshot_path, written);
+        std::cout << "Snapshot written to " << snapshot_path << ": " << written.size / (1024 * 1024) << " MB in "
+                  << duration.count() * 1000 << " ms\n";
+    }
+}
+
+void ProcessorUsingEpochTime::clusterByDate() {
+    if (!columns.contains(CrashColumn::CrashDate)) {
+        std::cerr << "Error: crash_date was not loaded (outside the column projection), rows keep file order" << std::endl;
+        cluster_by_date = false;
+        return;
+    }
+    // A snapshot written by a clustered load is already in order
+    if (std::is_sorted(crash_dates_epoch.begin(), crash_dates_epoch.end())) {
+        return;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    const RowOrder order = RadixSort::sortedOrder(crash_dates_epoch);
+    applyRowOrder(crash_dates_epoch, order);
+    applyRowOrder(persons_injured, order);
+    applyRowOrder(latitudes, order);
+    applyRowOrder(longitudes, order);
+    applyRowOrder(collision_ids, order);
+    applyRowOrder(crash_minutes, order);
+    for (CrashColumn column : kCasualtyColumns) applyRowOrder(*casualtyColumn(column), order);
+    for (size_t column = 0; column < size_t(CrashColumn::Count); column++) {
+        if (StringColumn* text = textColumn(CrashColumn(column))) {
+            text->permute(order);
+        } else if (DictionaryColumn* dictionary = dictionaryColumn(CrashColumn(column))) {
+            dictionary->permute(order);
+        }
+    }
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+    std::cout << "Rows clustered by crash date: " << duration.count() * 1000 << " ms\n";
 }
 
-void ProcessorUsingEpochTime::processFileParallel(char* data, size_t file_size) {
+void ProcessorUsingEpochTime::compressColumns() {
+    // The plain vectors are released, not just cleared, so the memory actually goes away
+    auto compress = [](auto& values, CompressedIntColumn& packed) {
+        packed = CompressedIntColumn::encode(values);
+        std::remove_reference_t<decltype(values)>().swap(values);
+    };
+    compress(crash_dates_epoch, packed_crash_dates);
+    compress(persons_injured, packed_persons_injured);
+    compress(collision_ids, packed_collision_ids);
+}
+
+void ProcessorUsingEpochTime::printCompressedColumnMemory() const {
+    auto print = [](const char* name, const CompressedIntColumn& packed, size_t plain_value_bytes) {
+        using Codec = CompressedIntColumn::Codec;
+        std::cout << "Compressed " << name << ": " << packed.memoryBytes() / 1024 << " KB (plain: "
+                  << packed.size() * plain_value_bytes / 1024 << " KB); " << packed.blockCount() << " blocks: "
+                  << packed.blockCount(Codec::FrameOfReference) << " frame-of-reference, "
+                  << packed.blockCount(Codec::Delta) << " delta, " << packed.blockCount(Codec::Constant)
+                  << " constant\n";
+    };
+    print("crash_date", packed_crash_dates, sizeof(int32_t));
+    print("persons_injured", packed_persons_injured, sizeof(int));
+    print("collision_id", packed_collision_ids, sizeof(long));
+}
+
+void ProcessorUsingEpochTime::processFileParallel(const char* data, size_t file_size) {
     int num_threads = std::thread::hardware_concurrency();
     std::cout << "Using " << num_threads << " threads for parallel processing.\n";
+    std::cout << "Tokenizer: " << (use_simd_tokenizer ? SimdCsvTokenizer::isaName() : "scalar byte loop")
+              << ", date parser: " << DateParser::batchIsaName() << "\n";
+    if (!columns.isAll()) {
+        std::cout << "Projection: loading " << columns.size() << " of " << size_t(CrashColumn::Count) << " columns\n";
+    }
+
+    // Zero-copy text columns reference the mapping instead of copying every field;
+    // low-cardinality columns are dictionary-encoded through thread-local builders
+    const char* string_base = zero_copy_strings ? data : nullptr;
 
-    std::vector<std::vector<time_t>> crash_dates_epoch_local(num_threads);  // 🔹 Change to store epoch
     std::vector<std::vector<int>> persons_injured_local(num_threads);
     std::vector<std::vector<float>> latitudes_local(num_threads);
     std::vector<std::vector<float>> longitudes_local(num_threads);
-    std::vector<std::vector<std::string>> crash_time_local(num_threads);
-    std::vector<std::vector<std::string>> borough_local(num_threads);
-    std::vector<std::vector<std::string>> zip_code_local(num_threads);
-    std::vector<std::vector<std::string>> locations_local(num_threads);
-    std::vector<std::vector<std::string>> on_street_name_local(num_threads);
-    std::vector<std::vector<std::string>> cross_street_name_local(num_threads);
-    std::vector<std::vector<std::string>> off_street_name_local(num_threads);
-    std::vector<std::vector<std::string>> contributing_factor_vehicle_1_local(num_threads);
-    std::vector<std::vector<std::string>> contributing_factor_vehicle_2_local(num_threads);
-    std::vector<std::vector<std::string>> contributing_factor_vehicle_3_local(num_threads);
-    std::vector<std::vector<std::string>> contributing_factor_vehicle_4_local(num_threads);
-    std::vector<std::vector<std::string>> contributing_factor_vehicle_5_local(num_threads);
+    std::vector<StringColumn> crash_time_local(num_threads, StringColumn(string_base));
+    std::vector<std::vector<uint16_t>> crash_minutes_local(num_threads);
+    std::vector<DictionaryColumn::Builder> borough_local(num_threads);
+    std::vector<StringColumn> zip_code_local(num_threads, StringColumn(string_base));
+    std::vector<StringColumn> locations_local(num_threads, StringColumn(string_base));
+    std::vector<StringColumn> on_street_name_local(num_threads, StringColumn(string_base));
+    std::vector<StringColumn> cross_street_name_local(num_threads, StringColumn(string_base));
+    std::vector<StringColumn> off_street_name_local(num_threads, StringColumn(string_base));
+    std::vector<DictionaryColumn::Builder> contributing_factor_vehicle_1_local(num_threads);
+    std::vector<DictionaryColumn::Builder> contributing_factor_vehicle_2_local(num_threads);
+    std::vector<DictionaryColumn::Builder> contributing_factor_vehicle_3_local(num_threads);
+    std::vector<DictionaryColumn::Builder> contributing_factor_vehicle_4_local(num_threads);
+    std::vector<DictionaryColumn::Builder> contributing_factor_vehicle_5_local(num_threads);
     std::vector<std::vector<long>> collision_ids_local(num_threads);
-    std::vector<std::vector<std::string>> vehicle_type_code_1_local(num_threads);
-    std::vector<std::vector<std::string>> vehicle_type_code_2_local(num_threads);
-    std::vector<std::vector<std::string>> vehicle_type_code_3_local(num_threads);
-    std::vector<std::vector<std::string>> vehicle_type_code_4_local(num_threads);
-    std::vector<std::vector<std::string>> vehicle_type_code_5_local(num_threads);
-    std::vector<std::vector<std::string>> vehicle_type_code_6_local(num_threads);
+    std::array<std::vector<std::vector<uint8_t>>, kCasualtyColumns.size()> casualty_counts_local;
+    casualty_counts_local.fill(std::vector<std::vector<uint8_t>>(num_threads));
+    std::vector<DictionaryColumn::Builder> vehicle_type_code_1_local(num_threads);
+    std::vector<DictionaryColumn::Builder> vehicle_type_code_2_local(num_threads);
+    std::vector<DictionaryColumn::Builder> vehicle_type_code_3_local(num_threads);
+    std::vector<DictionaryColumn::Builder> vehicle_type_code_4_local(num_threads);
+    std::vector<DictionaryColumn::Builder> vehicle_type_code_5_local(num_threads);
+    std::vector<DictionaryColumn::Builder> vehicle_type_code_6_local(num_threads);
+    std::vector<size_t> invalid_numeric_fields_local(num_threads, 0);  // empty or unparsable, stored as 0
+    std::vector<size_t> row_offsets(num_threads + 1, 0);  // per-thread row counts, then their exclusive scan
+    std::chrono::high_resolution_clock::time_point merge_start;
+
+    const char* file_end = data + file_size;
+    // Skip the header row, then hand every thread a row-aligned chunk
+    const char* header_end = static_cast<const char*>(memchr(data, '\n', file_size));
+    const char* rows_begin = header_end ? header_end + 1 : file_end;
+
+    auto split_start = std::chrono::high_resolution_clock::now();
+    std::vector<const char*> chunk_bounds = use_simd_tokenizer
+        ? ParallelCsvSplitter::split(rows_begin, file_end, num_threads)
+        : ParallelCsvSplitter::splitNaive(rows_begin, file_end, num_threads);
+    std::chrono::duration<double> split_duration = std::chrono::high_resolution_clock::now() - split_start;
+    std::cout << "Chunk split (" << (use_simd_tokenizer ? "quote-aware" : "naive") << "): "
+              << split_duration.count() * 1000 << " ms, "
+              << (file_size / (1024.0 * 1024.0)) / split_duration.count() << " MB/s\n";
 
-    size_t chunk_size = file_size / num_threads;
+    // Rows are only split as far as the last projected field
+    const size_t field_limit = columns.fieldLimit();
 
     #pragma omp parallel num_threads(num_threads)
     {
         int thread_id = omp_get_thread_num();
-        char* start_pos = data + (thread_id * chunk_size);
-        char* end_pos = (thread_id == num_threads - 1) ? data + file_size : start_pos + chunk_size;
-
-        if (thread_id != 0) {
-            while (*start_pos != '\n' && start_pos < end_pos) {
-                start_pos++;
-            }
-            if (start_pos < end_pos) {
-                start_pos++;
-            }
-        }
+        const char* start_pos = chunk_bounds[thread_id];
+        const char* chunk_end = chunk_bounds[thread_id + 1];
 
-        char* line_start = start_pos;
-        auto& local_crash_dates_epoch = crash_dates_epoch_local[thread_id];
+        size_t local_row_count = 0;
+        std::vector<std::string_view> local_crash_date_text;  // converted in one batch, straight into crash_dates_epoch
         auto& local_persons_injured = persons_injured_local[thread_id];
         auto& local_latitudes = latitudes_local[thread_id];
         auto& local_longitudes = longitudes_local[thread_id];
         auto& local_crash_time = crash_time_local[thread_id];
+        auto& local_crash_minutes = crash_minutes_local[thread_id];
         auto& local_borough = borough_local[thread_id];
         auto& local_zip_code = zip_code_local[thread_id];
         auto& local_locations = locations_local[thread_id];
@@ -154,161 +625,194 @@ void ProcessorUsingEpochTime::processFileParallel(char* data, size_t file_size)
         auto& local_contributing_factor_vehicle_4 = contributing_factor_vehicle_4_local[thread_id];
         auto& local_contributing_factor_vehicle_5 = contributing_factor_vehicle_5_local[thread_id];
         auto& local_collision_ids = collision_ids_local[thread_id];
+        std::array<std::vector<uint8_t>*, kCasualtyColumns.size()> local_casualty_counts;
+        for (size_t c = 0; c < kCasualtyColumns.size(); c++) local_casualty_counts[c] = &casualty_counts_local[c][thread_id];
         auto& local_vehicle_type_code_1 = vehicle_type_code_1_local[thread_id];
         auto& local_vehicle_type_code_2 = vehicle_type_code_2_local[thread_id];
         auto& local_vehicle_type_code_3 = vehicle_type_code_3_local[thread_id];
         auto& local_vehicle_type_code_4 = vehicle_type_code_4_local[thread_id];
         auto& local_vehicle_type_code_5 = vehicle_type_code_5_local[thread_id];
         auto& local_vehicle_type_code_6 = vehicle_type_code_6_local[thread_id];
+        size_t local_invalid_numeric_fields = 0;  // published once at the end, not per field (false sharing)
 
+        // Fields are indexed by column, so both tokenizers share the same row materialization.
+        // Columns outside the projection are neither parsed nor stored.
+        auto appendRow = [&](const SimdCsvTokenizer::Fields& fields, size_t field_count) {
+            // Fields are addressed by column, the numbering columns.fieldLimit() stops splitting at
+            auto field = [&](CrashColumn column) {
+                const size_t col = static_cast<size_t>(column);
+                return col < field_count ? fields[col] : std::string_view();
+            };
+            auto wanted = [&](CrashColumn column) { return columns.contains(column); };
+            auto copyText = [&](CrashColumn column, auto& target) {
+                if (wanted(column)) target.push_back(field(column));
+            };
+            local_row_count++;
 
-
-        while (line_start < end_pos) {
-            char* line_end = line_start;
-            while (line_end < end_pos && *line_end != '\n') {
-                line_end++;
+            if (wanted(CrashColumn::CrashDate)) {
+                local_crash_date_text.push_back(field(CrashColumn::CrashDate));
+            }
+            if (wanted(CrashColumn::Latitude)) {
+                float lat = 0.0f;
+                if (!NumericParser::parseFloat(field(CrashColumn::Latitude), lat)) local_invalid_numeric_fields++;
+                local_latitudes.push_back(lat);
+            }
+            if (wanted(CrashColumn::Longitude)) {
+                float lon = 0.0f;
+                if (!NumericParser::parseFloat(field(CrashColumn::Longitude), lon)) local_invalid_numeric_fields++;
+                local_longitudes.push_back(lon);
             }
-            if (line_end >= end_pos) break;
-
-            std::string_view line(line_start, line_end - line_start);
-            line_start = line_end + 1;
-
-            size_t col_index = 0;
-            size_t pos = 0;
-            std::string_view token;
-
-            float lat = 0.0f, lon = 0.0f;
-            int injured = 0;
-            std::string crash_date;
-            std::string crash_time;
-            std::string borough;
-            std:: string zip_code;
-            std::string locations;
-            std::string on_street_name;
-            std::string cross_street_name;
-            std::string off_street_name;
-            int number_of_persons_injured = 0;
-            int number_of_persons_killed = 0;
-            int number_of_pedestrians_injured = 0;
-            int number_of_pedestrians_killed = 0;
-            int number_of_cyclists_injured = 0;
-            int number_of_cyclists_killed = 0;
-            int number_of_motorists_injured = 0;
-            int number_of_motorists_killed = 0;
-            std::string contributing_factor_vehicle_1;
-            std::string contributing_factor_vehicle_2;
-            std::string contributing_factor_vehicle_3;
-            std::string contributing_factor_vehicle_4;
-            std::string contributing_factor_vehicle_5;
-            std::string vehicle_type_code_1;
-            std::string vehicle_type_code_2;
-            std::string vehicle_type_code_3;
-            std:: string vehicle_type_code_4;
-            std::string vehicle_type_code_5;
-            std::string vehicle_type_code_6;
-            long collision_id = 0;
-
-
-
-
-            while (pos < line.size()) {
-                size_t next_pos = line.find(',', pos);
-                if (next_pos == std::string::npos) next_pos = line.size();
-                token = line.substr(pos, next_pos - pos);
-                pos = next_pos + 1;
-
-                switch (col_index) {
-                    case 0: crash_date = std::string(token); break;
-                    case 1: crash_time = std::string(token); break;
-                    case 2: borough = std::string(token); break;
-                    case 3: zip_code = std::string(token); break;
-                    case 4: try { lat = std::stof(std::string(token)); } catch (...) { lat = 0.0f; } break;
-                    case 5: try { lon = std::stof(std::string(token)); } catch (...) { lon = 0.0f; } break;
-                    case 6: locations = std::string(token); break;
-                    case 7: on_street_name = std::string(token); break;
-                    case 8: cross_street_name = std::string(token); break;
-                    case 9: off_street_name = std::string(token); break;
-                    case 10: try {
-                        number_of_persons_injured = std::stoi(std::string(token));
-                    } catch (...) {
-                        number_of_persons_injured = 0;
-                    } break;
-                    case 11: try { number_of_persons_killed = std::stoi(std::string(token)); } catch (...) { number_of_persons_killed = 0; } break;
-                    case 12: try { number_of_pedestrians_injured = std::stoi(std::string(token)); } catch (...) { number_of_pedestrians_injured = 0; } break;
-                    case 13: try { number_of_pedestrians_killed = std::stoi(std::string(token)); } catch (...) { number_of_pedestrians_killed = 0; } break;
-                    case 14: try { number_of_cyclists_injured = std::stoi(std::string(token)); } catch (...) { number_of_cyclists_injured = 0; } break;
-                    case 15: try { number_of_cyclists_killed = std::stoi(std::string(token)); } catch (...) { number_of_cyclists_killed = 0; } break;
-                    case 16: try { number_of_motorists_injured = std::stoi(std::string(token)); } catch (...) { number_of_motorists_injured = 0; } break;
-                    case 17: try { number_of_motorists_killed = std::stoi(std::string(token)); } catch (...) { number_of_motorists_killed = 0; } break;
-                    case 18: contributing_factor_vehicle_1 = std::string(token); break;
-                    case 19: contributing_factor_vehicle_2 = std::string(token); break;
-                    case 20: contributing_factor_vehicle_3 = std::string(token); break;
-                    case 21: contributing_factor_vehicle_4 = std::string(token); break;
-                    case 22: contributing_factor_vehicle_5 = std::string(token); break;
-                    case 23: try { collision_id = std::stol(std::string(token)); } catch (...) { collision_id = 0; } break;
-                    case 24: vehicle_type_code_1 = std::string(token); break;
-                    case 25: vehicle_type_code_2 = std::string(token); break;
-                    case 26: vehicle_type_code_3 = std::string(token); break;
-                    case 27: vehicle_type_code_4 = std::string(token); break;
-                    case 28: vehicle_type_code_5 = std::string(token); break;
-                    case 29: vehicle_type_code_6 = std::string(token); break;
-                    case 30: try { injured = std::stoi(std::string(token)); } catch (...) { injured = 0; } break;
+            if (wanted(CrashColumn::PersonsInjured)) {
+                int injured = 0;
+                if (!NumericParser::parseInt(field(CrashColumn::PersonsInjured), injured)) {
+                    local_invalid_numeric_fields++;
                 }
+                local_persons_injured.push_back(injured);
+            }
+            for (size_t c = 0; c < kCasualtyColumns.size(); c++) {
+                if (!wanted(kCasualtyColumns[c])) continue;
+                uint8_t count = 0;
+                if (!parseCasualtyCount(field(kCasualtyColumns[c]), count)) local_invalid_numeric_fields++;
+                local_casualty_counts[c]->push_back(count);
+            }
+            if (wanted(CrashColumn::CrashTime)) {
+                local_crash_time.push_back(field(CrashColumn::CrashTime));
+                local_crash_minutes.push_back(DateParser::parseTimeOfDay(field(CrashColumn::CrashTime)));
+            }
+            copyText(CrashColumn::Borough, local_borough);
+            copyText(CrashColumn::ZipCode, local_zip_code);
+            copyText(CrashColumn::Location, local_locations);
+            copyText(CrashColumn::OnStreetName, local_on_street_name);
+            copyText(CrashColumn::CrossStreetName, local_cross_street_name);
+            copyText(CrashColumn::OffStreetName, local_off_street_name);
+            copyText(CrashColumn::ContributingFactorVehicle1, local_contributing_factor_vehicle_1);
+            copyText(CrashColumn::ContributingFactorVehicle2, local_contributing_factor_vehicle_2);
+            copyText(CrashColumn::ContributingFactorVehicle3, local_contributing_factor_vehicle_3);
+            copyText(CrashColumn::ContributingFactorVehicle4, local_contributing_factor_vehicle_4);
+            copyText(CrashColumn::ContributingFactorVehicle5, local_contributing_factor_vehicle_5);
+            if (wanted(CrashColumn::CollisionId)) {
+                long collision_id = 0;
+                if (!NumericParser::parseInt(field(CrashColumn::CollisionId), collision_id)) {
+                    local_invalid_numeric_fields++;
+                }
+                local_collision_ids.push_back(collision_id);
+            }
+            copyText(CrashColumn::VehicleTypeCode1, local_vehicle_type_code_1);
+            copyText(CrashColumn::VehicleTypeCode2, local_vehicle_type_code_2);
+            copyText(CrashColumn::VehicleTypeCode3, local_vehicle_type_code_3);
+            copyText(CrashColumn::VehicleTypeCode4, local_vehicle_type_code_4);
+            copyText(CrashColumn::VehicleTypeCode5, local_vehicle_type_code_5);
+            copyText(CrashColumn::VehicleTypeCode6, local_vehicle_type_code_6);
+        };
 
-                col_index++;
-                if (col_index > 30) break;
+        SimdCsvTokenizer::Fields fields;
+        if (use_simd_tokenizer) {
+            SimdCsvTokenizer tokenizer(start_pos, chunk_end);
+            while (size_t field_count = tokenizer.nextRow(fields, field_limit)) {
+                if (field_count > 1 || !fields[0].empty()) appendRow(fields, field_count);
             }
+        } else {
+            // Scalar baseline: one byte at a time, with the same quote handling and field rules
+            // as the SIMD tokenizer, so both load the same columns
+            const char* row_start = start_pos;
+            while (row_start < chunk_end) {
+                size_t field_count = 0;
+                bool in_quotes = false;
+                const char* field_start = row_start;
+                const char* pos = row_start;
+                for (; pos < chunk_end; pos++) {
+                    if (*pos == '"') {
+                        in_quotes = !in_quotes;
+                    } else if (!in_quotes && (*pos == ',' || *pos == '\n')) {
+                        if (field_count < field_limit) {
+                            fields[field_count++] = SimdCsvTokenizer::fieldView(field_start, pos);
+                        }
+                        field_start = pos + 1;
+                        if (*pos == '\n') break;
+                    }
+                }
+                if (pos == chunk_end && field_count < field_limit) {
+                    // Last row of the chunk has no trailing newline
+                    fields[field_count++] = SimdCsvTokenizer::fieldView(field_start, chunk_end);
+                }
+                row_start = pos + 1;
+                if (field_count > 1 || !fields[0].empty()) appendRow(fields, field_count);
+            }
+        }
+
+        invalid_numeric_fields_local[thread_id] = local_invalid_numeric_fields;
+        row_offsets[thread_id + 1] = local_row_count;
 
-            local_crash_dates_epoch.push_back(convertDateToEpoch(crash_date));  // 🔹 Convert once and store
-            local_latitudes.push_back(lat);
-            local_longitudes.push_back(lon);
-            local_persons_injured.push_back(injured);
-            local_crash_time.push_back(std::string(crash_time));
-            local_borough.push_back(std::string(borough));
-            local_zip_code.push_back(std::string(zip_code));
-            local_locations.push_back(std::string(locations));
-            local_on_street_name.push_back(std::string(on_street_name));
-            local_cross_street_name.push_back(std::string(cross_street_name));
-            local_off_street_name.push_back(std::string(off_street_name));
-            local_contributing_factor_vehicle_1.push_back(std::string(contributing_factor_vehicle_1));
-            local_contributing_factor_vehicle_2.push_back(std::string(contributing_factor_vehicle_2));
-            local_contributing_factor_vehicle_3.push_back(std::string(contributing_factor_vehicle_3));
-            local_contributing_factor_vehicle_4.push_back(std::string(contributing_factor_vehicle_4));
-            local_contributing_factor_vehicle_5.push_back(std::string(contributing_factor_vehicle_5));
-            local_collision_ids.push_back(collision_id);
-            local_vehicle_type_code_1.push_back(std::string(vehicle_type_code_1));
-            local_vehicle_type_code_2.push_back(std::string(vehicle_type_code_2));
-            local_vehicle_type_code_3.push_back(std::string(vehicle_type_code_3));
-            local_vehicle_type_code_4.push_back(std::string(vehicle_type_code_4));
-            local_vehicle_type_code_5.push_back(std::string(vehicle_type_code_5));
-            local_vehicle_type_code_6.push_back(std::string(vehicle_type_code_6));
+        // 🔹 Merge: size every final column once from the exclusive scan of the per-thread row
+        // counts, then each thread moves its rows into its own slice and frees its local copy
+        #pragma omp barrier
+        #pragma omp single
+        {
+            merge_start = std::chrono::high_resolution_clock::now();
+            for (int t = 0; t < num_threads; t++) row_offsets[t + 1] += row_offsets[t];
+            const size_t total_rows = row_offsets[num_threads];
+            auto rows = [&](CrashColumn column) { return columns.contains(column) ? total_rows : 0; };
 
+            crash_dates_epoch.assign(rows(CrashColumn::CrashDate), 0);
+            sizeForMerge(persons_injured, persons_injured_local, rows(CrashColumn::PersonsInjured), {});
+            sizeForMerge(latitudes, latitudes_local, rows(CrashColumn::Latitude), {});
+            sizeForMerge(longitudes, longitudes_local, rows(CrashColumn::Longitude), {});
+            sizeForMerge(collision_ids, collision_ids_local, rows(CrashColumn::CollisionId), {});
+            sizeForMerge(crash_minutes, crash_minutes_local, rows(CrashColumn::CrashTime), {});
+            for (size_t c = 0; c < kCasualtyColumns.size(); c++) {
+                sizeForMerge(*casualtyColumn(kCasualtyColumns[c]), casualty_counts_local[c], rows(kCasualtyColumns[c]), {});
+            }
+            const StringColumn empty_text(string_base);
+            sizeForMerge(crash_time, crash_time_local, rows(CrashColumn::CrashTime), empty_text);
+            sizeForMerge(zip_code, zip_code_local, rows(CrashColumn::ZipCode), empty_text);
+            sizeForMerge(locations, locations_local, rows(CrashColumn::Location), empty_text);
+            sizeForMerge(on_street_name, on_street_name_local, rows(CrashColumn::OnStreetName), empty_text);
+            sizeForMerge(cross_street_name, cross_street_name_local, rows(CrashColumn::CrossStreetName), empty_text);
+            sizeForMerge(off_street_name, off_street_name_local, rows(CrashColumn::OffStreetName), empty_text);
+        }
+
+        const size_t offset = row_offsets[thread_id];
+        // 🔹 Dates are converted once, directly into the final column
+        DateParser::parseDates(local_crash_date_text.data(), local_crash_date_text.size(), crash_dates_epoch.data() + offset);
+        std::vector<std::string_view>().swap(local_crash_date_text);
+        moveIntoSlice(local_persons_injured, persons_injured, offset);
+        moveIntoSlice(local_latitudes, latitudes, offset);
+        moveIntoSlice(local_longitudes, longitudes, offset);
+        moveIntoSlice(local_collision_ids, collision_ids, offset);
+        moveIntoSlice(local_crash_minutes, crash_minutes, offset);
+        for (size_t c = 0; c < kCasualtyColumns.size(); c++) {
+            moveIntoSlice(*local_casualty_counts[c], *casualtyColumn(kCasualtyColumns[c]), offset);
         }
+        crash_time.moveSlice(local_crash_time, offset);
+        zip_code.moveSlice(local_zip_code, offset);
+        locations.moveSlice(local_locations, offset);
+        on_street_name.moveSlice(local_on_street_name, offset);
+        cross_street_name.moveSlice(local_cross_street_name, offset);
+        off_street_name.moveSlice(local_off_street_name, offset);
     }
 
+    size_t invalid_numeric_fields = 0;
     for (int i = 0; i < num_threads; i++) {
-        crash_dates_epoch.insert(crash_dates_epoch.end(), crash_dates_epoch_local[i].begin(), crash_dates_epoch_local[i].end());
-        persons_injured.insert(persons_injured.end(), persons_injured_local[i].begin(), persons_injured_local[i].end());
-        latitudes.insert(latitudes.end(), latitudes_local[i].begin(), latitudes_local[i].end());
-        longitudes.insert(longitudes.end(), longitudes_local[i].begin(), longitudes_local[i].end());
-        crash_time.insert(crash_time.end(), crash_time_local[i].begin(), crash_time_local[i].end());
-        borough.insert(borough.end(), borough_local[i].begin(), borough_local[i].end());
-        zip_code.insert(zip_code.end(), zip_code_local[i].begin(), zip_code_local[i].end());
-        locations.insert(locations.end(), locations_local[i].begin(), locations_local[i].end());
-        on_street_name.insert(on_street_name.end(), on_street_name_local[i].begin(), on_street_name_local[i].end());
-        cross_street_name.insert(cross_street_name.end(), cross_street_name_local[i].begin(), cross_street_name_local[i].end());
-        off_street_name.insert(off_street_name.end(), off_street_name_local[i].begin(), off_street_name_local[i].end());
-        contributing_factor_vehicle_1.insert(contributing_factor_vehicle_1.end(), contributing_factor_vehicle_1_local[i].begin(), contributing_factor_vehicle_1_local[i].end());
-        contributing_factor_vehicle_2.insert(contributing_factor_vehicle_2.end(), contributing_factor_vehicle_2_local[i].begin(), contributing_factor_vehicle_2_local[i].end());
-        contributing_factor_vehicle_3.insert(contributing_factor_vehicle_3.end(), contributing_factor_vehicle_3_local[i].begin(), contributing_factor_vehicle_3_local[i].end());
-        contributing_factor_vehicle_4.insert(contributing_factor_vehicle_4.end(), contributing_factor_vehicle_4_local[i].begin(), contributing_factor_vehicle_4_local[i].end());
-        contributing_factor_vehicle_5.insert(contributing_factor_vehicle_5.end(), contributing_factor_vehicle_5_local[i].begin(), contributing_factor_vehicle_5_local[i].end());
-        collision_ids.insert(collision_ids.end(), collision_ids_local[i].begin(), collision_ids_local[i].end());
-        vehicle_type_code_1.insert(vehicle_type_code_1.end(), vehicle_type_code_1_local[i].begin(), vehicle_type_code_1_local[i].end());
-        vehicle_type_code_2.insert(vehicle_type_code_2.end(), vehicle_type_code_2_local[i].begin(), vehicle_type_code_2_local[i].end());
-        vehicle_type_code_3.insert(vehicle_type_code_3.end(), vehicle_type_code_3_local[i].begin(), vehicle_type_code_3_local[i].end());
-        vehicle_type_code_4.insert(vehicle_type_code_4.end(), vehicle_type_code_4_local[i].begin(), vehicle_type_code_4_local[i].end());
+        invalid_numeric_fields += invalid_numeric_fields_local[i];
     }
+    std::cout << "Empty or invalid numeric fields (stored as 0): " << invalid_numeric_fields << "\n";
+
+    // Dictionary columns merge their thread-local dictionaries and remap codes in parallel
+    borough = DictionaryColumn::merge(borough_local);
+    contributing_factor_vehicle_1 = DictionaryColumn::merge(contributing_factor_vehicle_1_local);
+    contributing_factor_vehicle_2 = DictionaryColumn::merge(contributing_factor_vehicle_2_local);
+    contributing_factor_vehicle_3 = DictionaryColumn::merge(contributing_factor_vehicle_3_local);
+    contributing_factor_vehicle_4 = DictionaryColumn::merge(contributing_factor_vehicle_4_local);
+    contributing_factor_vehicle_5 = DictionaryColumn::merge(contributing_factor_vehicle_5_local);
+    vehicle_type_code_1 = DictionaryColumn::merge(vehicle_type_code_1_local);
+    vehicle_type_code_2 = DictionaryColumn::merge(vehicle_type_code_2_local);
+    vehicle_type_code_3 = DictionaryColumn::merge(vehicle_type_code_3_local);
+    vehicle_type_code_4 = DictionaryColumn::merge(vehicle_type_code_4_local);
+    vehicle_type_code_5 = DictionaryColumn::merge(vehicle_type_code_5_local);
+    vehicle_type_code_6 = DictionaryColumn::merge(vehicle_type_code_6_local);
+
+    std::chrono::duration<double> merge_duration = std::chrono::high_resolution_clock::now() - merge_start;
+    std::cout << "Column merge: " << merge_duration.count() * 1000 << " ms\n";
 }
 
 
@@ -319,19 +823,34 @@ int ProcessorUsingEpochTime::getCrashesInDateRange(const std::string& start_date
     auto start = std::chrono::high_resolution_clock::now();
     int crash_count = 0;
 
-    time_t start_time = convertDateToEpoch(start_date);
-    time_t end_time = convertDateToEpoch(end_date);
+    if (!columns.contains(CrashColumn::CrashDate)) {
+        std::cerr << "Error: crash_date was not loaded (outside the column projection)" << std::endl;
+        return 0;
+    }
+
+    int32_t start_time = DateParser::parseDate(start_date);
+    int32_t end_time = DateParser::parseDate(end_date);
 
-    if (start_time == 0 || end_time == 0) {
+    if (start_time == DateParser::kInvalidDate || end_time == DateParser::kInvalidDate) {
         std::cerr << "Error: Invalid date format (Expected MM/DD/YYYY)" << std::endl;
         return 0;
     }
 
-    #pragma omp parallel for reduction(+:crash_count)
-    for (size_t i = 0; i < crash_dates_epoch.size(); i++) {
-        if (crash_dates_epoch[i] >= start_time && crash_dates_epoch[i] <= end_time) {
-            crash_count++;
-        }
+    // Blocks whose min/max lie outside (or entirely inside) the range are never read
+    ZoneScanStats zone_stats;
+    if (daily_counts_enabled) {
+        crash_count = int(daily_counts.count(start_time, end_time));
+    } else if (compressed_columns) {
+        crash_count = int(packed_crash_dates.countInRange(start_time, end_time, zone_stats));
+        printZoneScanStats("crash_date", zone_stats);
+    } else if (cluster_by_date) {
+        // Rows are in date order: the range is the run between two binary searches
+        auto first = std::lower_bound(crash_dates_epoch.begin(), crash_dates_epoch.end(), start_time);
+        auto last = std::upper_bound(first, crash_dates_epoch.end(), end_time);
+        crash_count = int(last - first);
+    } else {
+        crash_count = int(crash_date_zones.countInRange(crash_dates_epoch, start_time, end_time, zone_stats));
+        printZoneScanStats("crash_date", zone_stats);
     }
 
     auto end = std::chrono::high_resolution_clock::now();
@@ -340,15 +859,46 @@ int ProcessorUsingEpochTime::getCrashesInDateRange(const std::string& start_date
 }
 
 
+std::vector<std::pair<std::string, int>> ProcessorUsingEpochTime::getCrashesInDateRangeByBorough(
+    const std::string& start_date, const std::string& end_date) const {
+    std::vector<std::pair<std::string, int>> counts;
+    if (!daily_counts_enabled || daily_counts.categoryCount() == 0) {
+        std::cerr << "Error: per-borough counts need daily counts and the borough column" << std::endl;
+        return counts;
+    }
+
+    int32_t start_time = DateParser::parseDate(start_date);
+    int32_t end_time = DateParser::parseDate(end_date);
+    if (start_time == DateParser::kInvalidDate || end_time == DateParser::kInvalidDate) {
+        std::cerr << "Error: Invalid date format (Expected MM/DD/YYYY)" << std::endl;
+        return counts;
+    }
+
+    const std::vector<std::string>& names = borough.dictionary();
+    for (uint32_t code = 0; code < names.size(); code++) {
+        counts.emplace_back(names[code], int(daily_counts.count(start_time, end_time, code)));
+    }
+    return counts;
+}
+
 int ProcessorUsingEpochTime::getCrashesByInjuryCountRange(int min_injuries, int max_injuries) {
     auto start = std::chrono::high_resolution_clock::now();
     int crash_count = 0;
 
-    #pragma omp parallel for reduction(+:crash_count)
-    for (size_t i = 0; i < persons_injured.size(); i++) {
-        if (persons_injured[i] >= min_injuries && persons_injured[i] <= max_injuries) {
-            crash_count++;
-        }
+    if (!columns.contains(CrashColumn::PersonsInjured)) {
+        std::cerr << "Error: persons_injured was not loaded (outside the column projection)" << std::endl;
+        return 0;
+    }
+
+    ZoneScanStats zone_stats;
+    if (!persons_injured_index.empty()) {
+        crash_count = int(persons_injured_index.count(min_injuries, max_injuries));
+    } else if (compressed_columns) {
+        crash_count = int(packed_persons_injured.countInRange(min_injuries, max_injuries, zone_stats));
+        printZoneScanStats("persons_injured", zone_stats);
+    } else {
+        crash_count = int(persons_injured_zones.countInRange(persons_injured, min_injuries, max_injuries, zone_stats));
+        printZoneScanStats("persons_injured", zone_stats);
     }
 
     auto end = std::chrono::high_resolution_clock::now();
@@ -356,16 +906,612 @@ int ProcessorUsingEpochTime::getCrashesByInjuryCountRange(int min_injuries, int
     return crash_count;
 }
 
+int ProcessorUsingEpochTime::getCrashesByCasualtyCountRange(CrashColumn column, int min_count, int max_count) {
+    if (column == CrashColumn::PersonsInjured) {
+        return getCrashesByInjuryCountRange(min_count, max_count);
+    }
+    const std::vector<uint8_t>* counts = casualtyColumn(column);
+    if (!counts) {
+        std::cerr << "Error: " << crashColumnName(column) << " is not a casualty count column" << std::endl;
+        return 0;
+    }
+    if (!columns.contains(column)) {
+        std::cerr << "Error: " << crashColumnName(column) << " was not loaded (outside the column projection)" << std::endl;
+        return 0;
+    }
+    const auto [low, high] = clampCountRange(min_count, max_count);
+    return int(RangeCount::countColumn(*counts, low, high));
+}
+
+std::vector<uint32_t> ProcessorUsingEpochTime::getCrashRowsByInjuryCountRange(int min_injuries, int max_injuries) const {
+    if (persons_injured_index.empty() || compressed_columns) {
+        std::cerr << "Error: listing injury rows needs value indexes over an uncompressed persons_injured" << std::endl;
+        return {};
+    }
+    return persons_injured_index.rows(persons_injured, min_injuries, max_injuries);
+}
+
+// The cached bitmap for key, or build() stored under it. The cache is simply emptied once
+// it holds kMaxCachedBitmaps, which is plenty for a session of interactive queries.
+template <typename Build>
+std::shared_ptr<const RowBitmap> ProcessorUsingEpochTime::cachedBitmap(const std::string& key, Build build) {
+    constexpr size_t kMaxCachedBitmaps = 64;
+    auto cached = bitmap_cache.find(key);
+    if (cached != bitmap_cache.end()) {
+        return cached->second;
+    }
+    auto bitmap = std::make_shared<const RowBitmap>(build());
+    if (bitmap_cache.size() >= kMaxCachedBitmaps) {
+        bitmap_cache.clear();
+    }
+    bitmap_cache.emplace(key, bitmap);
+    return bitmap;
+}
+
+std::shared_ptr<const RowBitmap> ProcessorUsingEpochTime::getCrashBitmapInDateRange(const std::string& start_date,
+                                                                                    const std::string& end_date) {
+    if (!columns.contains(CrashColumn::CrashDate)) {
+        std::cerr << "Error: crash_date was not loaded (outside the column projection)" << std::endl;
+        return std::make_shared<const RowBitmap>();
+    }
+    int32_t start_time = DateParser::parseDate(start_date);
+    int32_t end_time = DateParser::parseDate(end_date);
+    if (start_time == DateParser::kInvalidDate || end_time == DateParser::kInvalidDate) {
+        std::cerr << "Error: Invalid date format (Expected MM/DD/YYYY)" << std::endl;
+        return std::make_shared<const RowBitmap>();
+    }
+
+    return cachedBitmap("date:" + std::to_string(start_time) + ":" + std::to_string(end_time), [&]() {
+        std::vector<int32_t> decoded;
+        const std::vector<int32_t>& dates = plainValues(crash_dates_epoch, packed_crash_dates, decoded);
+        if (cluster_by_date) {
+            // Rows are in date order: the range is one run of rows
+            auto first = std::lower_bound(dates.begin(), dates.end(), start_time);
+            auto last = std::upper_bound(first, dates.end(), end_time);
+            return RowBitmap::range(uint32_t(first - dates.begin()), uint32_t(last - dates.begin()));
+        }
+        return RowBitmap::fromWords(RangeCount::selectColumn(dates, start_time, end_time));
+    });
+}
+
+std::shared_ptr<const RowBitmap> ProcessorUsingEpochTime::getCrashBitmapByInjuryCountRange(int min_injuries,
+                                                                                           int max_injuries) {
+    if (!columns.contains(CrashColumn::PersonsInjured)) {
+        std::cerr << "Error: persons_injured was not loaded (outside the column projection)" << std::endl;
+        return std::make_shared<const RowBitmap>();
+    }
+
+    return cachedBitmap("injured:" + std::to_string(min_injuries) + ":" + std::to_string(max_injuries), [&]() {
+        if (!persons_injured_index.empty() && !compressed_columns) {
+            return RowBitmap::fromRows(persons_injured_index.rows(persons_injured, min_injuries, max_injuries));
+        }
+        std::vector<int> decoded;
+        const std::vector<int>& injured = plainValues(persons_injured, packed_persons_injured, decoded);
+        return RowBitmap::fromWords(RangeCount::selectColumn(injured, min_injuries, max_injuries));
+    });
+}
+
+std::shared_ptr<const RowBitmap> ProcessorUsingEpochTime::getCrashBitmapByLocationRange(float lat, float lon,
+                                                                                        float radius) {
+    if (!columns.contains(CrashColumn::Latitude) || !columns.contains(CrashColumn::Longitude)) {
+        std::cerr << "Error: latitude/longitude were not loaded (outside the column projection)" << std::endl;
+        return std::make_shared<const RowBitmap>();
+    }
+
+    // Keyed by the floats' bits, so nearby but different circles never share an entry
+    auto bits = [](float value) { return std::to_string(std::bit_cast<uint32_t>(value)); };
+    return cachedBitmap("location:" + bits(lat) + ":" + bits(lon) + ":" + bits(radius), [&]() {
+        const GeoCircle circle = GeoDistance::circle(lat, lon, radius);
+        if (!location_grid.empty()) {
+            // Only the cells near the circle are read
+            GridScanStats grid_stats;
+            return RowBitmap::fromRows(location_grid.rowsWithin(circle, grid_stats));
+        }
+        return RowBitmap::fromWords(GeoDistance::selectWithin(latitudes, longitudes, circle));
+    });
+}
+
+CrashFilterCounts ProcessorUsingEpochTime::getCrashFilterCounts(const std::string& start_date,
+                                                                const std::string& end_date, int min_injuries,
+                                                                int max_injuries, float lat, float lon, float radius) {
+    if (!columns.contains(CrashColumn::CrashDate) || !columns.contains(CrashColumn::PersonsInjured) ||
+        !columns.contains(CrashColumn::Latitude) || !columns.contains(CrashColumn::Longitude)) {
+        std::cerr << "Error: crash_date, persons_injured, latitude and longitude must all be loaded" << std::endl;
+        return {};
+    }
+
+    CrashFilters filters;
+    filters.first_day = DateParser::parseDate(start_date);
+    filters.last_day = DateParser::parseDate(end_date);
+    if (filters.first_day == DateParser::kInvalidDate || filters.last_day == DateParser::kInvalidDate) {
+        std::cerr << "Error: Invalid date format (Expected MM/DD/YYYY)" << std::endl;
+        return {};
+    }
+    filters.min_injured = min_injuries;
+    filters.max_injured = max_injuries;
+    filters.circle = GeoDistance::circle(lat, lon, radius);
+
+    std::vector<int32_t> decoded_dates;
+    std::vector<int> decoded_injured;
+    return FusedFilterScan::countColumns(plainValues(crash_dates_epoch, packed_crash_dates, decoded_dates),
+                                         plainValues(persons_injured, packed_persons_injured, decoded_injured),
+                                         latitudes, longitudes, filters);
+}
+
+namespace {
+
+// Rows per chunk of the fused query pass: one zone map block, so zone maps decide whole chunks
+constexpr size_t kQueryChunkRows = ZoneMap<int32_t>::kBlockRows;
+// Rows tested to estimate a predicate no statistic covers
+constexpr size_t kSelectivitySampleRows = 4096;
+
+// Keeps the rows of selection[0, count) for which match(row) holds, without branching on it
+template <typename Match>
+size_t keepMatching(uint32_t* selection, size_t count, Match match) {
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t row = selection[i];
+        selection[kept] = row;
+        kept += match(row);
+    }
+    return kept;
+}
+
+// A CrashQuery predicate bound to the loaded columns
+struct BoundPredicate {
+    CrashQuery::Kind kind;
+    const int32_t* dates = nullptr;
+    const int* integers = nullptr;
+    const uint8_t* counts = nullptr;  // a uint8_t casualty column instead of integers
+    const float* latitudes = nullptr;
+    const float* longitudes = nullptr;
+    const void* codes = nullptr;
+    size_t code_width = 0;
+    const ZoneMap<int32_t>* date_zones = nullptr;
+    const ZoneMap<int>* integer_zones = nullptr;
+    int32_t low = 0, high = 0;
+    GeoCircle circle = {};
+    uint32_t code = 0;
+    size_t rows = 0;
+    double selectivity = 1;
+    std::string description = {};
+
+    template <typename Code>
+    bool codeMatches(uint32_t row) const {
+        return static_cast<const Code*>(codes)[row] == code;
+    }
+
+    [[nodiscard]] bool matches(uint32_t row) const {
+        switch (kind) {
+            case CrashQuery::Kind::DateRange: return dates[row] >= low && dates[row] <= high;
+            case CrashQuery::Kind::IntegerRange:
+                return counts ? counts[row] >= low && counts[row] <= high : integers[row] >= low && integers[row] <= high;
+            case CrashQuery::Kind::Circle: return GeoDistance::contains(circle, latitudes[row], longitudes[row]);
+            case CrashQuery::Kind::Equals:
+                return code_width == 1 ? codeMatches<uint8_t>(row)
+                                       : (code_width == 2 ? codeMatches<uint16_t>(row) : codeMatches<uint32_t>(row));
+        }
+        return false;
+    }
+
+    [[nodiscard]] ZoneMatch matchChunk(size_t chunk) const {
+        if (date_zones && chunk < date_zones->blockCount()) return date_zones->matchBlock(chunk, low, high);
+        if (integer_zones && chunk < integer_zones->blockCount()) return integer_zones->matchBlock(chunk, low, high);
+        return ZoneMatch::Some;
+    }
+
+    // Fraction of an evenly spaced sample of rows that match
+    [[nodiscard]] double sampleSelectivity() const {
+        const size_t step = std::max<size_t>(1, rows / kSelectivitySampleRows);
+        size_t sampled = 0, matched = 0;
+        for (size_t row = 0; row < rows; row += step, sampled++) matched += matches(uint32_t(row));
+        return sampled == 0 ? 0 : double(matched) / double(sampled);
+    }
+
+    // Fills selection with the matching rows of [begin, end), begin a multiple of 64, using the
+    // SIMD select kernels; words holds (end - begin + 63) / 64 entries of scratch
+    size_t select(size_t begin, size_t end, uint32_t* selection, uint64_t* words) const {
+        switch (kind) {
+            case CrashQuery::Kind::DateRange:
+                RangeCount::select(dates + begin, end - begin, low, high, words);
+                break;
+            case CrashQuery::Kind::IntegerRange:
+                if (counts) {
+                    RangeCount::select(counts + begin, end - begin, uint8_t(low), uint8_t(high), words);
+                } else {
+                    RangeCount::select(integers + begin, end - begin, int(low), int(high), words);
+                }
+                break;
+            case CrashQuery::Kind::Circle:
+                GeoDistance::selectWithin(latitudes + begin, longitudes + begin, end - begin, circle, words);
+                break;
+            case CrashQuery::Kind::Equals:
+                for (size_t row = begin; row < end; row++) selection[row - begin] = uint32_t(row);
+                return refine(selection, end - begin);
+        }
+        size_t count = 0;
+        for (size_t word = 0; word * 64 < end - begin; word++) {
+            for (uint64_t bits = words[word]; bits != 0; bits &= bits - 1) {
+                selection[count++] = uint32_t(begin + word * 64 + size_t(std::countr_zero(bits)));
+            }
+        }
+        return count;
+    }
+
+    // Keeps the rows of selection[0, count) that match
+    size_t refine(uint32_t* selection, size_t count) const {
+        switch (kind) {
+            case CrashQuery::Kind::DateRange:
+                return keepMatching(selection, count, [&](uint32_t row) { return dates[row] >= low && dates[row] <= high; });
+            case CrashQuery::Kind::IntegerRange:
+                if (counts) {
+                    return keepMatching(selection, count, [&](uint32_t row) { return counts[row] >= low && counts[row] <= high; });
+                }
+                return keepMatching(selection, count,
+                                    [&](uint32_t row) { return integers[row] >= low && integers[row] <= high; });
+            case CrashQuery::Kind::Circle:
+                return keepMatching(selection, count, [&](uint32_t row) {
+                    return GeoDistance::contains(circle, latitudes[row], longitudes[row]);
+                });
+            case CrashQuery::Kind::Equals:
+                if (code_width == 1) return keepMatching(selection, count, [&](uint32_t row) { return codeMatches<uint8_t>(row); });
+                if (code_width == 2) return keepMatching(selection, count, [&](uint32_t row) { return codeMatches<uint16_t>(row); });
+                return keepMatching(selection, count, [&](uint32_t row) { return codeMatches<uint32_t>(row); });
+        }
+        return 0;
+    }
+};
+
+// int64 bounds clamped to a 32-bit column, keeping an empty range empty
+std::pair<int32_t, int32_t> clampRange(int64_t low, int64_t high) {
+    if (low > high) return {1, 0};
+    return {int32_t(std::clamp<int64_t>(low, INT32_MIN, INT32_MAX)), int32_t(std::clamp<int64_t>(high, INT32_MIN, INT32_MAX))};
+}
+
+} // namespace
+
+size_t ProcessorUsingEpochTime::countMatching(const CrashQuery& query) {
+    return runQuery(query, nullptr);
+}
+
+std::vector<uint32_t> ProcessorUsingEpochTime::rowsMatching(const CrashQuery& query) {
+    std::vector<uint32_t> rows;
+    runQuery(query, &rows);
+    return rows;
+}
+
+size_t ProcessorUsingEpochTime::runQuery(const CrashQuery& query, std::vector<uint32_t>* rows) {
+    if (!query.valid()) {
+        std::cerr << "Error: Invalid date format (Expected MM/DD/YYYY)" << std::endl;
+        return 0;
+    }
+
+    // 🔹 Bind each predicate to its column and estimate its selectivity
+    std::vector<int32_t> decoded_dates;
+    std::vector<int> decoded_injured;
+    std::vector<BoundPredicate> bound;
+    for (const CrashQuery::Predicate& predicate : query.predicates()) {
+        BoundPredicate p{predicate.kind};
+        const char* name = crashColumnName(predicate.column);
+        switch (predicate.kind) {
+            case CrashQuery::Kind::DateRange: {
+                if (!columns.contains(CrashColumn::CrashDate)) {
+                    std::cerr << "Error: crash_date was not loaded (outside the column projection)" << std::endl;
+                    return 0;
+                }
+                const std::vector<int32_t>& dates = plainValues(crash_dates_epoch, packed_crash_dates, decoded_dates);
+                std::tie(p.low, p.high) = clampRange(predicate.low, predicate.high);
+                p.dates = dates.data();
+                p.rows = dates.size();
+                p.date_zones = compressed_columns ? nullptr : &crash_date_zones;
+                p.description = std::string(name) + " " + predicate.value;
+                if (daily_counts_enabled) {
+                    p.selectivity = double(daily_counts.count(p.low, p.high)) / double(std::max<size_t>(p.rows, 1));
+                } else if (p.date_zones) {
+                    p.selectivity = p.date_zones->estimateSelectivity(p.low, p.high);
+                } else {
+                    p.selectivity = p.sampleSelectivity();
+                }
+                break;
+            }
+            case CrashQuery::Kind::IntegerRange: {
+                const std::vector<uint8_t>* counts = casualtyColumn(predicate.column);
+                if (predicate.column != CrashColumn::PersonsInjured && !counts) {
+                    std::cerr << "Error: " << name << " is not stored as an integer column" << std::endl;
+                    return 0;
+                }
+                if (!columns.contains(predicate.column)) {
+                    std::cerr << "Error: " << name << " was not loaded (outside the column projection)" << std::endl;
+                    return 0;
+                }
+                if (counts) {
+                    std::tie(p.low, p.high) = clampCountRange(predicate.low, predicate.high);
+                    p.counts = counts->data();
+                    p.rows = counts->size();
+                    p.description = std::string(name) + " " + std::to_string(p.low) + "-" + std::to_string(p.high);
+                    p.selectivity = p.sampleSelectivity();
+                    break;
+                }
+                const std::vector<int>& injured = plainValues(persons_injured, packed_persons_injured, decoded_injured);
+                std::tie(p.low, p.high) = clampRange(predicate.low, predicate.high);
+                p.integers = injured.data();
+                p.rows = injured.size();
+                p.integer_zones = compressed_columns ? nullptr : &persons_injured_zones;
+                p.description = std::string(name) + " " + std::to_string(p.low) + "-" + std::to_string(p.high);
+                if (!persons_injured_index.empty()) {
+                    p.selectivity = double(persons_injured_index.count(p.low, p.high)) / double(std::max<size_t>(p.rows, 1));
+                } else if (p.integer_zones) {
+                    p.selectivity = p.integer_zones->estimateSelectivity(p.low, p.high);
+                } else {
+                    p.selectivity = p.sampleSelectivity();
+                }
+                break;
+            }
+            case CrashQuery::Kind::Circle: {
+                if (!columns.contains(CrashColumn::Latitude) || !columns.contains(CrashColumn::Longitude)) {
+                    std::cerr << "Error: latitude/longitude were not loaded (outside the column projection)" << std::endl;
+                    return 0;
+                }
+                p.latitudes = latitudes.data();
+                p.longitudes = longitudes.data();
+                p.rows = std::min(latitudes.size(), longitudes.size());
+                p.circle = GeoDistance::circle(predicate.lat, predicate.lon, predicate.radius_km);
+                std::ostringstream description;
+                description << "within " << predicate.radius_km << " km of (" << predicate.lat << ", " << predicate.lon
+                            << ")";
+                p.description = description.str();
+                if (!location_grid.empty()) {
+                    GridScanStats grid_stats;
+                    p.selectivity = double(location_grid.countWithin(p.circle, grid_stats)) / double(std::max<size_t>(p.rows, 1));
+                } else {
+                    p.selectivity = p.sampleSelectivity();
+                }
+                break;
+            }
+            case CrashQuery::Kind::Equals: {
+                const DictionaryColumn* dictionary = dictionaryColumn(predicate.column);
+                if (!dictionary || !columns.contains(predicate.column)) {
+                    std::cerr << "Error: " << name << " is not a loaded dictionary column" << std::endl;
+                    return 0;
+                }
+                const int64_t code = dictionary->findCode(predicate.value);
+                if (code < 0) {
+                    // No row has the value, so nothing can match
+                    return 0;
+                }
+                p.code = uint32_t(code);
+                p.codes = dictionary->codeData();
+                p.code_width = dictionary->codeWidth();
+                p.rows = dictionary->size();
+                p.description = std::string(name) + " = " + predicate.value;
+                p.selectivity = p.sampleSelectivity();
+                break;
+            }
+        }
+        if (!bound.empty() && p.rows != bound.front().rows) {
+            std::cerr << "Error: " << name << " has " << p.rows << " rows, not " << bound.front().rows << std::endl;
+            return 0;
+        }
+        bound.push_back(std::move(p));
+    }
+    if (bound.empty()) {
+        std::cerr << "Error: the query has no predicates" << std::endl;
+        return 0;
+    }
+    std::stable_sort(bound.begin(), bound.end(),
+                     [](const BoundPredicate& a, const BoundPredicate& b) { return a.selectivity < b.selectivity; });
+
+    std::cout << "Query plan:";
+    for (const BoundPredicate& p : bound) {
+        std::cout << (&p == &bound.front() ? " " : " -> ") << p.description << " (est. " << p.selectivity * 100 << "%)";
+    }
+    std::cout << "\n";
+
+    // 🔹 One pass over the chunks: the first predicate fills the selection vector, the others
+    // shrink it, so later predicates only read the rows still in play
+    const size_t row_count = bound.front().rows;
+    const size_t chunks = (row_count + kQueryChunkRows - 1) / kQueryChunkRows;
+    std::vector<std::vector<uint32_t>> chunk_rows(rows ? chunks : 0);
+    size_t matches = 0, skipped_chunks = 0;
+    #pragma omp parallel reduction(+:matches, skipped_chunks)
+    {
+        std::vector<uint32_t> selection(kQueryChunkRows);
+        std::vector<uint64_t> words(kQueryChunkRows / 64);
+        std::vector<const BoundPredicate*> active;
+        #pragma omp for schedule(dynamic, 16)
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            // Zone maps drop predicates the whole chunk satisfies, or rule the chunk out
+            active.clear();
+            bool ruled_out = false;
+            for (const BoundPredicate& p : bound) {
+                const ZoneMatch zone = p.matchChunk(chunk);
+                ruled_out = ruled_out || zone == ZoneMatch::None;
+                if (zone == ZoneMatch::Some) active.push_back(&p);
+            }
+            if (ruled_out) {
+                skipped_chunks++;
+                continue;
+            }
+
+            const size_t begin = chunk * kQueryChunkRows;
+            const size_t end = std::min(row_count, begin + kQueryChunkRows);
+            size_t count = end - begin;
+            if (active.empty()) {
+                for (size_t row = begin; row < end; row++) selection[row - begin] = uint32_t(row);
+            } else {
+                count = active.front()->select(begin, end, selection.data(), words.data());
+                for (size_t i = 1; i < active.size() && count > 0; i++) count = active[i]->refine(selection.data(), count);
+            }
+            matches += count;
+            if (rows) chunk_rows[chunk].assign(selection.begin(), selection.begin() + ptrdiff_t(count));
+        }
+    }
+    std::cout << "Fused scan: " << skipped_chunks << " of " << chunks << " chunks ruled out by zone maps\n";
+
+    if (rows) {
+        rows->clear();
+        rows->reserve(matches);
+        for (const std::vector<uint32_t>& part : chunk_rows) rows->insert(rows->end(), part.begin(), part.end());
+    }
+    return matches;
+}
+
+GroupResult ProcessorUsingEpochTime::groupBy(const std::vector<CrashColumn>& keys, const CrashQuery* filter) {
+    if (!columns.contains(CrashColumn::PersonsInjured)) {
+        std::cerr << "Error: persons_injured was not loaded (outside the column projection)" << std::endl;
+        return {};
+    }
+
+    std::vector<int32_t> decoded_dates;
+    std::vector<int> decoded_injured;
+    GroupBy group_by;
+    for (CrashColumn column : keys) {
+        if (column == CrashColumn::CrashDate && columns.contains(column)) {
+            group_by.key(GroupKey::year("crash_year", plainValues(crash_dates_epoch, packed_crash_dates, decoded_dates)));
+            continue;
+        }
+        const DictionaryColumn* dictionary = dictionaryColumn(column);
+        if (!dictionary || !columns.contains(column)) {
+            std::cerr << "Error: " << crashColumnName(column) << " is not a loaded dictionary column" << std::endl;
+            return {};
+        }
+        group_by.key(GroupKey::dictionary(crashColumnName(column), *dictionary));
+    }
+    const std::vector<int>& injured = plainValues(persons_injured, packed_persons_injured, decoded_injured);
+    group_by.measure(GroupMeasure::of(crashColumnName(CrashColumn::PersonsInjured), injured));
+    for (CrashColumn column : kCasualtyColumns) {
+        if (columns.contains(column)) group_by.measure(GroupMeasure::of(crashColumnName(column), *casualtyColumn(column)));
+    }
+
+    if (!filter) return group_by.run(injured.size());
+    const std::vector<uint32_t> rows = rowsMatching(*filter);
+    return group_by.run(injured.size(), &rows);
+}
+
+std::vector<TopKPair> ProcessorUsingEpochTime::getTopIntersectionsByInjuries(const std::string& start_date,
+                                                                            const std::string& end_date, size_t k,
+                                                                            bool approximate) {
+    if (!columns.contains(CrashColumn::OnStreetName) || !columns.contains(CrashColumn::CrossStreetName) ||
+        !columns.contains(CrashColumn::PersonsInjured) || !columns.contains(CrashColumn::CrashDate)) {
+        std::cerr << "Error: on_street_name, cross_street_name, persons_injured and crash_date must all be loaded"
+                  << std::endl;
+        return {};
+    }
+
+    // Only crashes in the window that injured anyone can add weight
+    CrashQuery window;
+    window.dateBetween(start_date, end_date).between(CrashColumn::PersonsInjured, 1, INT32_MAX);
+    const std::vector<uint32_t> rows = rowsMatching(window);
+
+    std::vector<int> decoded_injured;
+    const std::vector<int>& injured = plainValues(persons_injured, packed_persons_injured, decoded_injured);
+    return approximate ? TopKPairs::approximate(on_street_name, cross_street_name, injured, rows, k)
+                       : TopKPairs::exact(on_street_name, cross_street_name, injured, rows, k);
+}
+
+std::vector<uint32_t> ProcessorUsingEpochTime::getCrashTimeSeries(const std::string& start_date,
+                                                                 const std::string& end_date, TimeBucket bucket) {
+    if (!columns.contains(CrashColumn::CrashDate) || !columns.contains(CrashColumn::CrashTime)) {
+        std::cerr << "Error: crash_date and crash_time must both be loaded" << std::endl;
+        return {};
+    }
+    const int32_t first_day = DateParser::parseDate(start_date);
+    const int32_t last_day = DateParser::parseDate(end_date);
+    if (first_day == DateParser::kInvalidDate || last_day == DateParser::kInvalidDate) {
+        std::cerr << "Error: Invalid date format (Expected MM/DD/YYYY)" << std::endl;
+        return {};
+    }
+
+    if (hourly_counts_enabled && !hourly_counts.empty()) {
+        return hourly_counts.histogram(first_day, last_day, bucket);
+    }
+    std::vector<int32_t> decoded_dates;
+    return TimeSeries::histogram(plainValues(crash_dates_epoch, packed_crash_dates, decoded_dates), crash_minutes,
+                                 first_day, last_day, bucket);
+}
+
+std::vector<uint32_t> ProcessorUsingEpochTime::getCrashRowsInDateRange(const std::string& start_date,
+                                                                      const std::string& end_date) {
+    CrashQuery query;
+    query.dateBetween(start_date, end_date);
+    return rowsMatching(query);
+}
+
+std::vector<uint32_t> ProcessorUsingEpochTime::getCrashRowsByLocationRange(float lat, float lon, float radius) {
+    CrashQuery query;
+    query.within(lat, lon, radius);
+    return rowsMatching(query);
+}
+
+void ProcessorUsingEpochTime::fillRecord(uint32_t row, const CrashColumnSet& wanted, CrashRecord& record) const {
+    auto want = [&](CrashColumn column) { return wanted.contains(column) && columns.contains(column); };
+    if (want(CrashColumn::CrashDate)) {
+        const int32_t days = valueAt(crash_dates_epoch, packed_crash_dates, row);
+        record.crash_date = DateParser::formatDate(days);
+        record.crash_date_epoch = days == DateParser::kInvalidDate ? 0 : time_t(days) * 86400;
+    }
+    if (want(CrashColumn::Latitude)) record.latitude = latitudes[row];
+    if (want(CrashColumn::Longitude)) record.longitude = longitudes[row];
+    if (want(CrashColumn::PersonsInjured)) record.persons_injured = valueAt(persons_injured, packed_persons_injured, row);
+    for (CrashColumn column : kCasualtyColumns) {
+        if (want(column)) *recordCount(record, column) = (*casualtyColumn(column))[row];
+    }
+    if (want(CrashColumn::CollisionId)) record.collision_id = valueAt(collision_ids, packed_collision_ids, row);
+    for (size_t column = 0; column < size_t(CrashColumn::Count); column++) {
+        if (!want(CrashColumn(column))) continue;
+        if (std::string* text = recordText(record, CrashColumn(column))) *text = getText(CrashColumn(column), row);
+    }
+}
+
+std::vector<CrashRecord> ProcessorUsingEpochTime::materializeRows(const uint32_t* rows, size_t count,
+                                                                  const CrashColumnSet& wanted) const {
+    std::vector<CrashRecord> records(count, CrashRecord{});
+    // A page of rows is not worth waking the thread pool for
+    #pragma omp parallel for schedule(static) if (count >= kParallelMaterializeRows)
+    for (size_t i = 0; i < count; i++) fillRecord(rows[i], wanted, records[i]);
+    return records;
+}
+
+std::vector<CrashRecord> ProcessorUsingEpochTime::materializeRows(const std::vector<uint32_t>& rows,
+                                                                  const CrashColumnSet& wanted) const {
+    return materializeRows(rows.data(), rows.size(), wanted);
+}
+
+ProcessorUsingEpochTime::RowCursor ProcessorUsingEpochTime::openCursor(std::vector<uint32_t> rows,
+                                                                       CrashColumnSet wanted) const {
+    return RowCursor(*this, std::make_shared<const std::vector<uint32_t>>(std::move(rows)), wanted);
+}
+
+ProcessorUsingEpochTime::RowCursor::RowCursor(const ProcessorUsingEpochTime& processor,
+                                              std::shared_ptr<const std::vector<uint32_t>> rows,
+                                              CrashColumnSet wanted)
+    : processor(&processor), rows(std::move(rows)), wanted(wanted) {}
+
+std::vector<CrashRecord> ProcessorUsingEpochTime::RowCursor::next(size_t page_rows) {
+    const size_t count = std::min(page_rows, rows->size() - position);
+    std::vector<CrashRecord> page = processor->materializeRows(rows->data() + position, count, wanted);
+    position += count;
+    return page;
+}
+
 int ProcessorUsingEpochTime::getCrashesByLocationRange(float lat, float lon, float radius) {
     auto start = std::chrono::high_resolution_clock::now();
     int crash_count = 0;
 
-    #pragma omp parallel for reduction(+:crash_count)
-    for (size_t i = 0; i < latitudes.size(); i++) {
-        float dist = std::sqrt(std::pow(latitudes[i] - lat, 2) + std::pow(longitudes[i] - lon, 2));
-        if (dist <= radius) {
-            crash_count++;
-        }
+    if (!columns.contains(CrashColumn::Latitude) || !columns.contains(CrashColumn::Longitude)) {
+        std::cerr << "Error: latitude/longitude were not loaded (outside the column projection)" << std::endl;
+        return 0;
+    }
+
+    const GeoCircle circle = GeoDistance::circle(lat, lon, radius);
+    if (!location_grid.empty()) {
+        GridScanStats grid_stats;
+        crash_count = int(location_grid.countWithin(circle, grid_stats));
+        std::cout << "Spatial grid: " << grid_stats.cells << " cells in the bounding box, " << grid_stats.skipped
+                  << " skipped, " << grid_stats.full << " counted in full, " << grid_stats.tested() << " tested ("
+                  << grid_stats.tested_points << " points)\n";
+    } else {
+        crash_count = int(GeoDistance::countWithin(latitudes, longitudes, circle));
     }
 
     auto end = std::chrono::high_resolution_clock::now();
@@ -3,39 +3,68 @@
 
 #include "../../common/CrashRecord.h"
 #include "../../common/ICrashDataProcessor.h"
+#include "../../common/CrashColumns.h"
+#include "../../common/MappedFile.h"
+#include "../../common/StringColumn.h"
+#include "../../common/DictionaryColumn.h"
+#include "../../common/ColumnSnapshot.h"
+#include "../../common/CompressedIntColumn.h"
+#include "../../common/ZoneMap.h"
+#include "../../common/DailyCounts.h"
+#include "../../common/ValueCountIndex.h"
+#include "../../common/SpatialGrid.h"
+#include "../../common/RowBitmap.h"
+#include "../../common/CrashQuery.h"
+#include "../../common/FusedFilterScan.h"
+#include "../../common/GroupBy.h"
+#include "../../common/TimeSeries.h"
+#include "../../common/HourlyCounts.h"
+#include "../../common/TopKPairs.h"
 
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 #include <chrono>
+#include <memory>
 #include <string>
+#include <utility>
 
 class ProcessorUsingEpochTime : public ICrashDataProcessor {
 private:
-    std::vector<time_t> crash_dates_epoch;
+    std::vector<int32_t> crash_dates_epoch;  // days since 1970-01-01
      std::vector<std::string> crash_dates;
     std::vector<int> persons_injured;
+    // The other casualty counts, one byte a row (saturated at 255)
+    std::vector<uint8_t> persons_killed;
+    std::vector<uint8_t> pedestrians_injured;
+    std::vector<uint8_t> pedestrians_killed;
+    std::vector<uint8_t> cyclists_injured;
+    std::vector<uint8_t> cyclists_killed;
+    std::vector<uint8_t> motorists_injured;
+    std::vector<uint8_t> motorists_killed;
     std::vector<float> latitudes;
     std::vector<float> longitudes;
 
-    std::vector<std::string> crash_time;
-    std::vector<std::string> borough;
-    std::vector<std::string> zip_code;
-    std::vector<std::string> locations;
-    std::vector<std::string> on_street_name;
-    std::vector<std::string> cross_street_name;
-    std::vector<std::string> off_street_name;
-    std::vector<std::string> contributing_factor_vehicle_1;
-    std::vector<std::string> contributing_factor_vehicle_2;
-    std::vector<std::string> contributing_factor_vehicle_3;
-    std::vector<std::string> contributing_factor_vehicle_4;
-    std::vector<std::string> contributing_factor_vehicle_5;
+    StringColumn crash_time;
+    std::vector<uint16_t> crash_minutes;  // crash_time as minutes since midnight, or DateParser::kInvalidTime
+    DictionaryColumn borough;
+    StringColumn zip_code;
+    StringColumn locations;
+    StringColumn on_street_name;
+    StringColumn cross_street_name;
+    StringColumn off_street_name;
+    DictionaryColumn contributing_factor_vehicle_1;
+    DictionaryColumn contributing_factor_vehicle_2;
+    DictionaryColumn contributing_factor_vehicle_3;
+    DictionaryColumn contributing_factor_vehicle_4;
+    DictionaryColumn contributing_factor_vehicle_5;
     std::vector<long> collision_ids;
-    std::vector<std::string> vehicle_type_code_1;
-    std::vector<std::string> vehicle_type_code_2;
-    std::vector<std::string> vehicle_type_code_3;
-    std::vector<std::string> vehicle_type_code_4;
-    std::vector<std::string> vehicle_type_code_5;
-    std::vector<std::string> vehicle_type_code_6;
+    DictionaryColumn vehicle_type_code_1;
+    DictionaryColumn vehicle_type_code_2;
+    DictionaryColumn vehicle_type_code_3;
+    DictionaryColumn vehicle_type_code_4;
+    DictionaryColumn vehicle_type_code_5;
+    DictionaryColumn vehicle_type_code_6;
     std::vector<std::string> vehicle_type_1;
     std::vector<std::string> vehicle_type_2;
     std::vector<std::string> vehicle_type_3;
@@ -48,15 +77,182 @@ private:
     std::chrono::duration<double> injury_range_Searching_duration = {};
     std::chrono::duration<double> location_range_Searching_duration = {};
 
+    bool use_simd_tokenizer;
+    CrashColumnSet columns = CrashColumnSet::all();
+    bool zero_copy_strings = false;
+    MappedFile mapping;  // retained only for zero-copy text columns (into the CSV or a snapshot)
+    std::string snapshot_path;  // empty: always parse the CSV
+    // Per-block min/max of the plain columns, built at the end of loadData
+    ZoneMap<int32_t> crash_date_zones;
+    ZoneMap<int> persons_injured_zones;
+    bool cluster_by_date = false;
+    bool daily_counts_enabled = false;
+    DailyCounts daily_counts;  // per day, and per borough code when borough is loaded
+    bool hourly_counts_enabled = false;
+    HourlyCounts hourly_counts;
+    bool value_indexes_enabled = false;
+    ValueCountIndex persons_injured_index;
+    bool spatial_index_enabled = false;
+    SpatialGrid location_grid;
+    bool compressed_columns = false;
+    // Filled instead of crash_dates_epoch, persons_injured and collision_ids when compressed_columns is set
+    CompressedIntColumn packed_crash_dates;
+    CompressedIntColumn packed_persons_injured;
+    CompressedIntColumn packed_collision_ids;
+    // Row bitmaps of recent bitmap queries by predicate ("date:<first>:<last>", ...); cleared by loadData
+    std::unordered_map<std::string, std::shared_ptr<const RowBitmap>> bitmap_cache;
+
     void processLinesParallel(const std::vector<std::string>& lines);
-    void processFileParallel(char* data, size_t file_size);
+    void processFileParallel(const char* data, size_t file_size);
+    const StringColumn* textColumn(CrashColumn column) const;
+    const DictionaryColumn* dictionaryColumn(CrashColumn column) const;
+    const std::vector<uint8_t>* casualtyColumn(CrashColumn column) const;
+    StringColumn* textColumn(CrashColumn column);
+    DictionaryColumn* dictionaryColumn(CrashColumn column);
+    std::vector<uint8_t>* casualtyColumn(CrashColumn column);
+    bool loadSnapshot(const SnapshotSource& source);
+    void saveSnapshot(const SnapshotSource& source) const;
+    void clusterByDate();
+    void compressColumns();
+    void printCompressedColumnMemory() const;
+    void printTextColumnMemory() const;
+    template <typename Build>
+    std::shared_ptr<const RowBitmap> cachedBitmap(const std::string& key, Build build);
+    size_t runQuery(const CrashQuery& query, std::vector<uint32_t>* rows);
+    void fillRecord(uint32_t row, const CrashColumnSet& wanted, CrashRecord& record) const;
 
 public:
-    ProcessorUsingEpochTime();
+    // Pages through a row selection, materializing only the rows of each page. The rows are
+    // shared, not copied, between copies of a cursor. Valid until the next loadData.
+    class RowCursor {
+    public:
+        static constexpr size_t kPageRows = 100;
+
+        RowCursor(const ProcessorUsingEpochTime& processor, std::shared_ptr<const std::vector<uint32_t>> rows,
+                  CrashColumnSet wanted);
+
+        // The records of the next page_rows rows; fewer at the end, none once done
+        std::vector<CrashRecord> next(size_t page_rows = kPageRows);
+        void seek(size_t row_offset) { position = std::min(row_offset, rows->size()); }
+
+        [[nodiscard]] bool done() const { return position >= rows->size(); }
+        [[nodiscard]] size_t offset() const { return position; }
+        [[nodiscard]] size_t size() const { return rows->size(); }
+
+    private:
+        const ProcessorUsingEpochTime* processor;
+        std::shared_ptr<const std::vector<uint32_t>> rows;
+        CrashColumnSet wanted;
+        size_t position = 0;
+    };
+
+    // use_simd_tokenizer = false keeps a scalar byte-loop splitter as a baseline
+    explicit ProcessorUsingEpochTime(bool use_simd_tokenizer = true);
+
+    // Load only these columns on the next loadData, e.g. CrashColumnSet::forQueries({...})
+    void setColumnProjection(const CrashColumnSet& projected_columns);
+
+    // Keep the CSV mapped after loadData and store text columns as references into it
+    void setZeroCopyStrings(bool enabled);
+
+    // Answer loadData from a binary snapshot at path when it matches the CSV's size and
+    // mtime; otherwise parse the CSV and (re)write the snapshot
+    void setSnapshotPath(const std::string& path);
+
+    // Reorder all rows by crash date at the end of loadData, so date ranges are found by binary
+    // search. Row numbers passed to getText then follow date order, not file order.
+    void setDateClustering(bool enabled);
+
+    // Build per-day prefix counts at the end of loadData, so any date range (and its per-borough
+    // breakdown) is answered with two lookups
+    void setDailyCounts(bool enabled);
+
+    // Build per-day x per-hour prefix counts at the end of loadData, so getCrashTimeSeries
+    // answers any window without scanning rows
+    void setHourlyCounts(bool enabled);
+
+    // Index the values of persons_injured at the end of loadData: injury range counts become
+    // two lookups, and getCrashRowsByInjuryCountRange can list the matching rows
+    void setValueIndexes(bool enabled);
+
+    // Build a uniform lat/lon grid at the end of loadData; location queries then test single
+    // points only in the cells the circle's boundary crosses
+    void setSpatialIndex(bool enabled);
+
+    // Keep the date, injury and collision id columns block-compressed after loadData; the
+    // date and injury range counts then run on the packed codes
+    void setCompressedColumns(bool enabled);
+
+    // Text of a string column; a view into the mapping when zero-copy is enabled
+    [[nodiscard]] std::string_view getText(CrashColumn column, size_t row) const;
+    [[nodiscard]] std::string materializeText(CrashColumn column, size_t row) const;
+
     void loadData(const std::string& filename) override;
     int getCrashesInDateRange(const std::string& start_date, const std::string& end_date) override;
     int getCrashesByInjuryCountRange(int min_injuries, int max_injuries) override;
+    // Crashes per borough (in name order; "" for unknown) in a date range. Needs daily counts
+    // and the borough column.
+    [[nodiscard]] std::vector<std::pair<std::string, int>> getCrashesInDateRangeByBorough(const std::string& start_date,
+                                                                                        const std::string& end_date) const;
     int getCrashesByLocationRange(float lat, float lon, float radius) override;
+    // Crashes per hour, hour of day, day or week of [start_date, end_date] (see TimeSeries),
+    // from the hourly counts when enabled, else from one parallel pass over crash_date and
+    // crash_time. Errors give an empty series.
+    std::vector<uint32_t> getCrashTimeSeries(const std::string& start_date, const std::string& end_date,
+                                             TimeBucket bucket);
+    // Rows (ascending) with min_injuries <= persons_injured <= max_injuries. Needs value indexes
+    // and an uncompressed persons_injured.
+    [[nodiscard]] std::vector<uint32_t> getCrashRowsByInjuryCountRange(int min_injuries, int max_injuries) const;
+    // Crashes with min_count <= column <= max_count for any casualty count (persons_injured
+    // through motorists_killed), with the SIMD range kernels split across threads
+    int getCrashesByCasualtyCountRange(CrashColumn column, int min_count, int max_count);
+
+    // The matching rows of each query as a compressed bitmap, to be combined with
+    // intersect/unite/subtract. Results are cached by predicate until the next loadData, so a
+    // predicate repeated across queries is a lookup. Errors give an empty bitmap.
+    std::shared_ptr<const RowBitmap> getCrashBitmapInDateRange(const std::string& start_date, const std::string& end_date);
+    std::shared_ptr<const RowBitmap> getCrashBitmapByInjuryCountRange(int min_injuries, int max_injuries);
+    std::shared_ptr<const RowBitmap> getCrashBitmapByLocationRange(float lat, float lon, float radius);
+
+    // Crashes in the date range, in the injury range and within radius km of (lat, lon), each
+    // alone and all three together, from one cache-blocked pass over the columns
+    CrashFilterCounts getCrashFilterCounts(const std::string& start_date, const std::string& end_date, int min_injuries,
+                                           int max_injuries, float lat, float lon, float radius);
+
+    // Rows matching every predicate of query (rowsMatching: ascending). Predicates run most
+    // selective first, by estimates from daily counts, the value index, the spatial grid or
+    // zone maps, else a sample of rows, in one parallel pass over 4096-row chunks: the first
+    // fills a selection vector and the others test only the rows left in it. Chunks a zone
+    // map rules out are skipped. Integer ranges cover the casualty counts; equality covers the
+    // dictionary-encoded text columns.
+    size_t countMatching(const CrashQuery& query);
+    std::vector<uint32_t> rowsMatching(const CrashQuery& query);
+
+    // Rows (ascending) of the date and location range queries, for materializeRows or a cursor
+    std::vector<uint32_t> getCrashRowsInDateRange(const std::string& start_date, const std::string& end_date);
+    std::vector<uint32_t> getCrashRowsByLocationRange(float lat, float lon, float radius);
+
+    // CrashRecords of the given rows, built in parallel. Only the fields of wanted columns that
+    // were loaded are filled; the rest stay empty or 0.
+    [[nodiscard]] std::vector<CrashRecord> materializeRows(const uint32_t* rows, size_t count,
+                                                           const CrashColumnSet& wanted = CrashColumnSet::all()) const;
+    [[nodiscard]] std::vector<CrashRecord> materializeRows(const std::vector<uint32_t>& rows,
+                                                           const CrashColumnSet& wanted = CrashColumnSet::all()) const;
+    // A cursor over rows, which are moved into it
+    [[nodiscard]] RowCursor openCursor(std::vector<uint32_t> rows, CrashColumnSet wanted = CrashColumnSet::all()) const;
+
+    // Crash count and sum/min/max/avg of each loaded casualty count (persons_injured first, then
+    // in column order) per combination of keys, over all rows or the rows matching filter. Keys
+    // are dictionary-encoded text columns, or CrashDate for the crash year. Errors give an
+    // empty result.
+    GroupResult groupBy(const std::vector<CrashColumn>& keys, const CrashQuery* filter = nullptr);
+
+    // The k (on_street_name, cross_street_name) intersections with the most persons injured
+    // in [start_date, end_date], heaviest first (see TopKPairs: names are trimmed, a pair
+    // counts in either order, crashes without both names are skipped). approximate counts
+    // with Space-Saving sketches instead of a table of every pair. Errors give an empty list.
+    std::vector<TopKPair> getTopIntersectionsByInjuries(const std::string& start_date, const std::string& end_date,
+                                                        size_t k, bool approximate = false);
 
     std::chrono::duration<double> getDataLoadDuration() const override;
     std::chrono::duration<double> getDateRangeSearchingDuration() const override;
@@ -1,4 +1,6 @@
 #include "ParallelVectorReserve.h"
+#include "../../common/GeoDistance.h"
+#include "../../common/NumericParser.h"
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -76,12 +78,10 @@ void ProcessorUsingBufferedFileReadVectorReserveThreads::processLinesParallel(co
         std::getline(ss, record.zip_code, ',');
 
         std::getline(ss, token, ',');
-        try { record.latitude = token.empty() ? 0.0f : std::stof(token); }
-        catch (...) { record.latitude = 0.0f; }
+        record.latitude = NumericParser::toFloat(token);
 
         std::getline(ss, token, ',');
-        try { record.longitude = token.empty() ? 0.0f : std::stof(token); }
-        catch (...) { record.longitude = 0.0f; }
+        record.longitude = NumericParser::toFloat(token);
 
         std::getline(ss, record.location, ',');
         std::getline(ss, record.on_street_name, ',');
@@ -89,23 +89,17 @@ void ProcessorUsingBufferedFileReadVectorReserveThreads::processLinesParallel(co
         std::getline(ss, record.off_street_name, ',');
 
         std::getline(ss, token, ',');
-        try { record.persons_injured = token.empty() ? 0 : std::stoi(token); }
-        catch (...) { record.persons_injured = 0; }
+        record.persons_injured = NumericParser::toInt(token);
 
         std::getline(ss, token, ',');
-        try { record.persons_killed = token.empty() ? 0 : std::stoi(token); }
-        catch (...) { record.persons_killed = 0; }
-        try { record.cyclists_injured = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.cyclists_injured = 0; }
+        record.persons_killed = NumericParser::toInt(token);
+        record.cyclists_injured = NumericParser::toInt(token);
 
-        try { record.cyclists_killed = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.cyclists_killed = 0; }
+        record.cyclists_killed = NumericParser::toInt(token);
 
-        try { record.motorists_injured = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.motorists_injured = 0; }
+        record.motorists_injured = NumericParser::toInt(token);
 
-        try { record.motorists_killed = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.motorists_killed = 0; }
+        record.motorists_killed = NumericParser::toInt(token);
 
         std::getline(ss, record.contributing_factor_vehicle_1, ',');
         std::getline(ss, record.contributing_factor_vehicle_2, ',');
@@ -113,8 +107,7 @@ void ProcessorUsingBufferedFileReadVectorReserveThreads::processLinesParallel(co
         std::getline(ss, record.contributing_factor_vehicle_4, ',');
         std::getline(ss, record.contributing_factor_vehicle_5, ',');
 
-        try { record.collision_id= token.empty() ? 0 : std::stol(token); }
-        catch (const std::exception&) { record.collision_id = 0; }
+        record.collision_id = NumericParser::toInt<long>(token);
         std::getline(ss, record.vehicle_type_code_1, ',');
         std::getline(ss, record.vehicle_type_code_2, ',');
         std::getline(ss, record.vehicle_type_code_3, ',');
@@ -187,10 +180,11 @@ int ProcessorUsingBufferedFileReadVectorReserveThreads::getCrashesByLocationRang
     auto start = std::chrono::high_resolution_clock::now();
     int crash_count = 0;
 
+    const GeoCircle circle = GeoDistance::circle(lat, lon, radius);
+
     #pragma omp parallel for reduction(+:crash_count)
     for (size_t i = 0; i < records.size(); i++) {
-        float dist = std::sqrt(std::pow(records[i].latitude - lat, 2) + std::pow(records[i].longitude - lon, 2));
-        if (dist <= radius) {
+        if (GeoDistance::contains(circle, records[i].latitude, records[i].longitude)) {
             crash_count++;
         }
     }
@@ -1,4 +1,5 @@
 #include "ProcessorUsingThreads.h"
+#include "../../common/NumericParser.h"
 #include <iostream>
 #include <sstream>
 #include <fstream>
@@ -40,10 +41,10 @@ void ProcessorUsingThreads::loadData(const std::string& filename) {
         std::getline(ss, record.zip_code, ',');
 
         std::getline(ss, token, ',');
-        record.latitude = token.empty() ? 0.0f : std::stof(token);
+        record.latitude = NumericParser::toFloat(token);
 
         std::getline(ss, token, ',');
-        record.longitude = token.empty() ? 0.0f : std::stof(token);
+        record.longitude = NumericParser::toFloat(token);
 
         std::getline(ss, record.location, ',');
         std::getline(ss, record.on_street_name, ',');
@@ -51,20 +52,15 @@ void ProcessorUsingThreads::loadData(const std::string& filename) {
         std::getline(ss, record.off_street_name, ',');
 
         std::getline(ss, token, ',');
-        try { record.persons_injured = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.persons_injured = 0; }
+        record.persons_injured = NumericParser::toInt(token);
 
-        try { record.cyclists_injured = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.cyclists_injured = 0; }
+        record.cyclists_injured = NumericParser::toInt(token);
 
-        try { record.cyclists_killed = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.cyclists_killed = 0; }
+        record.cyclists_killed = NumericParser::toInt(token);
 
-        try { record.motorists_injured = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.motorists_injured = 0; }
+        record.motorists_injured = NumericParser::toInt(token);
 
-        try { record.motorists_killed = token.empty() ? 0 : std::stoi(token); }
-        catch (const std::exception&) { record.motorists_killed = 0; }
+        record.motorists_killed = NumericParser::toInt(token);
 
         std::getline(ss, record.contributing_factor_vehicle_1, ',');
         std::getline(ss, record.contributing_factor_vehicle_2, ',');
@@ -72,8 +68,7 @@ void ProcessorUsingThreads::loadData(const std::string& filename) {
         std::getline(ss, record.contributing_factor_vehicle_4, ',');
         std::getline(ss, record.contributing_factor_vehicle_5, ',');
 
-        try { record.collision_id= token.empty() ? 0 : std::stol(token); }
-        catch (const std::exception&) { record.collision_id = 0; }
+        record.collision_id = NumericParser::toInt<long>(token);
         std::getline(ss, record.vehicle_type_code_1, ',');
         std::getline(ss, record.vehicle_type_code_2, ',');
         std::getline(ss, record.vehicle_type_code_3, ',');
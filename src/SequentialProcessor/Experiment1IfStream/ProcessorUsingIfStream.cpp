@@ -12,6 +12,8 @@
 #include <iomanip>
 #include <ctime>
 #include "ProcessorUsingIfStream.h"
+#include "../../common/GeoDistance.h"
+#include "../../common/NumericParser.h"
 #include "../../MemoryUsage.h"
 
 
@@ -38,62 +40,37 @@ void ProcessorUsingIfStream::loadData(const std::string& filename) {
         std::getline(ss, record.borough, ',');
         std::getline(ss, record.zip_code, ',');
         std::getline(ss, token, ',');
-        record.latitude = token.empty() ? 0.0f : std::stof(token);
+        record.latitude = NumericParser::toFloat(token);
         std::getline(ss, token, ',');
-        record.longitude = token.empty() ? 0.0f : std::stof(token);
+        record.longitude = NumericParser::toFloat(token);
         std::getline(ss, record.location, ',');
         std::getline(ss, record.on_street_name, ',');
         std::getline(ss, record.cross_street_name, ',');
         std::getline(ss, record.off_street_name, ',');
         std::getline(ss, token, ',');
-        try {
-        record.persons_injured = token.empty() ? 0 : std::stoi(token);
-     } catch (const std::invalid_argument& e) {
-        record.persons_injured = 0;
-    }
+        record.persons_injured = NumericParser::toInt(token);
 
         std::getline(ss, token, ',');
 
-        try {record.persons_killed = token.empty() ? 0 : std::stoi(token);}
-        catch (const std::invalid_argument& e) {
-            record.persons_killed = 0;
-        }
+        record.persons_killed = NumericParser::toInt(token);
 
         std::getline(ss, token, ',');
-       try{ record.pedestrians_injured = token.empty() ? 0 : std::stoi(token);}
-        catch (const std::invalid_argument& e) {
-            record.pedestrians_injured = 0;
-        }
+        record.pedestrians_injured = NumericParser::toInt(token);
 
         std::getline(ss, token, ',');
-        try{record.pedestrians_killed = token.empty() ? 0 : std::stoi(token);}
-        catch (const std::invalid_argument& e) {
-            record.pedestrians_killed = 0;
-        }
+        record.pedestrians_killed = NumericParser::toInt(token);
 
         std::getline(ss, token, ',');
-        try{record.cyclists_injured = token.empty() ? 0 : std::stoi(token);}
-        catch (const std::invalid_argument& e) {
-            record.cyclists_injured = 0;
-        }
+        record.cyclists_injured = NumericParser::toInt(token);
 
         std::getline(ss, token, ',');
-        try{record.cyclists_killed = token.empty() ? 0 : std::stoi(token);}
-        catch (const std::invalid_argument& e) {
-            record.cyclists_killed = 0;
-        }
+        record.cyclists_killed = NumericParser::toInt(token);
 
         std::getline(ss, token, ',');
-        try{record.motorists_injured = token.empty() ? 0 : std::stoi(token);}
-        catch (const std::invalid_argument& e) {
-            record.motorists_injured = 0;
-        }
+        record.motorists_injured = NumericParser::toInt(token);
 
         std::getline(ss, token, ',');
-        try{record.motorists_killed = token.empty() ? 0 : std::stoi(token);}
-        catch (const std::invalid_argument& e) {
-            record.motorists_killed = 0;
-        }
+        record.motorists_killed = NumericParser::toInt(token);
 
         std::getline(ss, record.contributing_factor_vehicle_1, ',');
         std::getline(ss, record.contributing_factor_vehicle_2, ',');
@@ -101,11 +78,7 @@ void ProcessorUsingIfStream::loadData(const std::string& filename) {
         std::getline(ss, record.contributing_factor_vehicle_4, ',');
         std::getline(ss, record.contributing_factor_vehicle_5, ',');
         std::getline(ss, token, ',');
-        try {
-            record.collision_id = token.empty() ? 0 : std::stol(token);
-        } catch (const std::invalid_argument& e) {
-            record.collision_id = 0;
-        }
+        record.collision_id = NumericParser::toInt<long>(token);
         std::getline(ss, record.vehicle_type_code_1, ',');
         std::getline(ss, record.vehicle_type_code_2, ',');
         std::getline(ss, record.vehicle_type_code_3, ',');
@@ -179,14 +152,10 @@ int ProcessorUsingIfStream::getCrashesByInjuryCountRange(int min_injuries, int m
 int ProcessorUsingIfStream::getCrashesByLocationRange(float lat, float lon, float radius)  {
         auto start = std::chrono::high_resolution_clock::now();
         int crash_count = 0;
-        float radius_squared = radius * radius; // Precompute squared radius
+        const GeoCircle circle = GeoDistance::circle(lat, lon, radius); // Bounding box and km scale, once
 
         for (const auto& record : records) {
-            float d_lat = record.latitude - lat;
-            float d_lon = record.longitude - lon;
-            float dist_squared = d_lat * d_lat + d_lon * d_lon; // Squared distance calculation
-
-            if (dist_squared <= radius_squared) {
+            if (GeoDistance::contains(circle, record.latitude, record.longitude)) {
                 crash_count++;
             }
         }
@@ -1,5 +1,7 @@
 
 #include "ProcessorUsingBufferedFileRead.h"
+#include "../../common/GeoDistance.h"
+#include "../../common/NumericParser.h"
 
 #include <iostream>
 #include <fstream>
@@ -65,17 +67,9 @@ void ProcessorUsingBufferedFileRead::processLine(const std::string& line) {
 
     std::getline(ss, token, ',');
     //record.latitude = token.empty() ? 0.0f : std::stof(token);
-    try {
-        record.latitude = token.empty() ? 0.0f : std::stof(token);
-    } catch (const std::invalid_argument& e) {
-        record.latitude = 0.0f;
-    }
+    record.latitude = NumericParser::toFloat(token);
     std::getline(ss, token, ',');
-    try {
-        record.longitude = token.empty() ? 0.0f : std::stof(token);
-    } catch (const std::invalid_argument& e) {
-        record.longitude = 0.0f;
-    }
+    record.longitude = NumericParser::toFloat(token);
     //record.longitude = token.empty() ? 0.0f : std::stof(token);
 
     std::getline(ss, record.location, ',');
@@ -84,18 +78,10 @@ void ProcessorUsingBufferedFileRead::processLine(const std::string& line) {
     std::getline(ss, record.off_street_name, ',');
 
     std::getline(ss, token, ',');
-    try {
-        record.persons_injured = token.empty() ? 0 : std::stoi(token);
-    } catch (...) {
-        record.persons_injured = 0;
-    }
+    record.persons_injured = NumericParser::toInt(token);
 
     std::getline(ss, token, ',');
-    try {
-        record.persons_killed = token.empty() ? 0 : std::stoi(token);
-    } catch (...) {
-        record.persons_killed = 0;
-    }
+    record.persons_killed = NumericParser::toInt(token);
 
     std::getline(ss, record.contributing_factor_vehicle_1, ',');
     std::getline(ss, record.contributing_factor_vehicle_2, ',');
@@ -104,11 +90,7 @@ void ProcessorUsingBufferedFileRead::processLine(const std::string& line) {
     std::getline(ss, record.contributing_factor_vehicle_5, ',');
 
     std::getline(ss, token, ',');
-    try {
-        record.collision_id = token.empty() ? 0 : std::stol(token);
-    } catch (...) {
-        record.collision_id = 0;
-    }
+    record.collision_id = NumericParser::toInt<long>(token);
 
     std::getline(ss, record.vehicle_type_code_1, ',');
     std::getline(ss, record.vehicle_type_code_2, ',');
@@ -178,14 +160,10 @@ int ProcessorUsingBufferedFileRead::getCrashesByInjuryCountRange(int min_injurie
 int ProcessorUsingBufferedFileRead::getCrashesByLocationRange(float lat, float lon, float radius)  {
     auto start = std::chrono::high_resolution_clock::now();
     int crash_count = 0;
-    float radius_squared = radius * radius; // Precompute squared radius
+    const GeoCircle circle = GeoDistance::circle(lat, lon, radius); // Bounding box and km scale, once
 
     for (const auto& record : records) {
-        float d_lat = record.latitude - lat;
-        float d_lon = record.longitude - lon;
-        float dist_squared = d_lat * d_lat + d_lon * d_lon; // Squared distance calculation
-
-        if (dist_squared <= radius_squared) {
+        if (GeoDistance::contains(circle, record.latitude, record.longitude)) {
             crash_count++;
         }
     }
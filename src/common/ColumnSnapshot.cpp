@@ -0,0 +1,302 @@
+#include "ColumnSnapshot.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <omp.h>
+
+struct ColumnSnapshot::Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t file_size;
+    uint64_t rows;
+    uint64_t source_size;
+    int64_t source_mtime;
+    uint32_t column_count;
+    uint32_t reserved[3];
+};
+
+struct ColumnSnapshot::ColumnEntry {
+    uint32_t column;
+    uint32_t encoding;
+    uint32_t value_width;
+    uint32_t reserved;
+    uint64_t values_offset;
+    uint64_t values_size;
+    uint64_t heap_offset;
+    uint64_t heap_size;
+    uint64_t heap_entries;
+    uint64_t reserved2;
+};
+
+namespace {
+
+constexpr char kMagic[8] = {'C', 'R', 'A', 'S', 'H', 'S', 'N', 'P'};
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr uint64_t kAlignment = 64;
+
+uint64_t alignUp(uint64_t offset) {
+    return (offset + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+void writePadding(std::ofstream& out, uint64_t& offset) {
+    static const char zeros[kAlignment] = {};
+    uint64_t aligned = alignUp(offset);
+    out.write(zeros, std::streamsize(aligned - offset));
+    offset = aligned;
+}
+
+template <typename Code>
+bool codesBelow(const Code* codes, uint64_t rows, uint64_t limit) {
+    size_t invalid = 0;
+    #pragma omp parallel for reduction(+:invalid)
+    for (uint64_t row = 0; row < rows; row++) invalid += codes[row] >= limit;
+    return invalid == 0;
+}
+
+} // namespace
+
+bool SnapshotSource::of(const std::string& filename, SnapshotSource& source) {
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(filename, error);
+    if (error) return false;
+    auto mtime = std::filesystem::last_write_time(filename, error);
+    if (error) return false;
+    source.size = size;
+    source.mtime = int64_t(mtime.time_since_epoch().count());
+    return true;
+}
+
+void ColumnSnapshot::Writer::addText(CrashColumn column, const StringColumn& text) {
+    PendingColumn pending{column, Encoding::Text, sizeof(uint64_t), nullptr, 0, text.size()};
+    pending.owned_values.reserve(text.size());
+    for (size_t row = 0; row < text.size(); row++) {
+        std::string_view value = text[row];
+        pending.owned_values.push_back(StringColumn::packRef(pending.heap.size(), value.size()));
+        pending.heap.append(value);
+    }
+    pending.values = pending.owned_values.data();
+    pending.values_size = pending.owned_values.size() * sizeof(uint64_t);
+    columns.push_back(std::move(pending));
+}
+
+void ColumnSnapshot::Writer::addDictionary(CrashColumn column, const DictionaryColumn& dictionary) {
+    PendingColumn pending{column, Encoding::Dictionary, uint32_t(dictionary.codeWidth()), dictionary.codeData(),
+                          dictionary.size() * dictionary.codeWidth(), dictionary.size()};
+    const std::vector<std::string>& values = dictionary.dictionary();
+    std::vector<uint64_t> offsets(values.size() + 1, 0);
+    for (size_t i = 0; i < values.size(); i++) offsets[i + 1] = offsets[i] + values[i].size();
+
+    pending.heap.assign(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+    for (const std::string& value : values) pending.heap.append(value);
+    pending.heap_entries = values.size();
+    columns.push_back(std::move(pending));
+}
+
+bool ColumnSnapshot::Writer::write(const std::string& filename, const SnapshotSource& source) const {
+    size_t rows = columns.empty() ? 0 : columns[0].rows;
+    for (const PendingColumn& pending : columns) {
+        if (pending.rows != rows) {
+            std::cerr << "Error writing snapshot: columns have different row counts" << std::endl;
+            return false;
+        }
+    }
+
+    // Lay out the blobs behind the header and directory
+    std::vector<ColumnEntry> directory(columns.size());
+    uint64_t offset = alignUp(sizeof(Header) + directory.size() * sizeof(ColumnEntry));
+    for (size_t i = 0; i < columns.size(); i++) {
+        const PendingColumn& pending = columns[i];
+        ColumnEntry& entry = directory[i];
+        entry = {};
+        entry.column = uint32_t(pending.column);
+        entry.encoding = uint32_t(pending.encoding);
+        entry.value_width = pending.value_width;
+        entry.values_offset = offset;
+        entry.values_size = pending.values_size;
+        offset = alignUp(offset + entry.values_size);
+        entry.heap_offset = offset;
+        entry.heap_size = pending.heap.size();
+        entry.heap_entries = pending.heap_entries;
+        offset = alignUp(offset + entry.heap_size);
+    }
+
+    Header header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byte_order = kByteOrderMark;
+    header.file_size = offset;
+    header.rows = rows;
+    header.source_size = source.size;
+    header.source_mtime = source.mtime;
+    header.column_count = uint32_t(columns.size());
+
+    const std::string temporary = filename + ".tmp";
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Error creating snapshot: " << temporary << std::endl;
+        return false;
+    }
+
+    uint64_t written = 0;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(directory.data()), std::streamsize(directory.size() * sizeof(ColumnEntry)));
+    written = sizeof(header) + directory.size() * sizeof(ColumnEntry);
+    for (const PendingColumn& pending : columns) {
+        writePadding(out, written);
+        out.write(static_cast<const char*>(pending.values), std::streamsize(pending.values_size));
+        written += pending.values_size;
+        writePadding(out, written);
+        out.write(pending.heap.data(), std::streamsize(pending.heap.size()));
+        written += pending.heap.size();
+    }
+    writePadding(out, written);
+    out.close();
+
+    std::error_code error;
+    if (!out || written != header.file_size) {
+        std::cerr << "Error writing snapshot: " << temporary << std::endl;
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    std::filesystem::rename(temporary, filename, error);
+    if (error) {
+        std::cerr << "Error renaming snapshot into place: " << error.message() << std::endl;
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+bool ColumnSnapshot::open(const std::string& filename, const SnapshotSource& source) {
+    header = nullptr;
+    directory = nullptr;
+
+    std::error_code error;
+    if (!std::filesystem::exists(filename, error)) {
+        std::cout << "No snapshot at " << filename << " yet\n";
+        return false;
+    }
+    if (!mapping.open(filename)) return false;
+
+    const char* base = mapping.data();
+    const Header* candidate = reinterpret_cast<const Header*>(base);
+    if (mapping.size() < sizeof(Header) || std::memcmp(candidate->magic, kMagic, sizeof(kMagic)) != 0 ||
+        candidate->byte_order != kByteOrderMark) {
+        std::cout << "Ignoring snapshot " << filename << ": not a snapshot file\n";
+        mapping.close();
+        return false;
+    }
+    if (candidate->version != kVersion) {
+        std::cout << "Ignoring snapshot " << filename << ": format version " << candidate->version
+                  << ", expected " << kVersion << "\n";
+        mapping.close();
+        return false;
+    }
+    if (candidate->source_size != source.size || candidate->source_mtime != source.mtime) {
+        std::cout << "Ignoring snapshot " << filename << ": the CSV changed since it was written\n";
+        mapping.close();
+        return false;
+    }
+
+    // Every blob must lie aligned inside the file and match the row count, and every row's
+    // text or dictionary code must point inside its heap
+    bool valid = candidate->file_size == mapping.size() &&
+                 sizeof(Header) + uint64_t(candidate->column_count) * sizeof(ColumnEntry) <= mapping.size();
+    const ColumnEntry* entries = reinterpret_cast<const ColumnEntry*>(base + sizeof(Header));
+    for (uint32_t i = 0; valid && i < candidate->column_count; i++) {
+        const ColumnEntry& entry = entries[i];
+        valid = entry.column < uint32_t(CrashColumn::Count) && entry.value_width > 0 &&
+                entry.values_offset % kAlignment == 0 && entry.heap_offset % kAlignment == 0 &&
+                entry.values_offset <= mapping.size() && entry.values_size <= mapping.size() - entry.values_offset &&
+                entry.heap_offset <= mapping.size() && entry.heap_size <= mapping.size() - entry.heap_offset &&
+                entry.values_size / entry.value_width == candidate->rows &&
+                entry.values_size == candidate->rows * entry.value_width &&
+                contentsInBounds(base, entry, candidate->rows);
+    }
+    if (!valid) {
+        std::cout << "Ignoring snapshot " << filename << ": truncated or corrupt\n";
+        mapping.close();
+        return false;
+    }
+
+    header = candidate;
+    directory = entries;
+    return true;
+}
+
+size_t ColumnSnapshot::rows() const {
+    return header ? size_t(header->rows) : 0;
+}
+
+const ColumnSnapshot::ColumnEntry* ColumnSnapshot::entry(CrashColumn column) const {
+    if (!header) return nullptr;
+    for (uint32_t i = 0; i < header->column_count; i++) {
+        if (directory[i].column == uint32_t(column)) return &directory[i];
+    }
+    return nullptr;
+}
+
+bool ColumnSnapshot::contentsInBounds(const char* base, const ColumnEntry& entry, uint64_t rows) {
+    const char* values = base + entry.values_offset;
+    const char* heap = base + entry.heap_offset;
+    switch (Encoding(entry.encoding)) {
+        case Encoding::Fixed:
+            return true;
+        case Encoding::Text: {
+            if (entry.value_width != sizeof(uint64_t)) return false;
+            const uint64_t* refs = reinterpret_cast<const uint64_t*>(values);
+            size_t invalid = 0;
+            #pragma omp parallel for reduction(+:invalid)
+            for (uint64_t row = 0; row < rows; row++) invalid += StringColumn::refEnd(refs[row]) > entry.heap_size;
+            return invalid == 0;
+        }
+        case Encoding::Dictionary: {
+            // Offsets rise from 0 to at most the string bytes behind them
+            if (entry.heap_entries >= entry.heap_size / sizeof(uint64_t)) return false;
+            const uint64_t* offsets = reinterpret_cast<const uint64_t*>(heap);
+            const uint64_t bytes = entry.heap_size - (entry.heap_entries + 1) * sizeof(uint64_t);
+            if (offsets[0] != 0 || offsets[entry.heap_entries] > bytes) return false;
+            for (uint64_t i = 0; i < entry.heap_entries; i++) {
+                if (offsets[i] > offsets[i + 1]) return false;
+            }
+            switch (entry.value_width) {
+                case 1: return codesBelow(reinterpret_cast<const uint8_t*>(values), rows, entry.heap_entries);
+                case 2: return codesBelow(reinterpret_cast<const uint16_t*>(values), rows, entry.heap_entries);
+                case 4: return codesBelow(reinterpret_cast<const uint32_t*>(values), rows, entry.heap_entries);
+                default: return false;
+            }
+        }
+    }
+    return false;
+}
+
+const void* ColumnSnapshot::fixedValues(CrashColumn column, size_t width) const {
+    const ColumnEntry* found = entry(column);
+    if (!found || found->encoding != uint32_t(Encoding::Fixed) || found->value_width != width) return nullptr;
+    return mapping.data() + found->values_offset;
+}
+
+StringColumn ColumnSnapshot::readText(CrashColumn column) const {
+    const ColumnEntry* found = entry(column);
+    if (!found || found->encoding != uint32_t(Encoding::Text)) return StringColumn();
+    return StringColumn::fromRefs(mapping.data() + found->heap_offset,
+                                  reinterpret_cast<const uint64_t*>(mapping.data() + found->values_offset), rows());
+}
+
+DictionaryColumn ColumnSnapshot::readDictionary(CrashColumn column) const {
+    const ColumnEntry* found = entry(column);
+    if (!found || found->encoding != uint32_t(Encoding::Dictionary)) return DictionaryColumn();
+
+    const char* heap = mapping.data() + found->heap_offset;
+    const uint64_t* offsets = reinterpret_cast<const uint64_t*>(heap);
+    const char* bytes = heap + (found->heap_entries + 1) * sizeof(uint64_t);
+    std::vector<std::string> values;
+    values.reserve(found->heap_entries);
+    for (uint64_t i = 0; i < found->heap_entries; i++) {
+        values.emplace_back(bytes + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+    return DictionaryColumn::fromParts(std::move(values), mapping.data() + found->values_offset, rows(),
+                                       found->value_width);
+}
@@ -0,0 +1,115 @@
+#ifndef COLUMN_SNAPSHOT_H
+#define COLUMN_SNAPSHOT_H
+
+#include "CrashColumns.h"
+#include "DictionaryColumn.h"
+#include "MappedFile.h"
+#include "StringColumn.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Identity of the CSV a snapshot was built from. A snapshot is only used while the CSV
+// still has the same size and modification time.
+struct SnapshotSource {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+
+    // False if filename cannot be stat'ed
+    static bool of(const std::string& filename, SnapshotSource& source);
+    bool operator==(const SnapshotSource& other) const = default;
+};
+
+// Versioned binary snapshot of parsed crash columns, so a later run can skip the CSV.
+// Layout: a 64-byte header, a directory with one 64-byte entry per column, then one
+// 64-byte aligned blob per column part. Fixed-width columns store their values as is, text
+// columns packed (offset, length) refs plus a string heap, dictionary columns their codes
+// plus the dictionary strings. Integers are in native byte order; a byte-order mark rejects
+// snapshots from a machine with the other order.
+class ColumnSnapshot {
+private:
+    enum class Encoding : uint32_t {
+        Fixed = 1,       // values: one value_width-byte value per row
+        Text = 2,        // values: one packed StringColumn ref per row; heap: the bytes they point to
+        Dictionary = 3,  // values: one value_width-byte code per row; heap: (entries + 1) uint64 offsets, then bytes
+    };
+
+public:
+    // Bumped whenever the layout or the meaning of a stored column changes, so older snapshots
+    // are rebuilt from the CSV. 2: persons_injured is CSV field 10 (version 1 stored field 30).
+    static constexpr uint32_t kVersion = 2;
+
+    // Collects columns, then writes them in one pass. Fixed and dictionary columns are
+    // referenced, not copied, so they must outlive write().
+    class Writer {
+    public:
+        template <typename T>
+        void addFixed(CrashColumn column, const std::vector<T>& values) {
+            PendingColumn pending{column, Encoding::Fixed, sizeof(T), values.data(), values.size() * sizeof(T), values.size()};
+            columns.push_back(std::move(pending));
+        }
+        void addText(CrashColumn column, const StringColumn& text);
+        void addDictionary(CrashColumn column, const DictionaryColumn& dictionary);
+
+        // Writes a temporary file next to filename and renames it into place. Prints the
+        // error and returns false on failure or if the columns disagree on their row count.
+        bool write(const std::string& filename, const SnapshotSource& source) const;
+
+    private:
+        struct PendingColumn {
+            CrashColumn column;
+            Encoding encoding;
+            uint32_t value_width;
+            const void* values;
+            size_t values_size;
+            size_t rows;
+            std::vector<uint64_t> owned_values = {};  // text refs, rebased onto the heap
+            std::string heap = {};
+            uint64_t heap_entries = 0;
+        };
+        std::vector<PendingColumn> columns;
+    };
+
+    // Maps filename and checks it was written for source by this version. Prints why and
+    // returns false if it is missing, stale or malformed.
+    bool open(const std::string& filename, const SnapshotSource& source);
+
+    [[nodiscard]] size_t rows() const;
+    [[nodiscard]] bool contains(CrashColumn column) const { return entry(column) != nullptr; }
+
+    // Copies a fixed-width column; false if it is absent or stored with another width
+    template <typename T>
+    bool readFixed(CrashColumn column, std::vector<T>& values) const {
+        const void* data = fixedValues(column, sizeof(T));
+        if (!data) return false;
+        values.resize(rows());
+        if (!values.empty()) std::memcpy(values.data(), data, values.size() * sizeof(T));
+        return true;
+    }
+
+    // Zero-copy view of a text column; valid while the mapping lives (see releaseMapping)
+    [[nodiscard]] StringColumn readText(CrashColumn column) const;
+    [[nodiscard]] DictionaryColumn readDictionary(CrashColumn column) const;
+
+    // Hands over the mapping text columns point into
+    MappedFile releaseMapping() { return std::move(mapping); }
+
+private:
+    struct Header;
+    struct ColumnEntry;
+
+    // Whether every row of entry stays inside its heap: text refs end within it, dictionary
+    // codes name an entry and the dictionary offsets rise within it
+    static bool contentsInBounds(const char* base, const ColumnEntry& entry, uint64_t rows);
+    const ColumnEntry* entry(CrashColumn column) const;
+    const void* fixedValues(CrashColumn column, size_t width) const;
+
+    MappedFile mapping;
+    const Header* header = nullptr;
+    const ColumnEntry* directory = nullptr;
+};
+
+#endif // COLUMN_SNAPSHOT_H
@@ -0,0 +1,211 @@
+#include "CompressedIntColumn.h"
+
+#include <array>
+#include <bit>
+#include <limits>
+#include <utility>
+
+namespace {
+
+void putCode(uint64_t* words, size_t index, unsigned width, uint64_t code) {
+    const size_t bit = index * width;
+    words[bit / 64] |= code << (bit % 64);
+    if (bit % 64 + width > 64) words[bit / 64 + 1] |= code >> (64 - bit % 64);
+}
+
+uint64_t getCode(const uint64_t* words, size_t index, unsigned width) {
+    if (width == 0) return 0;
+    const size_t bit = index * width;
+    uint64_t code = words[bit / 64] >> (bit % 64);
+    if (bit % 64 + width > 64) code |= words[bit / 64 + 1] << (64 - bit % 64);
+    return width == 64 ? code : code & ((uint64_t(1) << width) - 1);
+}
+
+// Counts codes with code - low <= span in groups of 64 codes. 64 codes of W bits fill exactly
+// W words, so with W known at compile time every shift and word index in a group is a constant.
+template <unsigned W>
+size_t countGroupsInRange(const uint64_t* words, size_t groups, uint64_t low, uint64_t span) {
+    if constexpr (W == 0) {
+        return (0 - low) <= span ? groups * 64 : 0;
+    } else {
+        constexpr uint64_t mask = W == 64 ? ~uint64_t(0) : (uint64_t(1) << W) - 1;
+        size_t count = 0;
+        for (size_t group = 0; group < groups; group++, words += W) {
+            // Fully unrolled, the group is straight-line code with no word-boundary branches
+            #pragma GCC unroll 64
+            for (unsigned i = 0; i < 64; i++) {
+                const unsigned bit = i * W;
+                uint64_t code = words[bit / 64] >> (bit % 64);
+                if (bit % 64 + W > 64) code |= words[bit / 64 + 1] << (64 - bit % 64);
+                count += ((code & mask) - low) <= span;
+            }
+        }
+        return count;
+    }
+}
+
+using CountGroupsFn = size_t (*)(const uint64_t*, size_t, uint64_t, uint64_t);
+
+template <size_t... Widths>
+constexpr std::array<CountGroupsFn, sizeof...(Widths)> makeCountGroupsTable(std::index_sequence<Widths...>) {
+    return {countGroupsInRange<unsigned(Widths)>...};
+}
+
+// Indexed by bit width, 0..64
+constexpr auto kCountGroups = makeCountGroupsTable(std::make_index_sequence<65>());
+
+} // namespace
+
+void CompressedIntColumn::appendBlock(const int64_t* values, size_t rows) {
+    Block block = {};
+    block.rows = uint32_t(rows);
+    block.word_offset = words.size();
+    block.min = block.max = values[0];
+    for (size_t i = 1; i < rows; i++) {
+        block.min = std::min(block.min, values[i]);
+        block.max = std::max(block.max, values[i]);
+    }
+    block.reference = block.min;
+    const unsigned reference_width = unsigned(std::bit_width(uint64_t(block.max) - uint64_t(block.min)));
+    block.codec = reference_width == 0 ? Codec::Constant : Codec::FrameOfReference;
+    block.bit_width = uint8_t(reference_width);
+
+    // Neighbour differences are bounded by the block range, so below 63 bits they fit in int64
+    if (reference_width > 1 && reference_width < 63) {
+        int64_t min_delta = std::numeric_limits<int64_t>::max();
+        int64_t max_delta = std::numeric_limits<int64_t>::min();
+        for (size_t i = 1; i < rows; i++) {
+            const int64_t delta = values[i] - values[i - 1];
+            min_delta = std::min(min_delta, delta);
+            max_delta = std::max(max_delta, delta);
+        }
+        const unsigned delta_width = unsigned(std::bit_width(uint64_t(max_delta) - uint64_t(min_delta)));
+        if (delta_width < reference_width) {
+            block.codec = Codec::Delta;
+            block.bit_width = uint8_t(delta_width);
+            block.reference = values[0];
+            block.delta_base = min_delta;
+        }
+    }
+
+    if (block.bit_width > 0) {
+        words.resize(words.size() + (rows * block.bit_width + 63) / 64, 0);
+        uint64_t* packed = words.data() + block.word_offset;
+        for (size_t i = 0; i < rows; i++) {
+            uint64_t code = 0;
+            if (block.codec == Codec::FrameOfReference) {
+                code = uint64_t(values[i]) - uint64_t(block.min);
+            } else if (i > 0) {
+                code = uint64_t(values[i] - values[i - 1]) - uint64_t(block.delta_base);
+            }
+            putCode(packed, i, block.bit_width, code);
+        }
+    }
+
+    blocks.push_back(block);
+    row_count += rows;
+}
+
+void CompressedIntColumn::decodeBlock(size_t index, int64_t* values) const {
+    const Block& block = blocks[index];
+    const uint64_t* packed = words.data() + block.word_offset;
+    switch (block.codec) {
+        case Codec::Constant:
+            std::fill(values, values + block.rows, block.min);
+            break;
+        case Codec::FrameOfReference:
+            for (size_t i = 0; i < block.rows; i++) {
+                values[i] = int64_t(uint64_t(block.min) + getCode(packed, i, block.bit_width));
+            }
+            break;
+        case Codec::Delta: {
+            uint64_t value = uint64_t(block.reference);
+            values[0] = block.reference;
+            for (size_t i = 1; i < block.rows; i++) {
+                value += getCode(packed, i, block.bit_width) + uint64_t(block.delta_base);
+                values[i] = int64_t(value);
+            }
+            break;
+        }
+    }
+}
+
+int64_t CompressedIntColumn::value(size_t row) const {
+    const Block& block = blocks[row / kBlockRows];
+    const size_t index = row % kBlockRows;
+    const uint64_t* packed = words.data() + block.word_offset;
+    switch (block.codec) {
+        case Codec::Constant:
+            return block.min;
+        case Codec::FrameOfReference:
+            return int64_t(uint64_t(block.min) + getCode(packed, index, block.bit_width));
+        case Codec::Delta:
+            break;
+    }
+    uint64_t value = uint64_t(block.reference);
+    for (size_t i = 1; i <= index; i++) {
+        value += getCode(packed, i, block.bit_width) + uint64_t(block.delta_base);
+    }
+    return int64_t(value);
+}
+
+size_t CompressedIntColumn::countBlockInRange(size_t index, int64_t low, int64_t high) const {
+    const Block& block = blocks[index];
+    switch (matchZone(block.min, block.max, low, high)) {
+        case ZoneMatch::None: return 0;
+        case ZoneMatch::All: return block.rows;
+        case ZoneMatch::Some: break;
+    }
+
+    // low <= v <= high  <=>  v - low <= high - low in unsigned arithmetic
+    const uint64_t* packed = words.data() + block.word_offset;
+    if (block.codec == Codec::FrameOfReference) {
+        const uint64_t code_low = uint64_t(std::max(low, block.min)) - uint64_t(block.min);
+        const uint64_t code_span = uint64_t(std::min(high, block.max)) - uint64_t(std::max(low, block.min));
+        const size_t groups = block.rows / 64;
+        size_t count = kCountGroups[block.bit_width](packed, groups, code_low, code_span);
+        for (size_t i = groups * 64; i < block.rows; i++) {
+            count += (getCode(packed, i, block.bit_width) - code_low) <= code_span;
+        }
+        return count;
+    }
+
+    // Delta: a running sum over the packed differences
+    const uint64_t span = uint64_t(high) - uint64_t(low);
+    uint64_t value = uint64_t(block.reference);
+    size_t count = (value - uint64_t(low)) <= span;
+    for (size_t i = 1; i < block.rows; i++) {
+        value += getCode(packed, i, block.bit_width) + uint64_t(block.delta_base);
+        count += (value - uint64_t(low)) <= span;
+    }
+    return count;
+}
+
+size_t CompressedIntColumn::countInRange(int64_t low, int64_t high) const {
+    size_t count = 0;
+    for (size_t b = 0; b < blocks.size(); b++) {
+        count += countBlockInRange(b, low, high);
+    }
+    return count;
+}
+
+size_t CompressedIntColumn::countInRange(int64_t low, int64_t high, ZoneScanStats& stats) const {
+    size_t count = 0, skipped = 0, full = 0;
+    #pragma omp parallel for reduction(+:count, skipped, full) schedule(static)
+    for (size_t b = 0; b < blocks.size(); b++) {
+        const ZoneMatch match = matchZone(blocks[b].min, blocks[b].max, low, high);
+        skipped += match == ZoneMatch::None;
+        full += match == ZoneMatch::All;
+        count += countBlockInRange(b, low, high);
+    }
+    stats = {blocks.size(), skipped, full};
+    return count;
+}
+
+size_t CompressedIntColumn::blockCount(Codec codec) const {
+    return size_t(std::count_if(blocks.begin(), blocks.end(), [&](const Block& block) { return block.codec == codec; }));
+}
+
+size_t CompressedIntColumn::memoryBytes() const {
+    return words.capacity() * sizeof(uint64_t) + blocks.capacity() * sizeof(Block);
+}
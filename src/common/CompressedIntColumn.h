@@ -0,0 +1,92 @@
+#ifndef COMPRESSED_INT_COLUMN_H
+#define COMPRESSED_INT_COLUMN_H
+
+#include "ZoneMap.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Integer column stored in blocks of kBlockRows values. Each block is encoded with whichever
+// codec is smallest for its own values:
+//   Constant          every value equals the block minimum; no payload
+//   FrameOfReference  value - block minimum, bit-packed at the width of the block's range
+//   Delta             (value - previous value) - smallest difference, bit-packed; suits
+//                     nearly sequential data such as collision ids
+// Range counts never decode to the value domain: a block entirely inside or outside the
+// range is answered from its min/max, and a frame-of-reference block translates the range
+// into code space and compares the packed codes directly.
+class CompressedIntColumn {
+public:
+    static constexpr size_t kBlockRows = 4096;
+
+    enum class Codec : uint8_t { Constant, FrameOfReference, Delta };
+
+    template <typename T>
+    static CompressedIntColumn encode(const std::vector<T>& values) {
+        CompressedIntColumn column;
+        std::vector<int64_t> block(std::min(kBlockRows, values.size()));
+        for (size_t first = 0; first < values.size(); first += kBlockRows) {
+            const size_t rows = std::min(kBlockRows, values.size() - first);
+            for (size_t i = 0; i < rows; i++) block[i] = int64_t(values[first + i]);
+            column.appendBlock(block.data(), rows);
+        }
+        column.words.shrink_to_fit();
+        column.blocks.shrink_to_fit();
+        return column;
+    }
+
+    [[nodiscard]] size_t size() const { return row_count; }
+    [[nodiscard]] bool empty() const { return row_count == 0; }
+    [[nodiscard]] size_t blockCount() const { return blocks.size(); }
+
+    // Value of one row; walks the block up to row for delta-coded blocks
+    [[nodiscard]] int64_t value(size_t row) const;
+
+    // All values, converted to T
+    template <typename T>
+    void decode(std::vector<T>& values) const {
+        values.resize(row_count);
+        std::vector<int64_t> block(kBlockRows);
+        for (size_t b = 0; b < blocks.size(); b++) {
+            decodeBlock(b, block.data());
+            for (size_t i = 0; i < blocks[b].rows; i++) values[b * kBlockRows + i] = T(block[i]);
+        }
+    }
+
+    // Rows of one block with low <= value <= high; blocks are independent, so callers can
+    // spread them over threads
+    [[nodiscard]] size_t countBlockInRange(size_t block, int64_t low, int64_t high) const;
+    // Rows with low <= value <= high, single-threaded
+    [[nodiscard]] size_t countInRange(int64_t low, int64_t high) const;
+    // Same, with blocks spread over OpenMP threads; reports the blocks skipped and matched in
+    // full from their min/max
+    [[nodiscard]] size_t countInRange(int64_t low, int64_t high, ZoneScanStats& stats) const;
+
+    // Blocks stored with codec
+    [[nodiscard]] size_t blockCount(Codec codec) const;
+    // Heap bytes of the packed words and block headers
+    [[nodiscard]] size_t memoryBytes() const;
+
+private:
+    struct Block {
+        int64_t min;
+        int64_t max;
+        int64_t reference;   // FrameOfReference: min; Delta: the first value
+        int64_t delta_base;  // Delta: smallest difference between neighbours
+        size_t word_offset;  // first packed word in words
+        uint32_t rows;
+        Codec codec;
+        uint8_t bit_width;
+    };
+
+    void appendBlock(const int64_t* values, size_t rows);
+    void decodeBlock(size_t block, int64_t* values) const;
+
+    std::vector<Block> blocks;
+    std::vector<uint64_t> words;  // codes of all blocks, bit_width bits each, least significant bits first
+    size_t row_count = 0;
+};
+
+#endif // COMPRESSED_INT_COLUMN_H
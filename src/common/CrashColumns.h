@@ -0,0 +1,116 @@
+#ifndef CRASH_COLUMNS_H
+#define CRASH_COLUMNS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+// Columns of the collisions CSV, in file order
+enum class CrashColumn : uint8_t {
+    CrashDate,
+    CrashTime,
+    Borough,
+    ZipCode,
+    Latitude,
+    Longitude,
+    Location,
+    OnStreetName,
+    CrossStreetName,
+    OffStreetName,
+    PersonsInjured,
+    PersonsKilled,
+    PedestriansInjured,
+    PedestriansKilled,
+    CyclistsInjured,
+    CyclistsKilled,
+    MotoristsInjured,
+    MotoristsKilled,
+    ContributingFactorVehicle1,
+    ContributingFactorVehicle2,
+    ContributingFactorVehicle3,
+    ContributingFactorVehicle4,
+    ContributingFactorVehicle5,
+    CollisionId,
+    VehicleTypeCode1,
+    VehicleTypeCode2,
+    VehicleTypeCode3,
+    VehicleTypeCode4,
+    VehicleTypeCode5,
+    VehicleTypeCode6,
+    Count
+};
+
+// Column name as used in messages, e.g. "persons_injured"
+constexpr const char* crashColumnName(CrashColumn column) {
+    constexpr const char* kNames[] = {
+        "crash_date", "crash_time", "borough", "zip_code", "latitude", "longitude", "location", "on_street_name",
+        "cross_street_name", "off_street_name", "persons_injured", "persons_killed", "pedestrians_injured",
+        "pedestrians_killed", "cyclists_injured", "cyclists_killed", "motorists_injured", "motorists_killed",
+        "contributing_factor_vehicle_1", "contributing_factor_vehicle_2", "contributing_factor_vehicle_3",
+        "contributing_factor_vehicle_4", "contributing_factor_vehicle_5", "collision_id", "vehicle_type_code_1",
+        "vehicle_type_code_2", "vehicle_type_code_3", "vehicle_type_code_4", "vehicle_type_code_5",
+        "vehicle_type_code_6"};
+    static_assert(sizeof(kNames) / sizeof(kNames[0]) == static_cast<size_t>(CrashColumn::Count));
+    return column < CrashColumn::Count ? kNames[static_cast<size_t>(column)] : "";
+}
+
+// Range queries exposed by ICrashDataProcessor
+enum class CrashQueryKind {
+    DateRange,
+    InjuryRange,
+    LocationRange
+};
+
+// Set of columns a loader materializes; everything else is skipped while parsing
+class CrashColumnSet {
+public:
+    constexpr CrashColumnSet() = default;
+    constexpr CrashColumnSet(std::initializer_list<CrashColumn> columns) {
+        for (CrashColumn column : columns) bits |= bit(column);
+    }
+
+    static constexpr CrashColumnSet all() {
+        CrashColumnSet set;
+        set.bits = bit(CrashColumn::Count) - 1;
+        return set;
+    }
+
+    // Columns read by the given queries
+    static constexpr CrashColumnSet forQueries(std::initializer_list<CrashQueryKind> queries) {
+        CrashColumnSet set;
+        for (CrashQueryKind query : queries) {
+            switch (query) {
+                case CrashQueryKind::DateRange: set.add(CrashColumn::CrashDate); break;
+                case CrashQueryKind::InjuryRange: set.add(CrashColumn::PersonsInjured); break;
+                case CrashQueryKind::LocationRange:
+                    set.add(CrashColumn::Latitude);
+                    set.add(CrashColumn::Longitude);
+                    break;
+            }
+        }
+        return set;
+    }
+
+    constexpr void add(CrashColumn column) { bits |= bit(column); }
+    [[nodiscard]] constexpr bool contains(CrashColumn column) const { return bits & bit(column); }
+    [[nodiscard]] constexpr bool isAll() const { return bits == all().bits; }
+    [[nodiscard]] constexpr size_t size() const {
+        size_t count = 0;
+        for (uint32_t remaining = bits; remaining; remaining &= remaining - 1) count++;
+        return count;
+    }
+
+    // One past the last CSV field the set needs, so a row can stop being split early
+    [[nodiscard]] constexpr size_t fieldLimit() const {
+        size_t limit = 0;
+        for (uint32_t remaining = bits; remaining; remaining >>= 1) limit++;
+        return limit;
+    }
+
+private:
+    uint32_t bits = 0;
+
+    static constexpr uint32_t bit(CrashColumn column) { return uint32_t(1) << static_cast<uint8_t>(column); }
+};
+
+#endif // CRASH_COLUMNS_H
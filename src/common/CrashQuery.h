@@ -0,0 +1,74 @@
+#ifndef CRASH_QUERY_H
+#define CRASH_QUERY_H
+
+#include "CrashColumns.h"
+#include "DateParser.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// A conjunction of column predicates, e.g.
+//   CrashQuery().equals(CrashColumn::Borough, "BROOKLYN").dateBetween("01/01/2023", "12/31/2023")
+//               .within(40.68, -73.97, 2)
+// Rows match when every predicate holds. The order predicates are added in does not matter:
+// the processor evaluates them most selective first.
+class CrashQuery {
+public:
+    enum class Kind {
+        DateRange,    // crash_date in [low, high], days since 1970-01-01
+        IntegerRange, // an integer column in [low, high]
+        Circle,       // latitude/longitude within radius_km of (lat, lon)
+        Equals        // a dictionary-encoded text column equal to value
+    };
+
+    struct Predicate {
+        Kind kind;
+        CrashColumn column;
+        int64_t low = 0, high = 0;
+        float lat = 0, lon = 0, radius_km = 0;
+        std::string value = {};  // Equals; the dates as given for DateRange
+    };
+
+    // Dates as MM/DD/YYYY; an unparsable date makes the query invalid
+    CrashQuery& dateBetween(const std::string& start_date, const std::string& end_date) {
+        const int32_t first = DateParser::parseDate(start_date);
+        const int32_t last = DateParser::parseDate(end_date);
+        valid_dates = valid_dates && first != DateParser::kInvalidDate && last != DateParser::kInvalidDate;
+        Predicate predicate{Kind::DateRange, CrashColumn::CrashDate, first, last};
+        predicate.value = start_date + " - " + end_date;
+        predicate_list.push_back(std::move(predicate));
+        return *this;
+    }
+
+    CrashQuery& between(CrashColumn column, int64_t low, int64_t high) {
+        predicate_list.push_back({Kind::IntegerRange, column, low, high});
+        return *this;
+    }
+
+    CrashQuery& within(float lat, float lon, float radius_km) {
+        Predicate predicate{Kind::Circle, CrashColumn::Latitude};
+        predicate.lat = lat;
+        predicate.lon = lon;
+        predicate.radius_km = radius_km;
+        predicate_list.push_back(std::move(predicate));
+        return *this;
+    }
+
+    CrashQuery& equals(CrashColumn column, std::string value) {
+        Predicate predicate{Kind::Equals, column};
+        predicate.value = std::move(value);
+        predicate_list.push_back(std::move(predicate));
+        return *this;
+    }
+
+    [[nodiscard]] const std::vector<Predicate>& predicates() const { return predicate_list; }
+    [[nodiscard]] bool valid() const { return valid_dates; }
+
+private:
+    std::vector<Predicate> predicate_list;
+    bool valid_dates = true;
+};
+
+#endif // CRASH_QUERY_H
@@ -0,0 +1,100 @@
+#include "DailyCounts.h"
+#include "DateParser.h"
+
+#include <algorithm>
+#include <omp.h>
+
+void DailyCounts::build(const std::vector<int32_t>& days, const DictionaryColumn* categories) {
+    const size_t category_count = categories && categories->size() == days.size() ? categories->dictionary().size() : 0;
+    series.assign(1 + category_count, {});
+    day_count = 0;
+
+    int32_t first = INT32_MAX, last = INT32_MIN;
+    #pragma omp parallel for reduction(min:first) reduction(max:last)
+    for (size_t i = 0; i < days.size(); i++) {
+        if (days[i] == DateParser::kInvalidDate) continue;
+        first = std::min(first, days[i]);
+        last = std::max(last, days[i]);
+    }
+    if (first > last) return;
+    start_day = first;
+    day_count = size_t(int64_t(last) - first) + 1;
+
+    // Per-thread histograms of every series, summed into entry d + 1 of each series
+    for (std::vector<uint32_t>& counts : series) counts.assign(day_count + 1, 0);
+    #pragma omp parallel
+    {
+        std::vector<uint32_t> local(series.size() * day_count, 0);
+        #pragma omp for schedule(static) nowait
+        for (size_t i = 0; i < days.size(); i++) {
+            if (days[i] == DateParser::kInvalidDate) continue;
+            const size_t day = size_t(days[i] - start_day);
+            local[day]++;
+            if (category_count > 0) local[(1 + categories->code(i)) * day_count + day]++;
+        }
+        #pragma omp critical
+        for (size_t s = 0; s < series.size(); s++) {
+            for (size_t day = 0; day < day_count; day++) series[s][day + 1] += local[s * day_count + day];
+        }
+    }
+
+    for (std::vector<uint32_t>& counts : series) {
+        for (size_t day = 0; day < day_count; day++) counts[day + 1] += counts[day];
+    }
+}
+
+void DailyCounts::grow(int32_t day) {
+    if (day_count == 0) {
+        start_day = day;
+        day_count = 1;
+        for (std::vector<uint32_t>& counts : series) counts.assign(2, 0);
+        return;
+    }
+    if (day < start_day) {
+        // No rows precede the new days, so their prefix entries are 0
+        const size_t added = size_t(int64_t(start_day) - day);
+        for (std::vector<uint32_t>& counts : series) counts.insert(counts.begin(), added, 0);
+        start_day = day;
+        day_count += added;
+    } else if (int64_t(day) - start_day >= int64_t(day_count)) {
+        const size_t added = size_t(int64_t(day) - start_day) + 1 - day_count;
+        for (std::vector<uint32_t>& counts : series) counts.insert(counts.end(), added, counts.back());
+        day_count += added;
+    }
+}
+
+void DailyCounts::add(int32_t day, uint32_t category) {
+    if (day == DateParser::kInvalidDate) return;
+    grow(day);
+    const size_t from = size_t(day - start_day) + 1;
+    for (size_t d = from; d <= day_count; d++) series[0][d]++;
+    if (1 + size_t(category) < series.size()) {
+        std::vector<uint32_t>& counts = series[1 + category];
+        for (size_t d = from; d <= day_count; d++) counts[d]++;
+    }
+}
+
+size_t DailyCounts::countSeries(size_t index, int32_t first_day, int32_t last_day) const {
+    if (day_count == 0 || first_day > last_day) return 0;
+    // Clamp to the span; ranges beyond it add no rows
+    const int64_t first = std::max<int64_t>(first_day, start_day) - start_day;
+    const int64_t last = std::min<int64_t>(last_day, int64_t(start_day) + int64_t(day_count) - 1) - start_day;
+    if (first > last) return 0;
+    const std::vector<uint32_t>& counts = series[index];
+    return counts[size_t(last) + 1] - counts[size_t(first)];
+}
+
+size_t DailyCounts::count(int32_t first_day, int32_t last_day) const {
+    return countSeries(0, first_day, last_day);
+}
+
+size_t DailyCounts::count(int32_t first_day, int32_t last_day, uint32_t category) const {
+    if (1 + size_t(category) >= series.size()) return 0;
+    return countSeries(1 + category, first_day, last_day);
+}
+
+size_t DailyCounts::memoryBytes() const {
+    size_t bytes = 0;
+    for (const std::vector<uint32_t>& counts : series) bytes += counts.capacity() * sizeof(uint32_t);
+    return bytes;
+}
@@ -0,0 +1,43 @@
+#ifndef DAILY_COUNTS_H
+#define DAILY_COUNTS_H
+
+#include "DictionaryColumn.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Rows per day over the span of a date column, stored as prefix sums: the rows of any date
+// range are two lookups. Optionally kept per category too (e.g. the codes of a borough
+// DictionaryColumn), for breakdowns of the same range. Days are days since 1970-01-01;
+// DateParser::kInvalidDate rows are not counted.
+class DailyCounts {
+public:
+    // Counts days, and per category when categories (one code per row) is given
+    void build(const std::vector<int32_t>& days, const DictionaryColumn* categories = nullptr);
+
+    // Counts one more row, e.g. an appended crash; grows the span when day lies outside it.
+    // Updates the prefix sums from day onwards, so it costs O(span) rather than O(1).
+    void add(int32_t day, uint32_t category = 0);
+
+    // Rows with first_day <= day <= last_day, in total or for one category
+    [[nodiscard]] size_t count(int32_t first_day, int32_t last_day) const;
+    [[nodiscard]] size_t count(int32_t first_day, int32_t last_day, uint32_t category) const;
+
+    [[nodiscard]] size_t categoryCount() const { return series.size() - 1; }
+    [[nodiscard]] bool empty() const { return day_count == 0; }
+    // Heap bytes of the prefix sums
+    [[nodiscard]] size_t memoryBytes() const;
+
+private:
+    // Series 0 holds all rows, series 1 + c category c. series[s][d] = rows of s dated before
+    // start_day + d, so each series has day_count + 1 entries.
+    void grow(int32_t day);
+    [[nodiscard]] size_t countSeries(size_t index, int32_t first_day, int32_t last_day) const;
+
+    std::vector<std::vector<uint32_t>> series = std::vector<std::vector<uint32_t>>(1);
+    int32_t start_day = 0;
+    size_t day_count = 0;
+};
+
+#endif // DAILY_COUNTS_H
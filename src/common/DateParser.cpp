@@ -0,0 +1,110 @@
+#include "DateParser.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define DATE_PARSER_X86 1
+#endif
+
+namespace {
+
+void parseDatesScalar(const std::string_view* texts, size_t count, int32_t* out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = DateParser::parseDate(texts[i]);
+    }
+}
+
+#if defined(DATE_PARSER_X86)
+bool isFixedWidthDate(std::string_view text) {
+    return text.size() == 10 && text[2] == '/' && text[5] == '/';
+}
+
+// Loads the 10 date bytes into the low lanes of a register, reading 16 bytes directly
+// unless that could cross into an unmapped page
+__attribute__((target("ssse3")))
+__m128i loadDate(std::string_view text) {
+    if ((reinterpret_cast<uintptr_t>(text.data()) & 4095) <= 4096 - 16) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data()));
+    }
+    alignas(16) char staged[16] = {};
+    std::memcpy(staged, text.data(), 10);
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(staged));
+}
+
+__attribute__((target("ssse3")))
+void parseDatesSsse3(const std::string_view* texts, size_t count, int32_t* out) {
+    // Gather the 8 digits of MM/DD/YYYY into lanes 0..7: M M D D Y Y Y Y
+    const __m128i gather_digits = _mm_setr_epi8(0, 1, 3, 4, 6, 7, 8, 9, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i ascii_zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    // Pairs of digits -> 16-bit MM, DD, YY (century), YY
+    const __m128i tens_and_ones = _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1);
+
+    size_t i = 0;
+    while (i < count) {
+        if (i + 1 >= count || !isFixedWidthDate(texts[i]) || !isFixedWidthDate(texts[i + 1])) {
+            out[i] = DateParser::parseDate(texts[i]);
+            i++;
+            continue;
+        }
+
+        const __m128i first = _mm_shuffle_epi8(loadDate(texts[i]), gather_digits);
+        const __m128i second = _mm_shuffle_epi8(loadDate(texts[i + 1]), gather_digits);
+        const __m128i digits = _mm_sub_epi8(_mm_unpacklo_epi64(first, second), ascii_zero);
+        const bool all_digits = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(digits, nine), nine)) == 0xFFFF;
+        if (!all_digits) {
+            out[i] = DateParser::parseDate(texts[i]);
+            out[i + 1] = DateParser::parseDate(texts[i + 1]);
+            i += 2;
+            continue;
+        }
+
+        alignas(16) uint16_t parts[8];
+        _mm_store_si128(reinterpret_cast<__m128i*>(parts), _mm_maddubs_epi16(digits, tens_and_ones));
+        out[i] = DateParser::makeDate(parts[2] * 100u + parts[3], parts[0], parts[1]);
+        out[i + 1] = DateParser::makeDate(parts[6] * 100u + parts[7], parts[4], parts[5]);
+        i += 2;
+    }
+}
+#endif
+
+using ParseDatesFn = void (*)(const std::string_view*, size_t, int32_t*);
+
+struct BatchParser {
+    ParseDatesFn parse;
+    const char* name;
+};
+
+BatchParser pickBatchParser() {
+#if defined(DATE_PARSER_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("ssse3")) return {parseDatesSsse3, "SSSE3"};
+#endif
+    return {parseDatesScalar, "scalar"};
+}
+
+const BatchParser& batchParser() {
+    static const BatchParser picked = pickBatchParser();
+    return picked;
+}
+
+} // namespace
+
+void DateParser::parseDates(const std::string_view* texts, size_t count, int32_t* out) {
+    batchParser().parse(texts, count, out);
+}
+
+std::string DateParser::formatDate(int32_t days) {
+    if (days == kInvalidDate) return {};
+    int32_t year = 0;
+    uint32_t month = 0, day = 0;
+    civilFromDays(days, year, month, day);
+    const char text[] = {char('0' + month / 10), char('0' + month % 10), '/',
+                         char('0' + day / 10), char('0' + day % 10), '/'};
+    return std::string(text, sizeof(text)) + std::to_string(year);
+}
+
+const char* DateParser::batchIsaName() {
+    return batchParser().name;
+}
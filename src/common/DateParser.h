@@ -0,0 +1,103 @@
+#ifndef DATE_PARSER_H
+#define DATE_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Fixed-format date and time parsing with integer arithmetic only: no streams, no locale,
+// no std::mktime (and so no timezone lock). Dates become days since 1970-01-01.
+class DateParser {
+public:
+    static constexpr int32_t kInvalidDate = INT32_MIN;
+    static constexpr uint16_t kInvalidTime = UINT16_MAX;
+
+    // Days since 1970-01-01 of a proleptic Gregorian date (Howard Hinnant's days_from_civil)
+    static constexpr int32_t daysFromCivil(int32_t year, uint32_t month, uint32_t day) {
+        year -= month <= 2;
+        const int32_t era = (year >= 0 ? year : year - 399) / 400;
+        const uint32_t year_of_era = uint32_t(year - era * 400);
+        const uint32_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const uint32_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+        return era * 146097 + int32_t(day_of_era) - 719468;
+    }
+
+    // Year, month and day of a day since 1970-01-01 (Howard Hinnant's civil_from_days)
+    static constexpr void civilFromDays(int32_t days, int32_t& year, uint32_t& month, uint32_t& day) {
+        days += 719468;
+        const int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const uint32_t day_of_era = uint32_t(days - era * 146097);
+        const uint32_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+        const uint32_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+        const uint32_t shifted_month = (5 * day_of_year + 2) / 153;  // March = 0
+        day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+        month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+        year = int32_t(year_of_era) + era * 400 + (month <= 2);
+    }
+
+    // Year of a day since 1970-01-01
+    static constexpr int32_t yearFromDays(int32_t days) {
+        int32_t year = 0;
+        uint32_t month = 0, day = 0;
+        civilFromDays(days, year, month, day);
+        return year;
+    }
+
+    // Days since epoch -> "MM/DD/YYYY", the format parseDate reads; "" for kInvalidDate
+    static std::string formatDate(int32_t days);
+
+    // "MM/DD/YYYY" (leading zeros optional) -> days since epoch, or kInvalidDate
+    static int32_t parseDate(std::string_view text) {
+        uint32_t month = 0, day = 0, year = 0;
+        size_t pos = 0;
+        if (!readNumber(text, pos, 2, month) || !skip(text, pos, '/') ||
+            !readNumber(text, pos, 2, day) || !skip(text, pos, '/') ||
+            !readNumber(text, pos, 4, year) || pos != text.size()) {
+            return kInvalidDate;
+        }
+        return makeDate(year, month, day);
+    }
+
+    // "H:MM" or "HH:MM" -> minutes since midnight, or kInvalidTime
+    static uint16_t parseTimeOfDay(std::string_view text) {
+        uint32_t hours = 0, minutes = 0;
+        size_t pos = 0;
+        if (!readNumber(text, pos, 2, hours) || !skip(text, pos, ':') ||
+            !readNumber(text, pos, 2, minutes) || pos != text.size() || hours > 23 || minutes > 59) {
+            return kInvalidTime;
+        }
+        return uint16_t(hours * 60 + minutes);
+    }
+
+    // Converts count dates at once. Zero-padded MM/DD/YYYY dates are decoded two per
+    // 128-bit register on CPUs with SSSE3; anything else goes through parseDate.
+    static void parseDates(const std::string_view* texts, size_t count, int32_t* out);
+
+    // Instruction set parseDates runs with
+    static const char* batchIsaName();
+
+    static int32_t makeDate(uint32_t year, uint32_t month, uint32_t day) {
+        if (month < 1 || month > 12 || day < 1 || day > 31) return kInvalidDate;
+        return daysFromCivil(int32_t(year), month, day);
+    }
+
+private:
+    static bool readNumber(std::string_view text, size_t& pos, size_t max_digits, uint32_t& value) {
+        size_t start = pos;
+        value = 0;
+        while (pos < text.size() && pos - start < max_digits && uint8_t(text[pos] - '0') <= 9) {
+            value = value * 10 + uint32_t(text[pos] - '0');
+            pos++;
+        }
+        return pos > start;
+    }
+
+    static bool skip(std::string_view text, size_t& pos, char expected) {
+        if (pos >= text.size() || text[pos] != expected) return false;
+        pos++;
+        return true;
+    }
+};
+
+#endif // DATE_PARSER_H
@@ -0,0 +1,147 @@
+#include "DictionaryColumn.h"
+
+#include <algorithm>
+#include <cstring>
+#include <omp.h>
+
+namespace {
+
+template <typename Code>
+void remapCodes(std::vector<Code>& codes, const std::vector<std::vector<uint32_t>>& local_codes,
+                const std::vector<std::vector<uint32_t>>& remap, const std::vector<size_t>& offsets) {
+    codes.resize(offsets.back());
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t b = 0; b < local_codes.size(); b++) {
+        const std::vector<uint32_t>& local = local_codes[b];
+        const std::vector<uint32_t>& to_global = remap[b];
+        Code* out = codes.data() + offsets[b];
+        for (size_t row = 0; row < local.size(); row++) {
+            out[row] = static_cast<Code>(to_global[local[row]]);
+        }
+    }
+}
+
+template <typename Code>
+void assignCodes(std::vector<Code>& out, const void* codes, size_t rows) {
+    out.resize(rows);
+    if (rows > 0) std::memcpy(out.data(), codes, rows * sizeof(Code));
+}
+
+size_t stringHeapBytes(const std::string& value) {
+    // Short strings live inside the std::string object itself
+    return value.size() > std::string().capacity() ? value.size() + 1 : 0;
+}
+
+} // namespace
+
+void DictionaryColumn::Builder::push_back(std::string_view value) {
+    if (last_code != UINT32_MAX && value == last_value) {
+        codes.push_back(last_code);
+        return;
+    }
+
+    auto it = index.find(value);
+    if (it == index.end()) {
+        it = index.emplace(std::string(value), uint32_t(values.size())).first;
+        values.emplace_back(value);
+    }
+    last_value = it->first;
+    last_code = it->second;
+    codes.push_back(last_code);
+}
+
+DictionaryColumn DictionaryColumn::merge(std::vector<Builder>& builders) {
+    DictionaryColumn column;
+
+    // Sorted union of the thread-local dictionaries
+    for (const Builder& builder : builders) {
+        column.values.insert(column.values.end(), builder.values.begin(), builder.values.end());
+    }
+    std::sort(column.values.begin(), column.values.end());
+    column.values.erase(std::unique(column.values.begin(), column.values.end()), column.values.end());
+
+    // Local code -> global code, per builder
+    std::vector<std::vector<uint32_t>> remap(builders.size());
+    std::vector<std::vector<uint32_t>> local_codes(builders.size());
+    std::vector<size_t> offsets(builders.size() + 1, 0);
+    for (size_t b = 0; b < builders.size(); b++) {
+        for (const std::string& value : builders[b].values) {
+            auto it = std::lower_bound(column.values.begin(), column.values.end(), value);
+            remap[b].push_back(uint32_t(it - column.values.begin()));
+        }
+        local_codes[b] = std::move(builders[b].codes);
+        offsets[b + 1] = offsets[b] + local_codes[b].size();
+        builders[b] = Builder();
+    }
+
+    column.row_count = offsets.back();
+    if (column.values.size() <= 256) {
+        column.code_width = 1;
+        remapCodes(column.codes8, local_codes, remap, offsets);
+    } else if (column.values.size() <= 65536) {
+        column.code_width = 2;
+        remapCodes(column.codes16, local_codes, remap, offsets);
+    } else {
+        column.code_width = 4;
+        remapCodes(column.codes32, local_codes, remap, offsets);
+    }
+    return column;
+}
+
+DictionaryColumn DictionaryColumn::fromParts(std::vector<std::string> dictionary, const void* codes, size_t rows,
+                                             size_t code_width) {
+    DictionaryColumn column;
+    column.values = std::move(dictionary);
+    column.row_count = rows;
+    column.code_width = code_width;
+    switch (code_width) {
+        case 1: assignCodes(column.codes8, codes, rows); break;
+        case 2: assignCodes(column.codes16, codes, rows); break;
+        default: assignCodes(column.codes32, codes, rows); break;
+    }
+    return column;
+}
+
+void DictionaryColumn::permute(const RowOrder& order) {
+    switch (code_width) {
+        case 1: applyRowOrder(codes8, order); break;
+        case 2: applyRowOrder(codes16, order); break;
+        default: applyRowOrder(codes32, order); break;
+    }
+}
+
+const void* DictionaryColumn::codeData() const {
+    switch (code_width) {
+        case 1: return codes8.data();
+        case 2: return codes16.data();
+        default: return codes32.data();
+    }
+}
+
+int64_t DictionaryColumn::findCode(std::string_view value) const {
+    auto it = std::lower_bound(values.begin(), values.end(), value,
+                               [](const std::string& entry, std::string_view key) { return entry < key; });
+    if (it == values.end() || *it != value) return -1;
+    return it - values.begin();
+}
+
+size_t DictionaryColumn::memoryBytes() const {
+    size_t bytes = codes8.capacity() + codes16.capacity() * sizeof(uint16_t) + codes32.capacity() * sizeof(uint32_t);
+    bytes += values.capacity() * sizeof(std::string);
+    for (const std::string& value : values) {
+        bytes += stringHeapBytes(value);
+    }
+    return bytes;
+}
+
+size_t DictionaryColumn::stringEquivalentBytes() const {
+    std::vector<size_t> rows_per_code(values.size(), 0);
+    for (size_t row = 0; row < row_count; row++) {
+        rows_per_code[code(row)]++;
+    }
+    size_t bytes = row_count * sizeof(std::string);
+    for (size_t c = 0; c < values.size(); c++) {
+        bytes += rows_per_code[c] * stringHeapBytes(values[c]);
+    }
+    return bytes;
+}
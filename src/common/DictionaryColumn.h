@@ -0,0 +1,87 @@
+#ifndef DICTIONARY_COLUMN_H
+#define DICTIONARY_COLUMN_H
+
+#include "RowOrder.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Low-cardinality text column: a sorted dictionary of distinct values plus one code per row.
+// Codes are uint8_t while the dictionary has at most 256 entries, uint16_t up to 65536 and
+// uint32_t beyond that. Sorted dictionaries keep codes in value order, so equality and range
+// filters on the text become integer compares.
+class DictionaryColumn {
+public:
+    // Thread-local side of a parallel load: a private dictionary and codes into it
+    class Builder {
+    public:
+        void push_back(std::string_view value);
+        [[nodiscard]] size_t size() const { return codes.size(); }
+
+    private:
+        friend class DictionaryColumn;
+
+        struct ViewHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
+        };
+
+        std::unordered_map<std::string, uint32_t, ViewHash, std::equal_to<>> index;
+        std::vector<std::string> values;
+        std::vector<uint32_t> codes;
+        std::string_view last_value;  // rows repeat values often, so remember the previous lookup
+        uint32_t last_code = UINT32_MAX;
+    };
+
+    // Concatenates the builders in order: merges their dictionaries, then remaps every
+    // thread's codes into its slice of the final column in parallel. Empties the builders.
+    static DictionaryColumn merge(std::vector<Builder>& builders);
+
+    // Rebuilds a column from a sorted dictionary and rows codes of code_width bytes each
+    static DictionaryColumn fromParts(std::vector<std::string> dictionary, const void* codes, size_t rows,
+                                      size_t code_width);
+
+    // Reorders the rows' codes; the dictionary is unchanged
+    void permute(const RowOrder& order);
+
+    [[nodiscard]] size_t size() const { return row_count; }
+    [[nodiscard]] bool empty() const { return row_count == 0; }
+
+    [[nodiscard]] uint32_t code(size_t row) const {
+        switch (code_width) {
+            case 1: return codes8[row];
+            case 2: return codes16[row];
+            default: return codes32[row];
+        }
+    }
+    [[nodiscard]] std::string_view operator[](size_t row) const { return values[code(row)]; }
+    [[nodiscard]] std::string materialize(size_t row) const { return values[code(row)]; }
+
+    [[nodiscard]] const std::vector<std::string>& dictionary() const { return values; }
+    // Code of value, or -1 if no row has it
+    [[nodiscard]] int64_t findCode(std::string_view value) const;
+    // Bytes per code: 1, 2 or 4
+    [[nodiscard]] size_t codeWidth() const { return code_width; }
+    // The size() codes, codeWidth() bytes each
+    [[nodiscard]] const void* codeData() const;
+
+    // Heap bytes held by codes and dictionary
+    [[nodiscard]] size_t memoryBytes() const;
+    // Heap bytes the same column would take as one std::string per row
+    [[nodiscard]] size_t stringEquivalentBytes() const;
+
+private:
+    std::vector<std::string> values;
+    std::vector<uint8_t> codes8;
+    std::vector<uint16_t> codes16;
+    std::vector<uint32_t> codes32;
+    size_t code_width = 1;
+    size_t row_count = 0;
+};
+
+#endif // DICTIONARY_COLUMN_H
@@ -0,0 +1,94 @@
+#include "FusedFilterScan.h"
+#include "RangeCount.h"
+
+#include <algorithm>
+#include <bit>
+#include <omp.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define FUSED_FILTER_SCAN_X86 1
+#endif
+
+namespace {
+
+constexpr size_t kBlockWords = FusedFilterScan::kBlockRows / 64;
+
+// Adds the set bits of each mask, and of the three ANDed, over words [0, words)
+inline void countMasks(const uint64_t* date_bits, const uint64_t* injury_bits, const uint64_t* location_bits,
+                       size_t words, CrashFilterCounts& counts) {
+    // Local sums: accumulating through counts would store to memory every word
+    size_t date = 0, injury = 0, location = 0, all = 0;
+    for (size_t word = 0; word < words; word++) {
+        date += size_t(std::popcount(date_bits[word]));
+        injury += size_t(std::popcount(injury_bits[word]));
+        location += size_t(std::popcount(location_bits[word]));
+        all += size_t(std::popcount(date_bits[word] & injury_bits[word] & location_bits[word]));
+    }
+    counts.date += date;
+    counts.injury += injury;
+    counts.location += location;
+    counts.all += all;
+}
+
+using CountMasksFn = void (*)(const uint64_t*, const uint64_t*, const uint64_t*, size_t, CrashFilterCounts&);
+
+#if defined(FUSED_FILTER_SCAN_X86)
+// The build targets baseline x86-64, where std::popcount is a bit-twiddling sequence; with
+// POPCNT it is one instruction
+__attribute__((target("popcnt")))
+void countMasksPopcnt(const uint64_t* date_bits, const uint64_t* injury_bits, const uint64_t* location_bits,
+                      size_t words, CrashFilterCounts& counts) {
+    countMasks(date_bits, injury_bits, location_bits, words, counts);
+}
+#endif
+
+CountMasksFn pickCountMasks() {
+#if defined(FUSED_FILTER_SCAN_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("popcnt")) return countMasksPopcnt;
+#endif
+    return countMasks;
+}
+
+// Adds the counts of rows [begin, end) of one block, begin a multiple of 64
+void countBlock(const int32_t* dates, const int* injured, const float* latitudes, const float* longitudes,
+                size_t begin, size_t end, const CrashFilters& filters, CrashFilterCounts& counts) {
+    static const CountMasksFn count_masks = pickCountMasks();
+    uint64_t date_bits[kBlockWords], injury_bits[kBlockWords], location_bits[kBlockWords];
+    const size_t rows = end - begin;
+    RangeCount::select(dates + begin, rows, filters.first_day, filters.last_day, date_bits);
+    RangeCount::select(injured + begin, rows, filters.min_injured, filters.max_injured, injury_bits);
+    GeoDistance::selectWithin(latitudes + begin, longitudes + begin, rows, filters.circle, location_bits);
+    count_masks(date_bits, injury_bits, location_bits, (rows + 63) / 64, counts);
+}
+
+} // namespace
+
+CrashFilterCounts FusedFilterScan::count(const int32_t* dates, const int* injured, const float* latitudes,
+                                         const float* longitudes, size_t rows, const CrashFilters& filters) {
+    CrashFilterCounts counts;
+    for (size_t begin = 0; begin < rows; begin += kBlockRows) {
+        countBlock(dates, injured, latitudes, longitudes, begin, std::min(rows, begin + kBlockRows), filters, counts);
+    }
+    return counts;
+}
+
+CrashFilterCounts FusedFilterScan::countColumns(const std::vector<int32_t>& dates, const std::vector<int>& injured,
+                                                const std::vector<float>& latitudes,
+                                                const std::vector<float>& longitudes, const CrashFilters& filters) {
+    const size_t rows = std::min({dates.size(), injured.size(), latitudes.size(), longitudes.size()});
+    const size_t blocks = (rows + kBlockRows - 1) / kBlockRows;
+    size_t date = 0, injury = 0, location = 0, all = 0;
+    #pragma omp parallel for schedule(static) reduction(+:date, injury, location, all)
+    for (size_t block = 0; block < blocks; block++) {
+        CrashFilterCounts counts;
+        const size_t begin = block * kBlockRows;
+        countBlock(dates.data(), injured.data(), latitudes.data(), longitudes.data(), begin,
+                   std::min(rows, begin + kBlockRows), filters, counts);
+        date += counts.date;
+        injury += counts.injury;
+        location += counts.location;
+        all += counts.all;
+    }
+    return {date, injury, location, all};
+}
@@ -0,0 +1,44 @@
+#ifndef FUSED_FILTER_SCAN_H
+#define FUSED_FILTER_SCAN_H
+
+#include "GeoDistance.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The date, injury and location filters of one dashboard query
+struct CrashFilters {
+    int32_t first_day = 0, last_day = -1;  // days since 1970-01-01
+    int min_injured = 0, max_injured = -1;
+    GeoCircle circle;
+};
+
+// Rows passing each filter on its own, and all three together
+struct CrashFilterCounts {
+    size_t date = 0;
+    size_t injury = 0;
+    size_t location = 0;
+    size_t all = 0;
+};
+
+// Evaluates CrashFilters over the date, injury and lat/lon columns in one pass. Rows go in
+// kBlockRows blocks (16 bytes a row, 64 KB a block, well inside L2): each block runs the
+// RangeCount and GeoDistance select kernels into bit masks while its values are cached, then
+// popcounts the masks alone and ANDed. Every column is read once, where separate counts plus
+// a combined pass read each twice.
+class FusedFilterScan {
+public:
+    static constexpr size_t kBlockRows = 4096;
+
+    // Rows [0, rows), single-threaded
+    static CrashFilterCounts count(const int32_t* dates, const int* injured, const float* latitudes,
+                                   const float* longitudes, size_t rows, const CrashFilters& filters);
+
+    // Whole columns of equal length, blocks split across OpenMP threads
+    static CrashFilterCounts countColumns(const std::vector<int32_t>& dates, const std::vector<int>& injured,
+                                          const std::vector<float>& latitudes, const std::vector<float>& longitudes,
+                                          const CrashFilters& filters);
+};
+
+#endif // FUSED_FILTER_SCAN_H
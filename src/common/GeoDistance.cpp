@@ -0,0 +1,266 @@
+#include "GeoDistance.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <omp.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define GEO_DISTANCE_X86 1
+#endif
+
+namespace {
+
+// The bounding box is widened by this much (relatively, plus ~1 m) so float rounding in the
+// distance test can never accept a point the box rejected
+constexpr double kBoxMargin = 1e-4;
+constexpr double kBoxSlackDegrees = 1e-5;
+
+constexpr size_t kChunkRows = 16384;
+
+size_t countWithinScalar(const float* latitudes, const float* longitudes, size_t count, const GeoCircle& circle) {
+    size_t matches = 0;
+    for (size_t i = 0; i < count; i++) matches += GeoDistance::contains(circle, latitudes[i], longitudes[i]);
+    return matches;
+}
+
+// Bits of the points [first, first + 64) that exist, first being a multiple of 64
+uint64_t selectScalar(const float* latitudes, const float* longitudes, size_t first, size_t count,
+                      const GeoCircle& circle) {
+    const size_t end = std::min(count, first + 64);
+    uint64_t bits = 0;
+    for (size_t i = first; i < end; i++) {
+        bits |= uint64_t(GeoDistance::contains(circle, latitudes[i], longitudes[i])) << (i - first);
+    }
+    return bits;
+}
+
+void selectWithinScalar(const float* latitudes, const float* longitudes, size_t count, const GeoCircle& circle,
+                        uint64_t* words) {
+    for (size_t word = 0; word * 64 < count; word++) {
+        words[word] = selectScalar(latitudes, longitudes, word * 64, count, circle);
+    }
+}
+
+#if defined(GEO_DISTANCE_X86)
+// match(lat, lon) returns one bit per lane (lane i -> bit i) for the kLanes points there. Same
+// operations in the same order as GeoDistance::contains (no FMA), so every ISA gives the same
+// answer for points on the boundary. Vectors with no point in the bounding box return before
+// any distance is computed.
+struct Avx2CircleMatcher {
+    static constexpr size_t kLanes = 8;
+    __m256 min_lat, max_lat, min_lon, max_lon, centre_lat, centre_lon, lon_scale, slope, radius_squared;
+
+    __attribute__((target("avx2"))) explicit Avx2CircleMatcher(const GeoCircle& circle)
+        : min_lat(_mm256_set1_ps(circle.min_lat)), max_lat(_mm256_set1_ps(circle.max_lat)),
+          min_lon(_mm256_set1_ps(circle.min_lon)), max_lon(_mm256_set1_ps(circle.max_lon)),
+          centre_lat(_mm256_set1_ps(circle.lat)), centre_lon(_mm256_set1_ps(circle.lon)),
+          lon_scale(_mm256_set1_ps(circle.lon_scale)), slope(_mm256_set1_ps(circle.lon_scale_slope)),
+          radius_squared(_mm256_set1_ps(circle.radius_squared)) {}
+
+    __attribute__((target("avx2"))) uint64_t match(const float* latitudes, const float* longitudes) const {
+        const __m256 lat = _mm256_loadu_ps(latitudes);
+        const __m256 lon = _mm256_loadu_ps(longitudes);
+        const __m256 in_box = _mm256_and_ps(
+            _mm256_and_ps(_mm256_cmp_ps(lat, min_lat, _CMP_GE_OQ), _mm256_cmp_ps(lat, max_lat, _CMP_LE_OQ)),
+            _mm256_and_ps(_mm256_cmp_ps(lon, min_lon, _CMP_GE_OQ), _mm256_cmp_ps(lon, max_lon, _CMP_LE_OQ)));
+        const int box_bits = _mm256_movemask_ps(in_box);
+        if (box_bits == 0) return 0;
+
+        const __m256 dy = _mm256_sub_ps(lat, centre_lat);
+        const __m256 scale = _mm256_add_ps(lon_scale, _mm256_mul_ps(slope, dy));
+        const __m256 dx = _mm256_mul_ps(_mm256_sub_ps(lon, centre_lon), scale);
+        const __m256 distance_squared = _mm256_add_ps(_mm256_mul_ps(dy, dy), _mm256_mul_ps(dx, dx));
+        return uint64_t(box_bits & _mm256_movemask_ps(_mm256_cmp_ps(distance_squared, radius_squared, _CMP_LE_OQ)));
+    }
+};
+
+struct Avx512CircleMatcher {
+    static constexpr size_t kLanes = 16;
+    __m512 min_lat, max_lat, min_lon, max_lon, centre_lat, centre_lon, lon_scale, slope, radius_squared;
+
+    __attribute__((target("avx512f"))) explicit Avx512CircleMatcher(const GeoCircle& circle)
+        : min_lat(_mm512_set1_ps(circle.min_lat)), max_lat(_mm512_set1_ps(circle.max_lat)),
+          min_lon(_mm512_set1_ps(circle.min_lon)), max_lon(_mm512_set1_ps(circle.max_lon)),
+          centre_lat(_mm512_set1_ps(circle.lat)), centre_lon(_mm512_set1_ps(circle.lon)),
+          lon_scale(_mm512_set1_ps(circle.lon_scale)), slope(_mm512_set1_ps(circle.lon_scale_slope)),
+          radius_squared(_mm512_set1_ps(circle.radius_squared)) {}
+
+    __attribute__((target("avx512f"))) uint64_t match(const float* latitudes, const float* longitudes) const {
+        const __m512 lat = _mm512_loadu_ps(latitudes);
+        const __m512 lon = _mm512_loadu_ps(longitudes);
+        __mmask16 in_box = _mm512_cmp_ps_mask(lat, min_lat, _CMP_GE_OQ);
+        in_box = _mm512_mask_cmp_ps_mask(in_box, lat, max_lat, _CMP_LE_OQ);
+        in_box = _mm512_mask_cmp_ps_mask(in_box, lon, min_lon, _CMP_GE_OQ);
+        in_box = _mm512_mask_cmp_ps_mask(in_box, lon, max_lon, _CMP_LE_OQ);
+        if (in_box == 0) return 0;
+
+        const __m512 dy = _mm512_sub_ps(lat, centre_lat);
+        const __m512 scale = _mm512_add_ps(lon_scale, _mm512_mul_ps(slope, dy));
+        const __m512 dx = _mm512_mul_ps(_mm512_sub_ps(lon, centre_lon), scale);
+        const __m512 distance_squared = _mm512_add_ps(_mm512_mul_ps(dy, dy), _mm512_mul_ps(dx, dx));
+        return uint64_t(_mm512_mask_cmp_ps_mask(in_box, distance_squared, radius_squared, _CMP_LE_OQ));
+    }
+};
+
+// Count and select loops per ISA, so the matcher inlines into code compiled for it
+__attribute__((target("avx2")))
+size_t countWithinAvx2(const float* latitudes, const float* longitudes, size_t count, const GeoCircle& circle) {
+    const Avx2CircleMatcher matcher(circle);
+    size_t matches = 0, i = 0;
+    for (; i + matcher.kLanes <= count; i += matcher.kLanes) {
+        matches += size_t(std::popcount(matcher.match(latitudes + i, longitudes + i)));
+    }
+    return matches + countWithinScalar(latitudes + i, longitudes + i, count - i, circle);
+}
+
+__attribute__((target("avx2")))
+void selectWithinAvx2(const float* latitudes, const float* longitudes, size_t count, const GeoCircle& circle,
+                      uint64_t* words) {
+    const Avx2CircleMatcher matcher(circle);
+    size_t word = 0;
+    for (; (word + 1) * 64 <= count; word++) {
+        uint64_t bits = 0;
+        for (size_t lane = 0; lane < 64; lane += matcher.kLanes) {
+            bits |= matcher.match(latitudes + word * 64 + lane, longitudes + word * 64 + lane) << lane;
+        }
+        words[word] = bits;
+    }
+    if (word * 64 < count) words[word] = selectScalar(latitudes, longitudes, word * 64, count, circle);
+}
+
+__attribute__((target("avx512f")))
+size_t countWithinAvx512(const float* latitudes, const float* longitudes, size_t count, const GeoCircle& circle) {
+    const Avx512CircleMatcher matcher(circle);
+    size_t matches = 0, i = 0;
+    for (; i + matcher.kLanes <= count; i += matcher.kLanes) {
+        matches += size_t(std::popcount(matcher.match(latitudes + i, longitudes + i)));
+    }
+    return matches + countWithinScalar(latitudes + i, longitudes + i, count - i, circle);
+}
+
+__attribute__((target("avx512f")))
+void selectWithinAvx512(const float* latitudes, const float* longitudes, size_t count, const GeoCircle& circle,
+                        uint64_t* words) {
+    const Avx512CircleMatcher matcher(circle);
+    size_t word = 0;
+    for (; (word + 1) * 64 <= count; word++) {
+        uint64_t bits = 0;
+        for (size_t lane = 0; lane < 64; lane += matcher.kLanes) {
+            bits |= matcher.match(latitudes + word * 64 + lane, longitudes + word * 64 + lane) << lane;
+        }
+        words[word] = bits;
+    }
+    if (word * 64 < count) words[word] = selectScalar(latitudes, longitudes, word * 64, count, circle);
+}
+#endif
+
+using CountWithinFn = size_t (*)(const float*, const float*, size_t, const GeoCircle&);
+using SelectWithinFn = void (*)(const float*, const float*, size_t, const GeoCircle&, uint64_t*);
+
+struct DistanceKernel {
+    CountWithinFn count;
+    SelectWithinFn select;
+    const char* name;
+};
+
+DistanceKernel pickDistanceKernel() {
+#if defined(GEO_DISTANCE_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return {countWithinAvx512, selectWithinAvx512, "AVX-512"};
+    if (__builtin_cpu_supports("avx2")) return {countWithinAvx2, selectWithinAvx2, "AVX2"};
+#endif
+    return {countWithinScalar, selectWithinScalar, "scalar"};
+}
+
+const DistanceKernel& distanceKernel() {
+    static const DistanceKernel picked = pickDistanceKernel();
+    return picked;
+}
+
+} // namespace
+
+GeoCircle GeoDistance::circle(double lat, double lon, double radius_km) {
+    GeoCircle circle;
+    if (!std::isfinite(lat) || !std::isfinite(lon) || !std::isfinite(radius_km) || radius_km < 0) return circle;
+
+    const double radius = radius_km / kKmPerDegree;
+    const double lat_radians = lat * std::numbers::pi / 180;
+    circle.lat = float(lat);
+    circle.lon = float(lon);
+    circle.lon_scale = float(std::cos(lat_radians));
+    // d/d(dy) of cos(lat0 + dy / 2), dy in degrees
+    circle.lon_scale_slope = float(-std::sin(lat_radians) * std::numbers::pi / 360);
+    circle.radius_squared = float(radius * radius);
+
+    const double lat_extent = radius * (1 + kBoxMargin) + kBoxSlackDegrees;
+    circle.min_lat = float(lat - lat_extent);
+    circle.max_lat = float(lat + lat_extent);
+
+    // The narrowest degree of longitude in the latitude band bounds the box's width; near the
+    // poles (or for continent-sized radii) the box spans every longitude
+    const double min_scale = std::cos(lat_radians) - std::abs(std::sin(lat_radians)) * lat_extent * std::numbers::pi / 360;
+    const double lon_extent = min_scale > 0 ? lat_extent / min_scale * (1 + kBoxMargin) + kBoxSlackDegrees : 360;
+    if (lon_extent < 360) {
+        circle.min_lon = float(lon - lon_extent);
+        circle.max_lon = float(lon + lon_extent);
+    } else {
+        circle.min_lon = -std::numeric_limits<float>::infinity();
+        circle.max_lon = std::numeric_limits<float>::infinity();
+    }
+    return circle;
+}
+
+double GeoDistance::haversineKm(double lat1, double lon1, double lat2, double lon2) {
+    constexpr double kRadians = std::numbers::pi / 180;
+    const double sin_dlat = std::sin((lat2 - lat1) * kRadians / 2);
+    const double sin_dlon = std::sin((lon2 - lon1) * kRadians / 2);
+    const double a = sin_dlat * sin_dlat + std::cos(lat1 * kRadians) * std::cos(lat2 * kRadians) * sin_dlon * sin_dlon;
+    return 2 * kEarthRadiusKm * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+size_t GeoDistance::countWithin(const float* latitudes, const float* longitudes, size_t count, const GeoCircle& circle) {
+    return distanceKernel().count(latitudes, longitudes, count, circle);
+}
+
+size_t GeoDistance::countWithin(const std::vector<float>& latitudes, const std::vector<float>& longitudes,
+                                const GeoCircle& circle) {
+    const size_t rows = std::min(latitudes.size(), longitudes.size());
+    const size_t chunks = (rows + kChunkRows - 1) / kChunkRows;
+    const CountWithinFn count = distanceKernel().count;
+    size_t matches = 0;
+    #pragma omp parallel for schedule(static) reduction(+:matches)
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        const size_t begin = chunk * kChunkRows;
+        const size_t end = std::min(rows, begin + kChunkRows);
+        matches += count(latitudes.data() + begin, longitudes.data() + begin, end - begin, circle);
+    }
+    return matches;
+}
+
+void GeoDistance::selectWithin(const float* latitudes, const float* longitudes, size_t count, const GeoCircle& circle,
+                               uint64_t* words) {
+    distanceKernel().select(latitudes, longitudes, count, circle, words);
+}
+
+std::vector<uint64_t> GeoDistance::selectWithin(const std::vector<float>& latitudes,
+                                                const std::vector<float>& longitudes, const GeoCircle& circle) {
+    const size_t rows = std::min(latitudes.size(), longitudes.size());
+    std::vector<uint64_t> words((rows + 63) / 64);
+    const size_t chunks = (rows + kChunkRows - 1) / kChunkRows;
+    const SelectWithinFn select = distanceKernel().select;
+    #pragma omp parallel for schedule(static)
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        const size_t begin = chunk * kChunkRows;
+        const size_t end = std::min(rows, begin + kChunkRows);
+        select(latitudes.data() + begin, longitudes.data() + begin, end - begin, circle, words.data() + begin / 64);
+    }
+    return words;
+}
+
+const char* GeoDistance::isaName() {
+    return distanceKernel().name;
+}
@@ -0,0 +1,66 @@
+#ifndef GEO_DISTANCE_H
+#define GEO_DISTANCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+// A radius query prepared once: the centre and the distance terms as floats for the kernels,
+// plus a bounding box that holds every point within the radius
+struct GeoCircle {
+    float lat = 0, lon = 0;
+    float lon_scale = 1;        // cos(lat): length of a degree of longitude in degrees of latitude
+    float lon_scale_slope = 0;  // change of the scale per degree of dy, for the midpoint latitude
+    float radius_squared = -1;  // radius in degrees of latitude, squared; negative matches nothing
+    float min_lat = 1, max_lat = -1, min_lon = 1, max_lon = -1;
+};
+
+// Kilometre radius tests over float lat/lon columns. Distances are equirectangular at the
+// midpoint latitude of the centre and the point, compared in squared degrees of latitude:
+//   dy = lat - lat0,  dx = (lon - lon0) * cos((lat + lat0) / 2),  dy^2 + dx^2 <= r^2
+// with the cosine linearised around lat0. For radii up to ~100 km this is within 0.01% of the
+// haversine distance. Longitudes do not wrap at +-180.
+class GeoDistance {
+public:
+    static constexpr double kEarthRadiusKm = 6371.0088;  // IUGG mean radius
+    static constexpr double kKmPerDegree = kEarthRadiusKm * std::numbers::pi / 180;
+
+    // A non-finite centre or a negative radius gives a circle that matches nothing
+    static GeoCircle circle(double lat, double lon, double radius_km);
+
+    static bool contains(const GeoCircle& circle, float lat, float lon) {
+        if (!(lat >= circle.min_lat && lat <= circle.max_lat && lon >= circle.min_lon && lon <= circle.max_lon)) {
+            return false;
+        }
+        const float dy = lat - circle.lat;
+        const float scale = circle.lon_scale + circle.lon_scale_slope * dy;
+        const float dx = (lon - circle.lon) * scale;
+        return dy * dy + dx * dx <= circle.radius_squared;
+    }
+
+    // Great-circle distance, the reference the approximation is checked against
+    static double haversineKm(double lat1, double lon1, double lat2, double lon2);
+
+    // Points of [0, count) inside the circle, single-threaded. Vectors of 16 (AVX-512) or 8
+    // (AVX2) points are rejected on the bounding box alone before any distance is computed.
+    static size_t countWithin(const float* latitudes, const float* longitudes, size_t count, const GeoCircle& circle);
+
+    // Same over whole columns, split across OpenMP threads
+    static size_t countWithin(const std::vector<float>& latitudes, const std::vector<float>& longitudes,
+                              const GeoCircle& circle);
+
+    // Sets bit i % 64 of words[i / 64] for each point i of [0, count) inside the circle and
+    // clears the others; words holds (count + 63) / 64 entries
+    static void selectWithin(const float* latitudes, const float* longitudes, size_t count, const GeoCircle& circle,
+                             uint64_t* words);
+
+    // Row mask of whole columns, split across OpenMP threads
+    static std::vector<uint64_t> selectWithin(const std::vector<float>& latitudes,
+                                              const std::vector<float>& longitudes, const GeoCircle& circle);
+
+    // Instruction set countWithin and selectWithin run with
+    static const char* isaName();
+};
+
+#endif // GEO_DISTANCE_H
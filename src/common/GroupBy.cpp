@@ -0,0 +1,250 @@
+#include "GroupBy.h"
+#include "DateParser.h"
+
+#include <algorithm>
+#include <iostream>
+#include <omp.h>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+// Rows whose combined keys are computed at once; the key buffer stays in L1/L2
+constexpr size_t kChunkRows = 16384;
+
+template <typename Code>
+void addCodesOf(const Code* codes, uint64_t* keys, size_t begin, size_t count, const uint32_t* rows,
+                uint64_t stride) {
+    if (rows) {
+        for (size_t i = 0; i < count; i++) keys[i] += uint64_t(codes[rows[begin + i]]) * stride;
+    } else {
+        for (size_t i = 0; i < count; i++) keys[i] += uint64_t(codes[begin + i]) * stride;
+    }
+}
+
+// One thread's aggregates: a slot per group, counts[slot] and aggregates[slot * measures + m].
+// Dense tables use the combined key as the slot; hash tables map keys to slots in first-seen order.
+struct PartialGroups {
+    std::vector<uint64_t> counts;
+    std::vector<GroupAggregate> aggregates;
+    std::unordered_map<uint64_t, uint32_t> slots;
+    std::vector<uint64_t> slot_keys;
+};
+
+template <typename T>
+void aggregateMeasure(const T* values, const uint32_t* slots, size_t begin, size_t count, const uint32_t* rows,
+                      GroupAggregate* aggregates, size_t measure_count, size_t measure) {
+    for (size_t i = 0; i < count; i++) {
+        const int64_t value = values[rows ? rows[begin + i] : begin + i];
+        GroupAggregate& aggregate = aggregates[size_t(slots[i]) * measure_count + measure];
+        aggregate.sum += value;
+        aggregate.min = std::min(aggregate.min, value);
+        aggregate.max = std::max(aggregate.max, value);
+    }
+}
+
+void mergeAggregate(GroupAggregate& into, const GroupAggregate& from) {
+    into.sum += from.sum;
+    into.min = std::min(into.min, from.min);
+    into.max = std::max(into.max, from.max);
+}
+
+} // namespace
+
+GroupKey GroupKey::dictionary(std::string name, const DictionaryColumn& column) {
+    GroupKey key;
+    key.key_name = std::move(name);
+    key.labels = column.dictionary();
+    key.codes = column.codeData();
+    key.code_width = column.codeWidth();
+    return key;
+}
+
+GroupKey GroupKey::year(std::string name, const std::vector<int32_t>& days) {
+    GroupKey key;
+    key.key_name = std::move(name);
+    int32_t first_year = INT32_MAX, last_year = INT32_MIN;
+    #pragma omp parallel for reduction(min:first_year) reduction(max:last_year)
+    for (size_t i = 0; i < days.size(); i++) {
+        if (days[i] == DateParser::kInvalidDate) continue;
+        const int32_t year = DateParser::yearFromDays(days[i]);
+        first_year = std::min(first_year, year);
+        last_year = std::max(last_year, year);
+    }
+    if (first_year > last_year) first_year = last_year = 0;
+    // The span is capped well below the uint16 codes; years outside it are treated as invalid
+    last_year = std::min(last_year, first_year + 9999);
+
+    for (int32_t year = first_year; year <= last_year; year++) key.labels.push_back(std::to_string(year));
+    const uint16_t invalid_code = uint16_t(key.labels.size());
+    key.labels.emplace_back();
+    key.owned_codes.resize(days.size());
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < days.size(); i++) {
+        const int32_t year = days[i] == DateParser::kInvalidDate ? INT32_MIN : DateParser::yearFromDays(days[i]);
+        key.owned_codes[i] = year < first_year || year > last_year ? invalid_code : uint16_t(year - first_year);
+    }
+    key.code_width = sizeof(uint16_t);
+    return key;
+}
+
+void GroupKey::addCodes(uint64_t* keys, size_t begin, size_t count, const uint32_t* rows, uint64_t stride) const {
+    // Owned codes are looked up here rather than stored in codes, so copies of the key stay valid
+    const void* code_data = owned_codes.empty() ? codes : owned_codes.data();
+    switch (code_width) {
+        case 1: addCodesOf(static_cast<const uint8_t*>(code_data), keys, begin, count, rows, stride); break;
+        case 2: addCodesOf(static_cast<const uint16_t*>(code_data), keys, begin, count, rows, stride); break;
+        default: addCodesOf(static_cast<const uint32_t*>(code_data), keys, begin, count, rows, stride); break;
+    }
+}
+
+GroupBy& GroupBy::key(GroupKey part) {
+    keys.push_back(std::move(part));
+    return *this;
+}
+
+GroupBy& GroupBy::measure(GroupMeasure measure) {
+    measures.push_back(std::move(measure));
+    return *this;
+}
+
+bool GroupBy::denseFits(uint64_t groups, size_t measure_count, size_t threads) {
+    if (groups > kDenseGroups) return false;
+    const uint64_t slot_bytes = sizeof(uint64_t) + measure_count * sizeof(GroupAggregate);
+    return groups * slot_bytes * std::max<size_t>(threads, 1) <= kDenseTableBytes;
+}
+
+GroupResult GroupBy::run(size_t row_count, const std::vector<uint32_t>* selection) const {
+    GroupResult result;
+    result.keys = keys;
+    for (const GroupMeasure& measure : measures) result.measure_names.push_back(measure.name());
+
+    // Mixed-radix combined key, the first key most significant
+    std::vector<uint64_t> strides(keys.size());
+    uint64_t groups = 1;
+    for (size_t k = keys.size(); k-- > 0;) {
+        strides[k] = groups;
+        if (keys[k].cardinality() == 0) return result;
+        if (groups > UINT64_MAX / keys[k].cardinality()) {
+            std::cerr << "Error: the group-by key space exceeds 64 bits" << std::endl;
+            return result;
+        }
+        groups *= keys[k].cardinality();
+    }
+
+    const uint32_t* rows = selection ? selection->data() : nullptr;
+    const size_t count = selection ? selection->size() : row_count;
+    const size_t measure_count = measures.size();
+    const size_t chunks = (count + kChunkRows - 1) / kChunkRows;
+    std::vector<PartialGroups> partials(static_cast<size_t>(omp_get_max_threads()));
+    result.dense = denseFits(groups, measure_count, partials.size());
+
+    #pragma omp parallel
+    {
+        PartialGroups& partial = partials[size_t(omp_get_thread_num())];
+        if (result.dense) {
+            partial.counts.assign(groups, 0);
+            partial.aggregates.assign(groups * measure_count, GroupAggregate());
+        }
+        std::vector<uint64_t> chunk_keys(kChunkRows);
+        std::vector<uint32_t> chunk_slots(kChunkRows);
+
+        #pragma omp for schedule(dynamic, 4)
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            const size_t begin = chunk * kChunkRows;
+            const size_t rows_in_chunk = std::min(kChunkRows, count - begin);
+            std::fill_n(chunk_keys.begin(), rows_in_chunk, 0);
+            for (size_t k = 0; k < keys.size(); k++) {
+                keys[k].addCodes(chunk_keys.data(), begin, rows_in_chunk, rows, strides[k]);
+            }
+
+            if (result.dense) {
+                for (size_t i = 0; i < rows_in_chunk; i++) {
+                    chunk_slots[i] = uint32_t(chunk_keys[i]);
+                    partial.counts[chunk_slots[i]]++;
+                }
+            } else {
+                for (size_t i = 0; i < rows_in_chunk; i++) {
+                    auto [slot, inserted] = partial.slots.try_emplace(chunk_keys[i], uint32_t(partial.slot_keys.size()));
+                    if (inserted) {
+                        partial.slot_keys.push_back(chunk_keys[i]);
+                        partial.counts.push_back(0);
+                        partial.aggregates.resize(partial.aggregates.size() + measure_count);
+                    }
+                    chunk_slots[i] = slot->second;
+                    partial.counts[slot->second]++;
+                }
+            }
+
+            // A measure at a time, so each inner loop reads one column
+            for (size_t m = 0; m < measure_count; m++) {
+                const GroupMeasure& measure = measures[m];
+                GroupAggregate* aggregates = partial.aggregates.data();
+                switch (measure.type) {
+                    case GroupMeasure::Type::UInt8:
+                        aggregateMeasure(static_cast<const uint8_t*>(measure.values), chunk_slots.data(), begin,
+                                         rows_in_chunk, rows, aggregates, measure_count, m);
+                        break;
+                    case GroupMeasure::Type::UInt16:
+                        aggregateMeasure(static_cast<const uint16_t*>(measure.values), chunk_slots.data(), begin,
+                                         rows_in_chunk, rows, aggregates, measure_count, m);
+                        break;
+                    case GroupMeasure::Type::Int32:
+                        aggregateMeasure(static_cast<const int32_t*>(measure.values), chunk_slots.data(), begin,
+                                         rows_in_chunk, rows, aggregates, measure_count, m);
+                        break;
+                }
+            }
+        }
+    }
+
+    // Merge: dense tables slot by slot (in parallel), hash tables key by key
+    std::vector<std::pair<uint64_t, size_t>> group_slots;  // combined key -> slot of partials[0]
+    PartialGroups& merged = partials[0];
+    if (result.dense) {
+        #pragma omp parallel for schedule(static)
+        for (size_t slot = 0; slot < groups; slot++) {
+            for (size_t t = 1; t < partials.size(); t++) {
+                if (partials[t].counts.empty() || partials[t].counts[slot] == 0) continue;
+                merged.counts[slot] += partials[t].counts[slot];
+                for (size_t m = 0; m < measure_count; m++) {
+                    mergeAggregate(merged.aggregates[slot * measure_count + m],
+                                   partials[t].aggregates[slot * measure_count + m]);
+                }
+            }
+        }
+        for (size_t slot = 0; slot < groups; slot++) {
+            if (merged.counts[slot] > 0) group_slots.emplace_back(slot, slot);
+        }
+    } else {
+        for (size_t t = 1; t < partials.size(); t++) {
+            for (size_t from = 0; from < partials[t].slot_keys.size(); from++) {
+                auto [slot, inserted] = merged.slots.try_emplace(partials[t].slot_keys[from], uint32_t(merged.slot_keys.size()));
+                if (inserted) {
+                    merged.slot_keys.push_back(partials[t].slot_keys[from]);
+                    merged.counts.push_back(0);
+                    merged.aggregates.resize(merged.aggregates.size() + measure_count);
+                }
+                merged.counts[slot->second] += partials[t].counts[from];
+                for (size_t m = 0; m < measure_count; m++) {
+                    mergeAggregate(merged.aggregates[size_t(slot->second) * measure_count + m],
+                                   partials[t].aggregates[from * measure_count + m]);
+                }
+            }
+        }
+        for (size_t slot = 0; slot < merged.slot_keys.size(); slot++) group_slots.emplace_back(merged.slot_keys[slot], slot);
+        std::sort(group_slots.begin(), group_slots.end());
+    }
+
+    result.groups.reserve(group_slots.size());
+    for (const auto& [combined, slot] : group_slots) {
+        GroupRow group;
+        group.codes.resize(keys.size());
+        for (size_t k = 0; k < keys.size(); k++) group.codes[k] = uint32_t(combined / strides[k] % keys[k].cardinality());
+        group.count = merged.counts[slot];
+        group.aggregates.assign(merged.aggregates.begin() + ptrdiff_t(slot * measure_count),
+                                merged.aggregates.begin() + ptrdiff_t((slot + 1) * measure_count));
+        result.groups.push_back(std::move(group));
+    }
+    return result;
+}
@@ -0,0 +1,115 @@
+#ifndef GROUP_BY_H
+#define GROUP_BY_H
+
+#include "DictionaryColumn.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// One column of a group-by key: a code in [0, cardinality()) per row, and a label per code
+class GroupKey {
+public:
+    // The codes of a dictionary column; its dictionary gives the labels. The column must
+    // outlive the key.
+    static GroupKey dictionary(std::string name, const DictionaryColumn& column);
+    // Calendar year of dates in days since 1970-01-01; invalid dates group under ""
+    static GroupKey year(std::string name, const std::vector<int32_t>& days);
+
+    [[nodiscard]] const std::string& name() const { return key_name; }
+    [[nodiscard]] size_t cardinality() const { return labels.size(); }
+    [[nodiscard]] const std::string& label(uint32_t code) const { return labels[code]; }
+
+    // keys[i] += code * stride for the rows begin + i (or rows[begin + i]), i < count
+    void addCodes(uint64_t* keys, size_t begin, size_t count, const uint32_t* rows, uint64_t stride) const;
+
+private:
+    std::string key_name;
+    std::vector<std::string> labels;
+    const void* codes = nullptr;  // dictionary codes; derived keys use owned_codes
+    size_t code_width = 0;
+    std::vector<uint16_t> owned_codes;  // codes of derived keys such as year
+};
+
+// An integer column aggregated per group: sum, min, max (and so avg)
+class GroupMeasure {
+public:
+    template <typename T>
+    static GroupMeasure of(std::string name, const std::vector<T>& values) {
+        static_assert(std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t> || std::is_same_v<T, int32_t>,
+                      "measures are uint8, uint16 or int32 columns");
+        GroupMeasure measure;
+        measure.measure_name = std::move(name);
+        measure.values = values.data();
+        if constexpr (std::is_same_v<T, uint8_t>) measure.type = Type::UInt8;
+        else if constexpr (std::is_same_v<T, uint16_t>) measure.type = Type::UInt16;
+        else measure.type = Type::Int32;
+        return measure;
+    }
+
+    [[nodiscard]] const std::string& name() const { return measure_name; }
+
+private:
+    friend class GroupBy;
+    enum class Type { UInt8, UInt16, Int32 };
+
+    std::string measure_name;
+    const void* values = nullptr;
+    Type type = Type::Int32;
+};
+
+struct GroupAggregate {
+    int64_t sum = 0;
+    int64_t min = std::numeric_limits<int64_t>::max();
+    int64_t max = std::numeric_limits<int64_t>::min();
+};
+
+struct GroupRow {
+    std::vector<uint32_t> codes;             // one per key, see GroupResult::label
+    uint64_t count = 0;                      // rows in the group
+    std::vector<GroupAggregate> aggregates;  // one per measure
+
+    [[nodiscard]] double average(size_t measure) const {
+        return count == 0 ? 0 : double(aggregates[measure].sum) / double(count);
+    }
+};
+
+struct GroupResult {
+    std::vector<GroupKey> keys;
+    std::vector<std::string> measure_names;
+    std::vector<GroupRow> groups;  // non-empty groups, ordered by key codes
+    bool dense = false;            // aggregated into arrays rather than hash tables
+
+    [[nodiscard]] const std::string& label(const GroupRow& group, size_t key) const {
+        return keys[key].label(group.codes[key]);
+    }
+};
+
+// Count plus sum/min/max/avg of measures per combination of key codes, over all rows or a
+// selection. Each thread aggregates its chunks into private tables, merged at the end. The
+// tables are dense arrays indexed by the combined code while every thread's array together
+// fits in kDenseTableBytes (dictionary keys almost always do), hash tables beyond that.
+class GroupBy {
+public:
+    static constexpr size_t kDenseGroups = size_t(1) << 18;
+    static constexpr size_t kDenseTableBytes = size_t(64) << 20;
+
+    // Whether one dense table per thread, groups slots of a count plus measure_count
+    // aggregates each, stays within kDenseGroups slots and kDenseTableBytes in total
+    [[nodiscard]] static bool denseFits(uint64_t groups, size_t measure_count, size_t threads);
+
+    GroupBy& key(GroupKey part);
+    GroupBy& measure(GroupMeasure measure);
+
+    // Aggregates rows [0, row_count), or only the rows listed in selection
+    [[nodiscard]] GroupResult run(size_t row_count, const std::vector<uint32_t>* selection = nullptr) const;
+
+private:
+    std::vector<GroupKey> keys;
+    std::vector<GroupMeasure> measures;
+};
+
+#endif // GROUP_BY_H
@@ -0,0 +1,81 @@
+#include "HourlyCounts.h"
+#include "DateParser.h"
+
+#include <algorithm>
+#include <omp.h>
+
+void HourlyCounts::build(const std::vector<int32_t>& days, const std::vector<uint16_t>& minutes) {
+    prefix.clear();
+    day_count = 0;
+    const size_t rows = std::min(days.size(), minutes.size());
+
+    int32_t first = INT32_MAX, last = INT32_MIN;
+    #pragma omp parallel for reduction(min:first) reduction(max:last)
+    for (size_t i = 0; i < rows; i++) {
+        if (days[i] == DateParser::kInvalidDate) continue;
+        first = std::min(first, days[i]);
+        last = std::max(last, days[i]);
+    }
+    if (first > last) return;
+    start_day = first;
+    day_count = size_t(int64_t(last) - first) + 1;
+
+    // Per-thread day x slot counts, summed into day d + 1, then scanned over days
+    prefix.assign((day_count + 1) * kSlots, 0);
+    #pragma omp parallel
+    {
+        std::vector<uint32_t> local(day_count * kSlots, 0);
+        #pragma omp for schedule(static) nowait
+        for (size_t i = 0; i < rows; i++) {
+            if (days[i] == DateParser::kInvalidDate) continue;
+            const size_t slot = minutes[i] == DateParser::kInvalidTime ? kSlots - 1 : minutes[i] / 60;
+            local[size_t(days[i] - start_day) * kSlots + slot]++;
+        }
+        #pragma omp critical
+        for (size_t i = 0; i < local.size(); i++) prefix[kSlots + i] += local[i];
+    }
+    for (size_t i = kSlots; i < prefix.size(); i++) prefix[i] += prefix[i - kSlots];
+}
+
+uint32_t HourlyCounts::allSlots(size_t first, size_t end) const {
+    uint32_t total = 0;
+    for (size_t slot = 0; slot < kSlots; slot++) total += rows(first, end, slot);
+    return total;
+}
+
+std::vector<uint32_t> HourlyCounts::histogram(int32_t first_day, int32_t last_day, TimeBucket bucket) const {
+    std::vector<uint32_t> buckets(TimeSeries::bucketCount(bucket, first_day, last_day), 0);
+    if (buckets.empty() || day_count == 0) return buckets;
+
+    // The window clamped to the span, as day offsets [first, end); days beyond it add nothing
+    const int64_t window_start = int64_t(first_day) - start_day;
+    const int64_t first = std::max<int64_t>(window_start, 0);
+    const int64_t end = std::min<int64_t>(int64_t(last_day) - start_day + 1, int64_t(day_count));
+    if (first >= end) return buckets;
+
+    switch (bucket) {
+        case TimeBucket::Hour:
+            for (int64_t day = first; day < end; day++) {
+                for (size_t hour = 0; hour < 24; hour++) {
+                    buckets[size_t(day - window_start) * 24 + hour] = rows(size_t(day), size_t(day) + 1, hour);
+                }
+            }
+            break;
+        case TimeBucket::HourOfDay:
+            for (size_t hour = 0; hour < 24; hour++) buckets[hour] = rows(size_t(first), size_t(end), hour);
+            break;
+        case TimeBucket::Day:
+            for (int64_t day = first; day < end; day++) {
+                buckets[size_t(day - window_start)] = allSlots(size_t(day), size_t(day) + 1);
+            }
+            break;
+        case TimeBucket::Week:
+            for (size_t week = 0; week < buckets.size(); week++) {
+                const int64_t week_first = std::max(window_start + int64_t(week) * 7, first);
+                const int64_t week_end = std::min(window_start + int64_t(week + 1) * 7, end);
+                if (week_first < week_end) buckets[week] = allSlots(size_t(week_first), size_t(week_end));
+            }
+            break;
+    }
+    return buckets;
+}
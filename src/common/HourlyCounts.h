@@ -0,0 +1,41 @@
+#ifndef HOURLY_COUNTS_H
+#define HOURLY_COUNTS_H
+
+#include "TimeSeries.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Rows per day and hour of day over the span of a date column, as prefix sums over days: a
+// TimeSeries histogram of any window then costs a few lookups per bucket instead of a scan.
+// Rows with an invalid time are kept in a 25th slot per day, so day and week totals still
+// count them; rows with an invalid date are not counted.
+class HourlyCounts {
+public:
+    // Counts days (days since 1970-01-01) by hour of minutes (minutes since midnight)
+    void build(const std::vector<int32_t>& days, const std::vector<uint16_t>& minutes);
+
+    // Same buckets as TimeSeries::histogram over the same rows
+    [[nodiscard]] std::vector<uint32_t> histogram(int32_t first_day, int32_t last_day, TimeBucket bucket) const;
+
+    [[nodiscard]] bool empty() const { return day_count == 0; }
+    // Heap bytes of the prefix sums
+    [[nodiscard]] size_t memoryBytes() const { return prefix.capacity() * sizeof(uint32_t); }
+
+private:
+    static constexpr size_t kSlots = 25;  // hours 0-23, then unknown time
+
+    // Rows of slot dated start_day + first .. start_day + end - 1
+    [[nodiscard]] uint32_t rows(size_t first, size_t end, size_t slot) const {
+        return prefix[end * kSlots + slot] - prefix[first * kSlots + slot];
+    }
+    [[nodiscard]] uint32_t allSlots(size_t first, size_t end) const;
+
+    // prefix[d * kSlots + s] = rows of slot s dated before start_day + d; day_count + 1 rows
+    std::vector<uint32_t> prefix;
+    int32_t start_day = 0;
+    size_t day_count = 0;
+};
+
+#endif // HOURLY_COUNTS_H
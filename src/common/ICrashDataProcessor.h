@@ -19,6 +19,7 @@ public:
     // APIs for range based searching
     [[nodiscard]] virtual int getCrashesInDateRange(const std::string& start_date, const std::string& end_date) = 0;
     [[nodiscard]] virtual int getCrashesByInjuryCountRange(int min_injuries, int max_injuries) = 0;
+    // Crashes within radius km of (lat, lon), by GeoDistance
     [[nodiscard]] virtual int getCrashesByLocationRange(float lat, float lon, float radius) = 0;
 
     [[nodiscard]] virtual std::chrono::duration<double> getDataLoadDuration() const = 0;
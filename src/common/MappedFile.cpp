@@ -0,0 +1,67 @@
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <utility>
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mapped(std::exchange(other.mapped, nullptr)), mapped_size(std::exchange(other.mapped_size, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        mapped = std::exchange(other.mapped, nullptr);
+        mapped_size = std::exchange(other.mapped_size, 0);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+
+    // Open the file
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::cerr << "Error opening file: " << filename << std::endl;
+        return false;
+    }
+
+    // Get file size
+    off_t file_size = lseek(fd, 0, SEEK_END);
+    if (file_size == -1) {
+        std::cerr << "Error getting file size" << std::endl;
+        ::close(fd);
+        return false;
+    }
+    if (file_size == 0) {
+        // mmap rejects empty files; an empty mapping is still a valid, empty CSV
+        ::close(fd);
+        return true;
+    }
+
+    // Memory-map the file
+    void* data = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        std::cerr << "Error memory-mapping file" << std::endl;
+        return false;
+    }
+
+    mapped = static_cast<char*>(data);
+    mapped_size = file_size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped) {
+        munmap(mapped, mapped_size);
+        mapped = nullptr;
+        mapped_size = 0;
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file, unmapped on destruction
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Maps filename, replacing any current mapping. Prints the error and returns false on failure.
+    bool open(const std::string& filename);
+    void close();
+
+    [[nodiscard]] const char* data() const { return mapped; }
+    [[nodiscard]] size_t size() const { return mapped_size; }
+    [[nodiscard]] bool isOpen() const { return mapped != nullptr; }
+
+private:
+    char* mapped = nullptr;
+    size_t mapped_size = 0;
+};
+
+#endif // MAPPED_FILE_H
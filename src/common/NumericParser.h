@@ -0,0 +1,159 @@
+#ifndef NUMERIC_PARSER_H
+#define NUMERIC_PARSER_H
+
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+// Allocation- and exception-free parsing of numeric CSV fields. A field must be a number in
+// full (no surrounding text); anything else, including an empty field, returns false and
+// leaves the output untouched instead of throwing. The to* helpers substitute a fallback.
+class NumericParser {
+public:
+    // Optional sign followed by decimal digits. Up to 8 digits are converted at once with
+    // SWAR arithmetic on a 64-bit word; longer fields go through std::from_chars.
+    template <typename Int>
+    static bool parseInt(std::string_view text, Int& value) {
+        static_assert(std::is_integral_v<Int>);
+        bool negative = false;
+        std::string_view digits = text;
+        if (!digits.empty() && (digits[0] == '-' || digits[0] == '+')) {
+            negative = digits[0] == '-';
+            digits.remove_prefix(1);
+        }
+        if (digits.empty() || (negative && std::is_unsigned_v<Int>)) return false;
+
+        if (digits.size() <= 8) {
+            uint32_t magnitude = 0;
+            if (!parseEightDigits(digits, magnitude)) return false;
+            const int64_t result = negative ? -int64_t(magnitude) : int64_t(magnitude);
+            if (result < int64_t(std::numeric_limits<Int>::min()) ||
+                (result > 0 && uint64_t(result) > uint64_t(std::numeric_limits<Int>::max()))) {
+                return false;
+            }
+            value = Int(result);
+            return true;
+        }
+
+        Int result{};
+        const char* end = text.data() + text.size();
+        const char* begin = text[0] == '+' ? text.data() + 1 : text.data();
+        auto [ptr, ec] = std::from_chars(begin, end, result);
+        if (ec != std::errc() || ptr != end) return false;
+        value = result;
+        return true;
+    }
+
+    // Optional sign, digits and an optional fraction. Plain decimals with up to 15 significant
+    // digits are computed exactly in double; exponents and longer values use from_chars.
+    static bool parseFloat(std::string_view text, float& value) {
+        if (text.empty()) return false;
+
+        size_t pos = 0;
+        const bool negative = text[0] == '-';
+        if (text[0] == '-' || text[0] == '+') pos++;
+
+        uint64_t mantissa = 0;
+        size_t digit_count = 0;
+        size_t fraction_digits = 0;
+        bool seen_point = false;
+        for (; pos < text.size(); pos++) {
+            const char c = text[pos];
+            if (uint8_t(c - '0') <= 9) {
+                mantissa = mantissa * 10 + uint64_t(c - '0');
+                digit_count++;
+                fraction_digits += seen_point;
+            } else if (c == '.' && !seen_point) {
+                seen_point = true;
+            } else {
+                break;
+            }
+        }
+
+        if (pos == text.size() && digit_count > 0 && digit_count <= 15) {
+            // Both operands are exact doubles, so the quotient is correctly rounded
+            double result = double(mantissa) / kPowersOfTen[fraction_digits];
+            value = float(negative ? -result : result);
+            return true;
+        }
+        if (digit_count == 0) return false;
+        return parseFloatSlow(text, value);
+    }
+
+    // Field value, or fallback when the field is empty or not a number
+    template <typename Int = int>
+    static Int toInt(std::string_view text, Int fallback = 0) {
+        Int value;
+        return parseInt(text, value) ? value : fallback;
+    }
+
+    static float toFloat(std::string_view text, float fallback = 0.0f) {
+        float value;
+        return parseFloat(text, value) ? value : fallback;
+    }
+
+private:
+    static constexpr double kPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                              1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+    // 1 to 8 ASCII digits -> value. The digits are right-aligned in a word of '0' bytes,
+    // validated together, then combined pairwise: 8 x 1 digit -> 4 x 2 -> 2 x 4 -> 1 x 8.
+    static bool parseEightDigits(std::string_view digits, uint32_t& value) {
+        if constexpr (std::endian::native != std::endian::little) {
+            value = 0;
+            for (char c : digits) {
+                if (uint8_t(c - '0') > 9) return false;
+                value = value * 10 + uint32_t(c - '0');
+            }
+            return true;
+        } else {
+            uint64_t word = 0x3030303030303030ULL;
+            std::memcpy(reinterpret_cast<char*>(&word) + (8 - digits.size()), digits.data(), digits.size());
+
+            // Every byte must be in '0'..'9': high nibble 3, and adding 6 must not carry out of the low nibble
+            if ((word & 0xF0F0F0F0F0F0F0F0ULL) != 0x3030303030303030ULL ||
+                ((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) != 0x3030303030303030ULL) {
+                return false;
+            }
+
+            word &= 0x0F0F0F0F0F0F0F0FULL;
+            word = (word * 10 + (word >> 8)) & 0x00FF00FF00FF00FFULL;
+            word = (word * 100 + (word >> 16)) & 0x0000FFFF0000FFFFULL;
+            word = (word * 10000 + (word >> 32)) & 0x00000000FFFFFFFFULL;
+            value = uint32_t(word);
+            return true;
+        }
+    }
+
+    static bool parseFloatSlow(std::string_view text, float& value) {
+        const char* begin = text[0] == '+' ? text.data() + 1 : text.data();
+        const char* end = text.data() + text.size();
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        float result = 0.0f;
+        auto [ptr, ec] = std::from_chars(begin, end, result);
+        if (ec != std::errc() || ptr != end) return false;
+        value = result;
+        return true;
+#else
+        // Standard libraries without floating-point from_chars: strtof on a stack copy
+        char buffer[64];
+        const size_t length = size_t(end - begin);
+        if (length >= sizeof(buffer)) return false;
+        std::memcpy(buffer, begin, length);
+        buffer[length] = '\0';
+        char* parsed_end = nullptr;
+        const float result = std::strtof(buffer, &parsed_end);
+        if (parsed_end != buffer + length) return false;
+        value = result;
+        return true;
+#endif
+    }
+};
+
+#endif // NUMERIC_PARSER_H
@@ -0,0 +1,56 @@
+#include "ParallelCsvSplitter.h"
+#include "SimdCsvTokenizer.h"
+
+#include <cstring>
+#include <omp.h>
+
+namespace {
+
+std::vector<const char*> rawBoundaries(const char* begin, const char* end, int num_chunks) {
+    std::vector<const char*> bounds(num_chunks + 1);
+    size_t chunk_size = (end - begin) / num_chunks;
+    for (int i = 0; i < num_chunks; i++) {
+        bounds[i] = begin + i * chunk_size;
+    }
+    bounds[num_chunks] = end;
+    return bounds;
+}
+
+} // namespace
+
+std::vector<const char*> ParallelCsvSplitter::split(const char* begin, const char* end, int num_chunks) {
+    std::vector<const char*> bounds = rawBoundaries(begin, end, num_chunks);
+
+    // Pass 1: quote parity of every raw range
+    std::vector<unsigned char> odd_quotes(num_chunks);
+    #pragma omp parallel for num_threads(num_chunks)
+    for (int i = 0; i < num_chunks; i++) {
+        odd_quotes[i] = SimdCsvTokenizer::countQuotes(bounds[i], bounds[i + 1]) & 1;
+    }
+
+    // Exclusive XOR-scan: quote state at the start of each range
+    std::vector<unsigned char> in_quotes(num_chunks, 0);
+    for (int i = 1; i < num_chunks; i++) {
+        in_quotes[i] = in_quotes[i - 1] ^ odd_quotes[i - 1];
+    }
+
+    // Pass 2: align every boundary to the first row starting at or after it
+    std::vector<const char*> aligned(bounds);
+    #pragma omp parallel for num_threads(num_chunks)
+    for (int i = 1; i < num_chunks; i++) {
+        if (bounds[i] > begin) {
+            aligned[i] = SimdCsvTokenizer::findRowStart(bounds[i], end, in_quotes[i]);
+        }
+    }
+    return aligned;
+}
+
+std::vector<const char*> ParallelCsvSplitter::splitNaive(const char* begin, const char* end, int num_chunks) {
+    std::vector<const char*> bounds = rawBoundaries(begin, end, num_chunks);
+    for (int i = 1; i < num_chunks; i++) {
+        if (bounds[i] == begin) continue;
+        const void* newline = std::memchr(bounds[i] - 1, '\n', end - (bounds[i] - 1));
+        bounds[i] = newline ? static_cast<const char*>(newline) + 1 : end;
+    }
+    return bounds;
+}
@@ -0,0 +1,21 @@
+#ifndef PARALLEL_CSV_SPLITTER_H
+#define PARALLEL_CSV_SPLITTER_H
+
+#include <cstddef>
+#include <vector>
+
+// Splits an in-memory CSV into row-aligned chunks, one per thread.
+// split() is RFC 4180 aware: every thread counts the quotes in its raw byte range, an
+// exclusive XOR-scan over those parities gives each range's starting quote state, and each
+// thread then moves forward to the first unquoted newline. Both passes run in parallel.
+class ParallelCsvSplitter {
+public:
+    // Returns num_chunks + 1 boundaries; chunk i is [bounds[i], bounds[i + 1]).
+    // begin must be the start of a row outside any quoted field.
+    static std::vector<const char*> split(const char* begin, const char* end, int num_chunks);
+
+    // Previous behaviour: move each raw boundary forward to the next '\n', ignoring quotes
+    static std::vector<const char*> splitNaive(const char* begin, const char* end, int num_chunks);
+};
+
+#endif // PARALLEL_CSV_SPLITTER_H
@@ -0,0 +1,74 @@
+#include "RadixSort.h"
+
+#include <algorithm>
+#include <bit>
+#include <omp.h>
+
+RowOrder RadixSort::sortedOrder(const std::vector<int32_t>& keys) {
+    const size_t rows = keys.size();
+    RowOrder order(rows);
+    if (rows == 0) return order;
+
+    const auto [min, max] = std::minmax_element(keys.begin(), keys.end());
+    const int64_t base = *min;
+    const unsigned key_bits = unsigned(std::bit_width(uint64_t(int64_t(*max) - base)));
+    const unsigned passes = (key_bits + kMaxDigitBits - 1) / kMaxDigitBits;
+    const unsigned digit_bits = passes == 0 ? 0 : (key_bits + passes - 1) / passes;
+    const size_t buckets = size_t(1) << digit_bits;
+    const uint32_t digit_mask = uint32_t(buckets - 1);
+
+    // (key - min, row) pairs move between these and the scatter buffers every pass
+    std::vector<uint32_t> sort_keys(rows);
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < rows; i++) {
+        sort_keys[i] = uint32_t(int64_t(keys[i]) - base);
+        order[i] = uint32_t(i);
+    }
+    if (passes == 0) return order;
+
+    std::vector<uint32_t> scattered_keys(rows);
+    RowOrder scattered_order(rows);
+    std::vector<size_t> positions(size_t(omp_get_max_threads()) * buckets);
+
+    for (unsigned pass = 0; pass < passes; pass++) {
+        const unsigned shift = pass * digit_bits;
+
+        #pragma omp parallel
+        {
+            const size_t thread = size_t(omp_get_thread_num());
+            const size_t team = size_t(omp_get_num_threads());
+            const size_t begin = rows * thread / team;
+            const size_t end = rows * (thread + 1) / team;
+            size_t* histogram = positions.data() + thread * buckets;
+
+            std::fill(histogram, histogram + buckets, 0);
+            for (size_t i = begin; i < end; i++) {
+                histogram[(sort_keys[i] >> shift) & digit_mask]++;
+            }
+            #pragma omp barrier
+
+            // Bucket by bucket, each thread's rows follow those of the threads before it
+            #pragma omp single
+            {
+                size_t next = 0;
+                for (size_t bucket = 0; bucket < buckets; bucket++) {
+                    for (size_t t = 0; t < team; t++) {
+                        const size_t count = positions[t * buckets + bucket];
+                        positions[t * buckets + bucket] = next;
+                        next += count;
+                    }
+                }
+            }
+
+            for (size_t i = begin; i < end; i++) {
+                const size_t position = histogram[(sort_keys[i] >> shift) & digit_mask]++;
+                scattered_keys[position] = sort_keys[i];
+                scattered_order[position] = order[i];
+            }
+        }
+
+        sort_keys.swap(scattered_keys);
+        order.swap(scattered_order);
+    }
+    return order;
+}
@@ -0,0 +1,23 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include "RowOrder.h"
+
+#include <cstdint>
+#include <vector>
+
+// Parallel least-significant-digit radix sort producing a row order rather than moving the
+// rows, so one sort can reorder every column of a table.
+class RadixSort {
+public:
+    // Stable ascending order of keys. Keys are sorted as key - min, in as few digits of at most
+    // kMaxDigitBits as the key range needs: a dozen years of day numbers take two passes of
+    // 7 bits. Each pass builds per-thread histograms, prefix-sums them and scatters every
+    // thread's slice to its own precomputed positions.
+    static RowOrder sortedOrder(const std::vector<int32_t>& keys);
+
+private:
+    static constexpr unsigned kMaxDigitBits = 11;
+};
+
+#endif // RADIX_SORT_H
@@ -0,0 +1,361 @@
+#include "RangeCount.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define RANGE_COUNT_X86 1
+#endif
+
+namespace {
+
+template <typename T>
+bool inRange(T value, T low, T high) {
+    return value >= low && value <= high;
+}
+
+template <typename T>
+size_t countScalar(const T* values, size_t size, T low, T high) {
+    size_t matches = 0;
+    for (size_t i = 0; i < size; i++) matches += inRange(values[i], low, high);
+    return matches;
+}
+
+// Bits of the values [first, first + 64) that exist, first being a multiple of 64
+template <typename T>
+uint64_t selectScalar(const T* values, size_t first, size_t size, T low, T high) {
+    const size_t end = first + 64 < size ? first + 64 : size;
+    uint64_t bits = 0;
+    for (size_t i = first; i < end; i++) bits |= uint64_t(inRange(values[i], low, high)) << (i - first);
+    return bits;
+}
+
+#if defined(RANGE_COUNT_X86)
+// Every ISA provides a Matcher<T> whose match(at) returns one bit per lane (lane i -> bit i)
+// for the kLanes values at at. The integer matchers shift values by low and compare unsigned
+// against high - low: a lane matches when min(value - low, span) == value - low. 64-bit lanes
+// have no unsigned min below AVX-512, so they flip the sign bits and compare signed instead.
+
+template <typename T>
+struct Sse42Matcher {
+    static constexpr size_t kLanes = 16 / sizeof(T);
+    __m128i base, span;
+    __m128 lower, upper;
+
+    __attribute__((target("sse4.2"))) Sse42Matcher(T low, T high) {
+        if constexpr (std::is_same_v<T, float>) {
+            lower = _mm_set1_ps(low);
+            upper = _mm_set1_ps(high);
+        } else if constexpr (sizeof(T) == 1) {
+            base = _mm_set1_epi8(char(low));
+            span = _mm_set1_epi8(char(high - low));
+        } else if constexpr (sizeof(T) == 2) {
+            base = _mm_set1_epi16(short(low));
+            span = _mm_set1_epi16(short(high - low));
+        } else if constexpr (sizeof(T) == 4) {
+            base = _mm_set1_epi32(int(low));
+            span = _mm_set1_epi32(int(uint32_t(high) - uint32_t(low)));
+        } else {
+            base = _mm_set1_epi64x(low);
+            span = _mm_xor_si128(_mm_set1_epi64x(int64_t(uint64_t(high) - uint64_t(low))), _mm_set1_epi64x(INT64_MIN));
+        }
+    }
+
+    __attribute__((target("sse4.2"))) uint64_t match(const T* at) const {
+        if constexpr (std::is_same_v<T, float>) {
+            const __m128 v = _mm_loadu_ps(at);
+            return uint64_t(_mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(v, lower), _mm_cmple_ps(v, upper))));
+        } else {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(at));
+            if constexpr (sizeof(T) == 1) {
+                const __m128i shifted = _mm_sub_epi8(v, base);
+                return uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(shifted, span), shifted))));
+            } else if constexpr (sizeof(T) == 2) {
+                const __m128i shifted = _mm_sub_epi16(v, base);
+                const __m128i in_range = _mm_cmpeq_epi16(_mm_min_epu16(shifted, span), shifted);
+                return uint64_t(uint32_t(_mm_movemask_epi8(_mm_packs_epi16(in_range, in_range)) & 0xFF));
+            } else if constexpr (sizeof(T) == 4) {
+                const __m128i shifted = _mm_sub_epi32(v, base);
+                const __m128i in_range = _mm_cmpeq_epi32(_mm_min_epu32(shifted, span), shifted);
+                return uint64_t(_mm_movemask_ps(_mm_castsi128_ps(in_range)));
+            } else {
+                const __m128i shifted = _mm_xor_si128(_mm_sub_epi64(v, base), _mm_set1_epi64x(INT64_MIN));
+                return uint64_t(~_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(shifted, span))) & 0x3);
+            }
+        }
+    }
+};
+
+template <typename T>
+struct Avx2Matcher {
+    static constexpr size_t kLanes = 32 / sizeof(T);
+    __m256i base, span;
+    __m256 lower, upper;
+
+    __attribute__((target("avx2"))) Avx2Matcher(T low, T high) {
+        if constexpr (std::is_same_v<T, float>) {
+            lower = _mm256_set1_ps(low);
+            upper = _mm256_set1_ps(high);
+        } else if constexpr (sizeof(T) == 1) {
+            base = _mm256_set1_epi8(char(low));
+            span = _mm256_set1_epi8(char(high - low));
+        } else if constexpr (sizeof(T) == 2) {
+            base = _mm256_set1_epi16(short(low));
+            span = _mm256_set1_epi16(short(high - low));
+        } else if constexpr (sizeof(T) == 4) {
+            base = _mm256_set1_epi32(int(low));
+            span = _mm256_set1_epi32(int(uint32_t(high) - uint32_t(low)));
+        } else {
+            base = _mm256_set1_epi64x(low);
+            span = _mm256_xor_si256(_mm256_set1_epi64x(int64_t(uint64_t(high) - uint64_t(low))),
+                                    _mm256_set1_epi64x(INT64_MIN));
+        }
+    }
+
+    __attribute__((target("avx2"))) uint64_t match(const T* at) const {
+        if constexpr (std::is_same_v<T, float>) {
+            const __m256 v = _mm256_loadu_ps(at);
+            return uint64_t(_mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(v, lower, _CMP_GE_OQ),
+                                                             _mm256_cmp_ps(v, upper, _CMP_LE_OQ))));
+        } else {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(at));
+            if constexpr (sizeof(T) == 1) {
+                const __m256i shifted = _mm256_sub_epi8(v, base);
+                return uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(shifted, span), shifted))));
+            } else if constexpr (sizeof(T) == 2) {
+                // Narrow the 16-bit lane masks to bytes; packs works within 128-bit halves
+                const __m256i shifted = _mm256_sub_epi16(v, base);
+                const __m256i in_range = _mm256_cmpeq_epi16(_mm256_min_epu16(shifted, span), shifted);
+                const __m128i packed = _mm_packs_epi16(_mm256_castsi256_si128(in_range), _mm256_extracti128_si256(in_range, 1));
+                return uint64_t(uint32_t(_mm_movemask_epi8(packed)));
+            } else if constexpr (sizeof(T) == 4) {
+                const __m256i shifted = _mm256_sub_epi32(v, base);
+                const __m256i in_range = _mm256_cmpeq_epi32(_mm256_min_epu32(shifted, span), shifted);
+                return uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(in_range)));
+            } else {
+                const __m256i shifted = _mm256_xor_si256(_mm256_sub_epi64(v, base), _mm256_set1_epi64x(INT64_MIN));
+                return uint64_t(~_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(shifted, span))) & 0xF);
+            }
+        }
+    }
+};
+
+// AVX-512 compares straight into lane masks, with unsigned compares for every width
+template <typename T>
+struct Avx512Matcher {
+    static constexpr size_t kLanes = 64 / sizeof(T);
+    __m512i base, span;
+    __m512 lower, upper;
+
+    __attribute__((target("avx512f,avx512bw"))) Avx512Matcher(T low, T high) {
+        if constexpr (std::is_same_v<T, float>) {
+            lower = _mm512_set1_ps(low);
+            upper = _mm512_set1_ps(high);
+        } else if constexpr (sizeof(T) == 1) {
+            base = _mm512_set1_epi8(char(low));
+            span = _mm512_set1_epi8(char(high - low));
+        } else if constexpr (sizeof(T) == 2) {
+            base = _mm512_set1_epi16(short(low));
+            span = _mm512_set1_epi16(short(high - low));
+        } else if constexpr (sizeof(T) == 4) {
+            base = _mm512_set1_epi32(int(low));
+            span = _mm512_set1_epi32(int(uint32_t(high) - uint32_t(low)));
+        } else {
+            base = _mm512_set1_epi64(low);
+            span = _mm512_set1_epi64(int64_t(uint64_t(high) - uint64_t(low)));
+        }
+    }
+
+    __attribute__((target("avx512f,avx512bw"))) uint64_t match(const T* at) const {
+        if constexpr (std::is_same_v<T, float>) {
+            const __m512 v = _mm512_loadu_ps(at);
+            return uint64_t(_mm512_mask_cmp_ps_mask(_mm512_cmp_ps_mask(v, lower, _CMP_GE_OQ), v, upper, _CMP_LE_OQ));
+        } else {
+            const __m512i v = _mm512_loadu_si512(at);
+            if constexpr (sizeof(T) == 1) {
+                return uint64_t(_mm512_cmple_epu8_mask(_mm512_sub_epi8(v, base), span));
+            } else if constexpr (sizeof(T) == 2) {
+                return uint64_t(_mm512_cmple_epu16_mask(_mm512_sub_epi16(v, base), span));
+            } else if constexpr (sizeof(T) == 4) {
+                return uint64_t(_mm512_cmple_epu32_mask(_mm512_sub_epi32(v, base), span));
+            } else {
+                return uint64_t(_mm512_cmple_epu64_mask(_mm512_sub_epi64(v, base), span));
+            }
+        }
+    }
+};
+
+// Count and select loops per ISA, so the matcher inlines into code compiled for it
+template <typename T>
+__attribute__((target("sse4.2")))
+size_t countSse42(const T* values, size_t size, T low, T high) {
+    const Sse42Matcher<T> matcher(low, high);
+    size_t matches = 0, i = 0;
+    for (; i + matcher.kLanes <= size; i += matcher.kLanes) matches += size_t(std::popcount(matcher.match(values + i)));
+    return matches + countScalar(values + i, size - i, low, high);
+}
+
+template <typename T>
+__attribute__((target("sse4.2")))
+void selectSse42(const T* values, size_t size, T low, T high, uint64_t* words) {
+    const Sse42Matcher<T> matcher(low, high);
+    size_t word = 0;
+    for (; (word + 1) * 64 <= size; word++) {
+        uint64_t bits = 0;
+        for (size_t lane = 0; lane < 64; lane += matcher.kLanes) bits |= matcher.match(values + word * 64 + lane) << lane;
+        words[word] = bits;
+    }
+    if (word * 64 < size) words[word] = selectScalar(values, word * 64, size, low, high);
+}
+
+template <typename T>
+__attribute__((target("avx2")))
+size_t countAvx2(const T* values, size_t size, T low, T high) {
+    const Avx2Matcher<T> matcher(low, high);
+    size_t matches = 0, i = 0;
+    for (; i + matcher.kLanes <= size; i += matcher.kLanes) matches += size_t(std::popcount(matcher.match(values + i)));
+    return matches + countScalar(values + i, size - i, low, high);
+}
+
+template <typename T>
+__attribute__((target("avx2")))
+void selectAvx2(const T* values, size_t size, T low, T high, uint64_t* words) {
+    const Avx2Matcher<T> matcher(low, high);
+    size_t word = 0;
+    for (; (word + 1) * 64 <= size; word++) {
+        uint64_t bits = 0;
+        for (size_t lane = 0; lane < 64; lane += matcher.kLanes) bits |= matcher.match(values + word * 64 + lane) << lane;
+        words[word] = bits;
+    }
+    if (word * 64 < size) words[word] = selectScalar(values, word * 64, size, low, high);
+}
+
+template <typename T>
+__attribute__((target("avx512f,avx512bw")))
+size_t countAvx512(const T* values, size_t size, T low, T high) {
+    const Avx512Matcher<T> matcher(low, high);
+    size_t matches = 0, i = 0;
+    for (; i + matcher.kLanes <= size; i += matcher.kLanes) matches += size_t(std::popcount(matcher.match(values + i)));
+    return matches + countScalar(values + i, size - i, low, high);
+}
+
+template <typename T>
+__attribute__((target("avx512f,avx512bw")))
+void selectAvx512(const T* values, size_t size, T low, T high, uint64_t* words) {
+    const Avx512Matcher<T> matcher(low, high);
+    size_t word = 0;
+    for (; (word + 1) * 64 <= size; word++) {
+        uint64_t bits = 0;
+        for (size_t lane = 0; lane < 64; lane += matcher.kLanes) bits |= matcher.match(values + word * 64 + lane) << lane;
+        words[word] = bits;
+    }
+    if (word * 64 < size) words[word] = selectScalar(values, word * 64, size, low, high);
+}
+#endif
+
+template <typename T>
+void selectScalarWords(const T* values, size_t size, T low, T high, uint64_t* words) {
+    for (size_t word = 0; word * 64 < size; word++) words[word] = selectScalar(values, word * 64, size, low, high);
+}
+
+RangeCount::Isa pickIsa() {
+#if defined(RANGE_COUNT_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return RangeCount::Isa::Avx512;
+    if (__builtin_cpu_supports("avx2")) return RangeCount::Isa::Avx2;
+    if (__builtin_cpu_supports("sse4.2")) return RangeCount::Isa::Sse42;
+#endif
+    return RangeCount::Isa::Scalar;
+}
+
+template <typename T>
+size_t countWith(const T* values, size_t size, T low, T high, RangeCount::Isa isa) {
+    if (size == 0 || !(low <= high)) return 0;
+    if (!RangeCount::supported(isa)) isa = RangeCount::Isa::Scalar;
+    switch (isa) {
+#if defined(RANGE_COUNT_X86)
+        case RangeCount::Isa::Avx512: return countAvx512(values, size, low, high);
+        case RangeCount::Isa::Avx2: return countAvx2(values, size, low, high);
+        case RangeCount::Isa::Sse42: return countSse42(values, size, low, high);
+#endif
+        default: return countScalar(values, size, low, high);
+    }
+}
+
+template <typename T>
+void selectWith(const T* values, size_t size, T low, T high, uint64_t* words) {
+    if (size == 0) return;
+    if (!(low <= high)) {
+        std::fill(words, words + (size + 63) / 64, 0);
+        return;
+    }
+    switch (RangeCount::bestIsa()) {
+#if defined(RANGE_COUNT_X86)
+        case RangeCount::Isa::Avx512: return selectAvx512(values, size, low, high, words);
+        case RangeCount::Isa::Avx2: return selectAvx2(values, size, low, high, words);
+        case RangeCount::Isa::Sse42: return selectSse42(values, size, low, high, words);
+#endif
+        default: return selectScalarWords(values, size, low, high, words);
+    }
+}
+
+} // namespace
+
+RangeCount::Isa RangeCount::bestIsa() {
+    static const Isa picked = pickIsa();
+    return picked;
+}
+
+bool RangeCount::supported(Isa isa) {
+    return int(isa) <= int(bestIsa());
+}
+
+const char* RangeCount::isaName(Isa isa) {
+    switch (isa) {
+        case Isa::Avx512: return "AVX-512";
+        case Isa::Avx2: return "AVX2";
+        case Isa::Sse42: return "SSE4.2";
+        default: return "scalar";
+    }
+}
+
+size_t RangeCount::countLanes(const int32_t* values, size_t size, int32_t low, int32_t high, Isa isa) {
+    return countWith(values, size, low, high, isa);
+}
+
+size_t RangeCount::countLanes(const int64_t* values, size_t size, int64_t low, int64_t high, Isa isa) {
+    return countWith(values, size, low, high, isa);
+}
+
+size_t RangeCount::countLanes(const float* values, size_t size, float low, float high, Isa isa) {
+    return countWith(values, size, low, high, isa);
+}
+
+size_t RangeCount::countLanes(const uint8_t* values, size_t size, uint8_t low, uint8_t high, Isa isa) {
+    return countWith(values, size, low, high, isa);
+}
+
+size_t RangeCount::countLanes(const uint16_t* values, size_t size, uint16_t low, uint16_t high, Isa isa) {
+    return countWith(values, size, low, high, isa);
+}
+
+void RangeCount::selectLanes(const int32_t* values, size_t size, int32_t low, int32_t high, uint64_t* words) {
+    selectWith(values, size, low, high, words);
+}
+
+void RangeCount::selectLanes(const int64_t* values, size_t size, int64_t low, int64_t high, uint64_t* words) {
+    selectWith(values, size, low, high, words);
+}
+
+void RangeCount::selectLanes(const float* values, size_t size, float low, float high, uint64_t* words) {
+    selectWith(values, size, low, high, words);
+}
+
+void RangeCount::selectLanes(const uint8_t* values, size_t size, uint8_t low, uint8_t high, uint64_t* words) {
+    selectWith(values, size, low, high, words);
+}
+
+void RangeCount::selectLanes(const uint16_t* values, size_t size, uint16_t low, uint16_t high, uint64_t* words) {
+    selectWith(values, size, low, high, words);
+}
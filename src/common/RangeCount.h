@@ -0,0 +1,96 @@
+#ifndef RANGE_COUNT_H
+#define RANGE_COUNT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// "How many values lie in [low, high]" over a plain column, for 32/64-bit signed integers,
+// floats and packed uint8/uint16. AVX-512, AVX2, SSE4.2 and scalar kernels exist for each;
+// the best one the CPU supports is picked once at startup. Integer kernels test
+// (value - low) <= (high - low) as an unsigned compare, so a range costs one compare per lane.
+class RangeCount {
+public:
+    enum class Isa { Scalar, Sse42, Avx2, Avx512 };
+
+    // Values of [0, size) with low <= value <= high (NaN never matches), with the startup
+    // kernel or with a given instruction set; an unsupported isa runs the scalar kernel
+    template <typename T>
+    static size_t count(const T* values, size_t size, T low, T high) {
+        return count(values, size, low, high, bestIsa());
+    }
+    template <typename T>
+    static size_t count(const T* values, size_t size, T low, T high, Isa isa) {
+        using Lane = LaneType<T>;
+        static_assert(sizeof(Lane) == sizeof(T), "RangeCount kernels cover int32, int64, float, uint8 and uint16");
+        return countLanes(reinterpret_cast<const Lane*>(values), size, Lane(low), Lane(high), isa);
+    }
+
+    // Sets bit i % 64 of words[i / 64] for each value i of [0, size) in range and clears the
+    // others; words holds (size + 63) / 64 entries
+    template <typename T>
+    static void select(const T* values, size_t size, T low, T high, uint64_t* words) {
+        using Lane = LaneType<T>;
+        static_assert(sizeof(Lane) == sizeof(T), "RangeCount kernels cover int32, int64, float, uint8 and uint16");
+        selectLanes(reinterpret_cast<const Lane*>(values), size, Lane(low), Lane(high), words);
+    }
+
+    // Same over a whole column, split across OpenMP threads
+    template <typename T>
+    static size_t countColumn(const std::vector<T>& values, T low, T high) {
+        const size_t chunks = (values.size() + kChunkValues - 1) / kChunkValues;
+        const Isa isa = bestIsa();
+        size_t matches = 0;
+        #pragma omp parallel for schedule(static) reduction(+:matches)
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            const size_t begin = chunk * kChunkValues;
+            const size_t end = begin + kChunkValues < values.size() ? begin + kChunkValues : values.size();
+            matches += count(values.data() + begin, end - begin, low, high, isa);
+        }
+        return matches;
+    }
+
+    // Row mask of a whole column (see select), split across OpenMP threads
+    template <typename T>
+    static std::vector<uint64_t> selectColumn(const std::vector<T>& values, T low, T high) {
+        std::vector<uint64_t> words((values.size() + 63) / 64);
+        const size_t chunks = (values.size() + kChunkValues - 1) / kChunkValues;
+        #pragma omp parallel for schedule(static)
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            const size_t begin = chunk * kChunkValues;
+            const size_t end = begin + kChunkValues < values.size() ? begin + kChunkValues : values.size();
+            select(values.data() + begin, end - begin, low, high, words.data() + begin / 64);
+        }
+        return words;
+    }
+
+    // The instruction set count uses, and what this CPU can run
+    static Isa bestIsa();
+    static bool supported(Isa isa);
+    static const char* isaName(Isa isa);
+
+private:
+    static constexpr size_t kChunkValues = 65536;
+
+    // Kernel element type for T: int/long/time_t map onto int32_t/int64_t
+    template <typename T>
+    using LaneType = std::conditional_t<
+        std::is_floating_point_v<T>, float,
+        std::conditional_t<std::is_signed_v<T>,
+                           std::conditional_t<sizeof(T) == 4, int32_t, int64_t>,
+                           std::conditional_t<sizeof(T) == 1, uint8_t, uint16_t>>>;
+
+    static size_t countLanes(const int32_t* values, size_t size, int32_t low, int32_t high, Isa isa);
+    static size_t countLanes(const int64_t* values, size_t size, int64_t low, int64_t high, Isa isa);
+    static size_t countLanes(const float* values, size_t size, float low, float high, Isa isa);
+    static size_t countLanes(const uint8_t* values, size_t size, uint8_t low, uint8_t high, Isa isa);
+    static size_t countLanes(const uint16_t* values, size_t size, uint16_t low, uint16_t high, Isa isa);
+    static void selectLanes(const int32_t* values, size_t size, int32_t low, int32_t high, uint64_t* words);
+    static void selectLanes(const int64_t* values, size_t size, int64_t low, int64_t high, uint64_t* words);
+    static void selectLanes(const float* values, size_t size, float low, float high, uint64_t* words);
+    static void selectLanes(const uint8_t* values, size_t size, uint8_t low, uint8_t high, uint64_t* words);
+    static void selectLanes(const uint16_t* values, size_t size, uint16_t low, uint16_t high, uint64_t* words);
+};
+
+#endif // RANGE_COUNT_H
@@ -0,0 +1,329 @@
+#include "RowBitmap.h"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <omp.h>
+
+namespace {
+
+using Container = RowBitmap::Container;
+
+constexpr size_t kContainerRows = 65536;
+constexpr size_t kContainerWords = kContainerRows / 64;
+
+// An array this many times longer than the other is searched, not merged
+constexpr size_t kGallopRatio = 32;
+
+bool testBit(const std::vector<uint64_t>& bits, uint16_t value) {
+    return (bits[value / 64] >> (value % 64)) & 1;
+}
+
+// Recounts a bitset and turns it into an array when that is smaller
+void normalize(Container& container) {
+    if (!container.isBitset()) {
+        container.cardinality = uint32_t(container.values.size());
+        if (container.cardinality > RowBitmap::kArrayLimit) {
+            container.bits.assign(kContainerWords, 0);
+            for (uint16_t value : container.values) container.bits[value / 64] |= uint64_t(1) << (value % 64);
+            std::vector<uint16_t>().swap(container.values);
+        }
+        return;
+    }
+    uint32_t cardinality = 0;
+    for (uint64_t word : container.bits) cardinality += uint32_t(std::popcount(word));
+    container.cardinality = cardinality;
+    if (cardinality > RowBitmap::kArrayLimit) return;
+    container.values.reserve(cardinality);
+    for (size_t word = 0; word < kContainerWords; word++) {
+        for (uint64_t bits = container.bits[word]; bits != 0; bits &= bits - 1) {
+            container.values.push_back(uint16_t(word * 64 + size_t(std::countr_zero(bits))));
+        }
+    }
+    std::vector<uint64_t>().swap(container.bits);
+}
+
+// Values of small also in large, found by exponential then binary search from the last hit
+template <typename Emit>
+void gallop(const std::vector<uint16_t>& small, const std::vector<uint16_t>& large, Emit emit) {
+    auto position = large.begin();
+    for (uint16_t value : small) {
+        size_t step = 1;
+        auto bound = position;
+        while (bound != large.end() && *bound < value) {
+            position = bound;
+            bound = size_t(large.end() - bound) > step ? bound + ptrdiff_t(step) : large.end();
+            step *= 2;
+        }
+        position = std::lower_bound(position, bound, value);
+        if (position == large.end()) return;
+        if (*position == value) emit(value);
+    }
+}
+
+template <typename Emit>
+void intersectArrays(const std::vector<uint16_t>& a, const std::vector<uint16_t>& b, Emit emit) {
+    const std::vector<uint16_t>& small = a.size() <= b.size() ? a : b;
+    const std::vector<uint16_t>& large = a.size() <= b.size() ? b : a;
+    if (large.size() > small.size() * kGallopRatio) {
+        gallop(small, large, emit);
+        return;
+    }
+    for (size_t i = 0, j = 0; i < small.size() && j < large.size();) {
+        if (small[i] < large[j]) {
+            i++;
+        } else if (large[j] < small[i]) {
+            j++;
+        } else {
+            emit(small[i]);
+            i++;
+            j++;
+        }
+    }
+}
+
+Container intersectContainers(const Container& a, const Container& b) {
+    Container result;
+    if (a.isBitset() && b.isBitset()) {
+        result.bits.resize(kContainerWords);
+        for (size_t word = 0; word < kContainerWords; word++) result.bits[word] = a.bits[word] & b.bits[word];
+    } else if (a.isBitset() || b.isBitset()) {
+        const Container& array = a.isBitset() ? b : a;
+        const Container& bitset = a.isBitset() ? a : b;
+        for (uint16_t value : array.values) {
+            if (testBit(bitset.bits, value)) result.values.push_back(value);
+        }
+    } else {
+        intersectArrays(a.values, b.values, [&](uint16_t value) { result.values.push_back(value); });
+    }
+    normalize(result);
+    return result;
+}
+
+size_t intersectContainerCount(const Container& a, const Container& b) {
+    size_t count = 0;
+    if (a.isBitset() && b.isBitset()) {
+        for (size_t word = 0; word < kContainerWords; word++) count += size_t(std::popcount(a.bits[word] & b.bits[word]));
+    } else if (a.isBitset() || b.isBitset()) {
+        const Container& array = a.isBitset() ? b : a;
+        const Container& bitset = a.isBitset() ? a : b;
+        for (uint16_t value : array.values) count += testBit(bitset.bits, value);
+    } else {
+        intersectArrays(a.values, b.values, [&](uint16_t) { count++; });
+    }
+    return count;
+}
+
+Container uniteContainers(const Container& a, const Container& b) {
+    Container result;
+    if (a.isBitset() || b.isBitset()) {
+        result.bits = a.isBitset() ? a.bits : b.bits;
+        if (a.isBitset() && b.isBitset()) {
+            for (size_t word = 0; word < kContainerWords; word++) result.bits[word] |= b.bits[word];
+        } else {
+            for (uint16_t value : (a.isBitset() ? b : a).values) result.bits[value / 64] |= uint64_t(1) << (value % 64);
+        }
+    } else {
+        result.values.reserve(a.values.size() + b.values.size());
+        std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                       std::back_inserter(result.values));
+    }
+    normalize(result);
+    return result;
+}
+
+Container subtractContainers(const Container& a, const Container& b) {
+    Container result;
+    if (a.isBitset()) {
+        result.bits = a.bits;
+        if (b.isBitset()) {
+            for (size_t word = 0; word < kContainerWords; word++) result.bits[word] &= ~b.bits[word];
+        } else {
+            for (uint16_t value : b.values) result.bits[value / 64] &= ~(uint64_t(1) << (value % 64));
+        }
+    } else if (b.isBitset()) {
+        for (uint16_t value : a.values) {
+            if (!testBit(b.bits, value)) result.values.push_back(value);
+        }
+    } else {
+        std::set_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                            std::back_inserter(result.values));
+    }
+    normalize(result);
+    return result;
+}
+
+} // namespace
+
+RowBitmap RowBitmap::fromWords(const std::vector<uint64_t>& words) {
+    RowBitmap bitmap;
+    const size_t keys = (words.size() + kContainerWords - 1) / kContainerWords;
+    std::vector<Container> built(keys);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t key = 0; key < keys; key++) {
+        Container& container = built[key];
+        container.key = uint16_t(key);
+        const size_t first = key * kContainerWords;
+        const size_t last = std::min(words.size(), first + kContainerWords);
+        container.bits.assign(kContainerWords, 0);
+        std::copy(words.begin() + ptrdiff_t(first), words.begin() + ptrdiff_t(last), container.bits.begin());
+        normalize(container);
+    }
+    for (Container& container : built) {
+        if (container.cardinality == 0) continue;
+        bitmap.row_count += container.cardinality;
+        bitmap.containers.push_back(std::move(container));
+    }
+    return bitmap;
+}
+
+RowBitmap RowBitmap::fromRows(std::vector<uint32_t> rows) {
+    RowBitmap bitmap;
+    if (!std::is_sorted(rows.begin(), rows.end())) std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    for (size_t i = 0; i < rows.size();) {
+        Container container;
+        container.key = uint16_t(rows[i] >> 16);
+        for (; i < rows.size() && (rows[i] >> 16) == container.key; i++) {
+            container.values.push_back(uint16_t(rows[i]));
+        }
+        normalize(container);
+        bitmap.row_count += container.cardinality;
+        bitmap.containers.push_back(std::move(container));
+    }
+    return bitmap;
+}
+
+RowBitmap RowBitmap::range(uint32_t first, uint32_t last) {
+    RowBitmap bitmap;
+    if (first >= last) return bitmap;
+    for (uint32_t key = first >> 16; key <= (last - 1) >> 16; key++) {
+        const uint32_t begin = std::max(first, key << 16) & 0xFFFF;
+        const uint32_t end = std::min<uint64_t>(last, uint64_t(key + 1) << 16) - (uint64_t(key) << 16);
+        Container container;
+        container.key = uint16_t(key);
+        if (end - begin <= kArrayLimit) {
+            for (uint32_t value = begin; value < end; value++) container.values.push_back(uint16_t(value));
+        } else {
+            container.bits.assign(kContainerWords, 0);
+            for (uint32_t value = begin; value < end; value++) container.bits[value / 64] |= uint64_t(1) << (value % 64);
+        }
+        container.cardinality = end - begin;
+        bitmap.row_count += container.cardinality;
+        bitmap.containers.push_back(std::move(container));
+    }
+    return bitmap;
+}
+
+template <typename Combine>
+RowBitmap RowBitmap::combine(const RowBitmap& other, bool only_left, bool only_right, Combine combine_pair) const {
+    // Merge the key lists first, so the container work can run in parallel
+    struct Pair {
+        const Container* left;
+        const Container* right;
+    };
+    std::vector<Pair> pairs;
+    size_t i = 0, j = 0;
+    while (i < containers.size() || j < other.containers.size()) {
+        if (j == other.containers.size() || (i < containers.size() && containers[i].key < other.containers[j].key)) {
+            if (only_left) pairs.push_back({&containers[i], nullptr});
+            i++;
+        } else if (i == containers.size() || other.containers[j].key < containers[i].key) {
+            if (only_right) pairs.push_back({nullptr, &other.containers[j]});
+            j++;
+        } else {
+            pairs.push_back({&containers[i], &other.containers[j]});
+            i++;
+            j++;
+        }
+    }
+
+    std::vector<Container> combined(pairs.size());
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t p = 0; p < pairs.size(); p++) {
+        if (pairs[p].left && pairs[p].right) {
+            combined[p] = combine_pair(*pairs[p].left, *pairs[p].right);
+            combined[p].key = pairs[p].left->key;
+        } else {
+            combined[p] = pairs[p].left ? *pairs[p].left : *pairs[p].right;
+        }
+    }
+
+    RowBitmap result;
+    for (Container& container : combined) {
+        if (container.cardinality == 0) continue;
+        result.row_count += container.cardinality;
+        result.containers.push_back(std::move(container));
+    }
+    return result;
+}
+
+RowBitmap RowBitmap::intersect(const RowBitmap& other) const {
+    return combine(other, false, false, intersectContainers);
+}
+
+RowBitmap RowBitmap::unite(const RowBitmap& other) const {
+    return combine(other, true, true, uniteContainers);
+}
+
+RowBitmap RowBitmap::subtract(const RowBitmap& other) const {
+    return combine(other, true, false, subtractContainers);
+}
+
+size_t RowBitmap::intersectCount(const RowBitmap& other) const {
+    size_t count = 0;
+    for (size_t i = 0, j = 0; i < containers.size() && j < other.containers.size();) {
+        if (containers[i].key < other.containers[j].key) {
+            i++;
+        } else if (other.containers[j].key < containers[i].key) {
+            j++;
+        } else {
+            count += intersectContainerCount(containers[i++], other.containers[j++]);
+        }
+    }
+    return count;
+}
+
+bool RowBitmap::contains(uint32_t row) const {
+    const uint16_t key = uint16_t(row >> 16);
+    auto container = std::lower_bound(containers.begin(), containers.end(), key,
+                                      [](const Container& c, uint16_t k) { return c.key < k; });
+    if (container == containers.end() || container->key != key) return false;
+    if (container->isBitset()) return testBit(container->bits, uint16_t(row));
+    return std::binary_search(container->values.begin(), container->values.end(), uint16_t(row));
+}
+
+std::vector<uint32_t> RowBitmap::rows() const {
+    // Each container writes its own slice, found from the cardinalities before it
+    std::vector<size_t> offsets(containers.size() + 1, 0);
+    for (size_t c = 0; c < containers.size(); c++) offsets[c + 1] = offsets[c] + containers[c].cardinality;
+    std::vector<uint32_t> result(row_count);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t c = 0; c < containers.size(); c++) {
+        const Container& container = containers[c];
+        const uint32_t high = uint32_t(container.key) << 16;
+        uint32_t* out = result.data() + offsets[c];
+        if (container.isBitset()) {
+            for (size_t word = 0; word < kContainerWords; word++) {
+                for (uint64_t bits = container.bits[word]; bits != 0; bits &= bits - 1) {
+                    *out++ = high | uint32_t(word * 64 + size_t(std::countr_zero(bits)));
+                }
+            }
+        } else {
+            for (uint16_t value : container.values) *out++ = high | value;
+        }
+    }
+    return result;
+}
+
+size_t RowBitmap::memoryBytes() const {
+    size_t bytes = containers.capacity() * sizeof(Container);
+    for (const Container& container : containers) {
+        bytes += container.values.capacity() * sizeof(uint16_t) + container.bits.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+size_t RowBitmap::arrayContainers() const {
+    return size_t(std::count_if(containers.begin(), containers.end(), [](const Container& c) { return !c.isBitset(); }));
+}
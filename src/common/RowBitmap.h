@@ -0,0 +1,63 @@
+#ifndef ROW_BITMAP_H
+#define ROW_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Compressed set of row numbers, Roaring style: rows are split into containers of 65536 by
+// their high 16 bits, and each container keeps its low 16 bits either as a sorted array (up
+// to kArrayLimit rows, 2 bytes a row) or as a 65536-bit bitset (8 KB). Containers with no
+// rows are not stored. AND/OR/ANDNOT work container by container, picking merge, galloping
+// search, bit tests or word operations by the two containers' kinds, so a selective filter
+// combines at the cost of its few rows rather than of the table.
+class RowBitmap {
+public:
+    // Above this many rows a bitset is smaller than an array
+    static constexpr size_t kArrayLimit = 4096;
+
+    // Rows whose bit is set: bit i % 64 of words[i / 64] is row i (the RangeCount::select
+    // and GeoDistance::selectWithin layout). Containers are built in parallel.
+    static RowBitmap fromWords(const std::vector<uint64_t>& words);
+    // Rows in any order; duplicates are dropped
+    static RowBitmap fromRows(std::vector<uint32_t> rows);
+    // Rows first..last - 1
+    static RowBitmap range(uint32_t first, uint32_t last);
+
+    [[nodiscard]] RowBitmap intersect(const RowBitmap& other) const;  // AND
+    [[nodiscard]] RowBitmap unite(const RowBitmap& other) const;      // OR
+    [[nodiscard]] RowBitmap subtract(const RowBitmap& other) const;   // AND NOT
+    // Cardinality of intersect(other), without building it
+    [[nodiscard]] size_t intersectCount(const RowBitmap& other) const;
+
+    [[nodiscard]] size_t cardinality() const { return row_count; }
+    [[nodiscard]] bool empty() const { return row_count == 0; }
+    [[nodiscard]] bool contains(uint32_t row) const;
+    // Rows in ascending order
+    [[nodiscard]] std::vector<uint32_t> rows() const;
+
+    // Heap bytes of the containers, and how many are of each kind
+    [[nodiscard]] size_t memoryBytes() const;
+    [[nodiscard]] size_t arrayContainers() const;
+    [[nodiscard]] size_t bitsetContainers() const { return containers.size() - arrayContainers(); }
+
+    struct Container {
+        uint16_t key = 0;           // high 16 bits of the rows
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> values;  // sorted low bits, when cardinality <= kArrayLimit
+        std::vector<uint64_t> bits;    // 1024 words otherwise
+
+        [[nodiscard]] bool isBitset() const { return !bits.empty(); }
+    };
+
+private:
+    // Pairs up the containers of both sides by key and combines each pair (in parallel);
+    // only_left/only_right say whether a key found on one side alone is kept
+    template <typename Combine>
+    RowBitmap combine(const RowBitmap& other, bool only_left, bool only_right, Combine combine_pair) const;
+
+    std::vector<Container> containers;  // ascending keys, none empty
+    size_t row_count = 0;
+};
+
+#endif // ROW_BITMAP_H
@@ -0,0 +1,25 @@
+#ifndef ROW_ORDER_H
+#define ROW_ORDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// A new order for the rows of a table: row i of every reordered column is row order[i] of the
+// original. Applying one order to every column keeps the rows of the table aligned.
+using RowOrder = std::vector<uint32_t>;
+
+// Gathers values into order in parallel; an empty (not loaded) column stays empty
+template <typename T>
+void applyRowOrder(std::vector<T>& values, const RowOrder& order) {
+    if (values.empty()) return;
+    std::vector<T> reordered(order.size());
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < order.size(); i++) {
+        reordered[i] = std::move(values[order[i]]);
+    }
+    values = std::move(reordered);
+}
+
+#endif // ROW_ORDER_H
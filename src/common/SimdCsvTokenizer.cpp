@@ -0,0 +1,215 @@
+#include "SimdCsvTokenizer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define CSV_TOKENIZER_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define CSV_TOKENIZER_NEON 1
+#endif
+
+namespace {
+
+struct BlockMasks {
+    uint64_t comma;
+    uint64_t newline;
+    uint64_t quote;
+};
+
+using ClassifyFn = BlockMasks (*)(const char*);
+
+BlockMasks classifyScalar(const char* p) {
+    BlockMasks masks = {0, 0, 0};
+    for (size_t i = 0; i < SimdCsvTokenizer::kBlockSize; i++) {
+        masks.comma |= uint64_t(p[i] == ',') << i;
+        masks.newline |= uint64_t(p[i] == '\n') << i;
+        masks.quote |= uint64_t(p[i] == '"') << i;
+    }
+    return masks;
+}
+
+#if defined(CSV_TOKENIZER_X86)
+__attribute__((target("avx2")))
+BlockMasks classifyAvx2(const char* p) {
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i quote = _mm256_set1_epi8('"');
+
+    BlockMasks masks;
+    masks.comma = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, comma))) |
+                  uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, comma)))) << 32;
+    masks.newline = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, newline))) |
+                    uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, newline)))) << 32;
+    masks.quote = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, quote))) |
+                  uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, quote)))) << 32;
+    return masks;
+}
+
+__attribute__((target("sse4.2")))
+BlockMasks classifySse42(const char* p) {
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i quote = _mm_set1_epi8('"');
+
+    BlockMasks masks = {0, 0, 0};
+    for (int lane = 0; lane < 4; lane++) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + lane * 16));
+        masks.comma |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, comma)))) << (lane * 16);
+        masks.newline |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)))) << (lane * 16);
+        masks.quote |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)))) << (lane * 16);
+    }
+    return masks;
+}
+#endif
+
+#if defined(CSV_TOKENIZER_NEON)
+inline uint64_t neonMovemask(uint8x16_t matches) {
+    static const uint8_t bit_weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t weighted = vandq_u8(matches, vld1q_u8(bit_weights));
+    return uint64_t(vaddv_u8(vget_low_u8(weighted))) | uint64_t(vaddv_u8(vget_high_u8(weighted))) << 8;
+}
+
+BlockMasks classifyNeon(const char* p) {
+    const uint8x16_t comma = vdupq_n_u8(',');
+    const uint8x16_t newline = vdupq_n_u8('\n');
+    const uint8x16_t quote = vdupq_n_u8('"');
+
+    BlockMasks masks = {0, 0, 0};
+    for (int lane = 0; lane < 4; lane++) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p + lane * 16));
+        masks.comma |= neonMovemask(vceqq_u8(chunk, comma)) << (lane * 16);
+        masks.newline |= neonMovemask(vceqq_u8(chunk, newline)) << (lane * 16);
+        masks.quote |= neonMovemask(vceqq_u8(chunk, quote)) << (lane * 16);
+    }
+    return masks;
+}
+#endif
+
+struct Classifier {
+    ClassifyFn classify;
+    const char* name;
+};
+
+Classifier pickClassifier() {
+#if defined(CSV_TOKENIZER_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return {classifyAvx2, "AVX2"};
+    if (__builtin_cpu_supports("sse4.2")) return {classifySse42, "SSE4.2"};
+#elif defined(CSV_TOKENIZER_NEON)
+    return {classifyNeon, "NEON"};
+#endif
+    return {classifyScalar, "scalar"};
+}
+
+const Classifier& classifier() {
+    static const Classifier picked = pickClassifier();
+    return picked;
+}
+
+// Bit i of the result is the XOR of bits 0..i, i.e. set while inside a quoted field
+inline uint64_t prefixXor(uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+inline void storeField(SimdCsvTokenizer::Fields& fields, size_t& count, size_t limit, const char* begin, const char* end) {
+    if (count >= limit) return;
+    fields[count++] = SimdCsvTokenizer::fieldView(begin, end);
+}
+
+} // namespace
+
+SimdCsvTokenizer::SimdCsvTokenizer(const char* begin, const char* end, bool in_quotes)
+    : data_end(end), block(begin), cursor(begin), quote_carry(in_quotes ? ~uint64_t(0) : 0) {
+    if (begin < end) {
+        loadBlock(begin);
+    }
+}
+
+void SimdCsvTokenizer::loadBlock(const char* at) {
+    block = at;
+    const char* bytes = at;
+    alignas(64) char tail[kBlockSize];
+    if (size_t(data_end - at) < kBlockSize) {
+        // Zero padding matches none of the structural characters
+        std::memset(tail, 0, kBlockSize);
+        std::memcpy(tail, at, data_end - at);
+        bytes = tail;
+    }
+
+    const BlockMasks masks = classifier().classify(bytes);
+    const uint64_t inside_quotes = prefixXor(masks.quote) ^ quote_carry;
+    quote_carry = uint64_t(int64_t(inside_quotes) >> 63);
+    structurals = (masks.comma | masks.newline) & ~inside_quotes;
+}
+
+size_t SimdCsvTokenizer::nextRow(Fields& fields, size_t field_limit) {
+    if (cursor >= data_end) return 0;
+    field_limit = std::min(std::max(field_limit, size_t(1)), kMaxFields);
+
+    size_t count = 0;
+    const char* field_start = cursor;
+    while (true) {
+        while (structurals == 0) {
+            if (block + kBlockSize >= data_end) {
+                // Last row of the range has no trailing newline
+                storeField(fields, count, field_limit, field_start, data_end);
+                cursor = data_end;
+                return count;
+            }
+            loadBlock(block + kBlockSize);
+        }
+
+        const char* separator = block + __builtin_ctzll(structurals);
+        structurals &= structurals - 1;
+        storeField(fields, count, field_limit, field_start, separator);
+        if (*separator == '\n') {
+            cursor = separator + 1;
+            return count;
+        }
+        field_start = separator + 1;
+    }
+}
+
+const char* SimdCsvTokenizer::findRowStart(const char* from, const char* end, bool in_quotes) {
+    // A row starts right after an unquoted newline
+    if (from >= end || (!in_quotes && from[-1] == '\n')) return std::min(from, end);
+
+    SimdCsvTokenizer scan(from, end, in_quotes);
+    while (true) {
+        while (scan.structurals == 0) {
+            if (scan.block + kBlockSize >= end) return end;
+            scan.loadBlock(scan.block + kBlockSize);
+        }
+        const char* separator = scan.block + __builtin_ctzll(scan.structurals);
+        scan.structurals &= scan.structurals - 1;
+        if (*separator == '\n') return separator + 1;
+    }
+}
+
+size_t SimdCsvTokenizer::countQuotes(const char* begin, const char* end) {
+    const ClassifyFn classify = classifier().classify;
+    size_t quotes = 0;
+    const char* block = begin;
+    for (; end - block >= std::ptrdiff_t(kBlockSize); block += kBlockSize) {
+        quotes += __builtin_popcountll(classify(block).quote);
+    }
+    for (; block < end; block++) {
+        quotes += (*block == '"');
+    }
+    return quotes;
+}
+
+const char* SimdCsvTokenizer::isaName() {
+    return classifier().name;
+}
@@ -0,0 +1,61 @@
+#ifndef SIMD_CSV_TOKENIZER_H
+#define SIMD_CSV_TOKENIZER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Splits CSV rows using a structural index built 64 bytes at a time.
+// Each block is classified with AVX2 / SSE4.2 (x86-64) or NEON (arm64) compares into
+// bitmasks of ',', '\n' and '"'. Separators inside quoted fields are masked out with a
+// prefix-XOR over the quote bits, so a row is split in one pass without a per-byte branch.
+class SimdCsvTokenizer {
+public:
+    static constexpr size_t kBlockSize = 64;
+    static constexpr size_t kMaxFields = 32;
+    using Fields = std::array<std::string_view, kMaxFields>;
+
+    // Tokenizes [begin, end). in_quotes is the quote state at begin.
+    SimdCsvTokenizer(const char* begin, const char* end, bool in_quotes = false);
+
+    // Splits the next row into fields (surrounding quotes and a trailing '\r' stripped).
+    // Only the first field_limit fields are stored; the rest of the row is skipped.
+    // Returns the number of fields stored, or 0 once the range is exhausted.
+    size_t nextRow(Fields& fields, size_t field_limit = kMaxFields);
+
+    // Field between two separators as nextRow stores it: a trailing '\r' and surrounding
+    // quotes stripped
+    static std::string_view fieldView(const char* begin, const char* end) {
+        if (end > begin && end[-1] == '\r') end--;
+        if (end - begin >= 2 && *begin == '"' && end[-1] == '"') {
+            begin++;
+            end--;
+        }
+        return std::string_view(begin, end - begin);
+    }
+
+    // Start of the next unread row
+    [[nodiscard]] const char* position() const { return cursor; }
+
+    // Start of the first row beginning at or after from, where in_quotes is the quote
+    // state at from. from must not be the first byte of the buffer.
+    static const char* findRowStart(const char* from, const char* end, bool in_quotes);
+
+    // Number of '"' bytes in [begin, end)
+    static size_t countQuotes(const char* begin, const char* end);
+
+    // Instruction set picked at startup to classify blocks
+    static const char* isaName();
+
+private:
+    const char* data_end;
+    const char* block;        // start of the block the masks below describe
+    const char* cursor;       // start of the next unread field
+    uint64_t structurals = 0; // unconsumed unquoted ',' and '\n' in the current block
+    uint64_t quote_carry = 0; // all ones if the current block ends inside quotes
+
+    void loadBlock(const char* at);
+};
+
+#endif // SIMD_CSV_TOKENIZER_H
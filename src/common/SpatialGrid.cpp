@@ -0,0 +1,176 @@
+#include "SpatialGrid.h"
+#include "RadixSort.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Cells whose nearest or farthest corner is this close (relatively) to the radius are tested
+// point by point, so float rounding in the kernel can never disagree with a whole-cell decision
+constexpr double kBoundaryMargin = 1e-5;
+
+constexpr int32_t kExcludedCell = std::numeric_limits<int32_t>::max();
+
+} // namespace
+
+int64_t SpatialGrid::latCell(double lat) const {
+    return int64_t(std::floor(lat / cell_size));
+}
+
+int64_t SpatialGrid::lonCell(double lon) const {
+    return int64_t(std::floor(lon / cell_size));
+}
+
+void SpatialGrid::build(const std::vector<float>& latitudes, const std::vector<float>& longitudes,
+                        double cell_degrees) {
+    *this = SpatialGrid();
+    const size_t rows = latitudes.size();
+    if (rows == 0 || longitudes.size() != rows) return;
+
+    // NaN or infinite coordinates are never within a radius, so they stay out of the grid
+    float min_lat = std::numeric_limits<float>::max(), max_lat = std::numeric_limits<float>::lowest();
+    float min_lon = std::numeric_limits<float>::max(), max_lon = std::numeric_limits<float>::lowest();
+    #pragma omp parallel for reduction(min:min_lat, min_lon) reduction(max:max_lat, max_lon)
+    for (size_t i = 0; i < rows; i++) {
+        if (!std::isfinite(latitudes[i]) || !std::isfinite(longitudes[i])) continue;
+        min_lat = std::min(min_lat, latitudes[i]);
+        max_lat = std::max(max_lat, latitudes[i]);
+        min_lon = std::min(min_lon, longitudes[i]);
+        max_lon = std::max(max_lon, longitudes[i]);
+    }
+    if (min_lat > max_lat) return;
+
+    // Cell ids must stay below kExcludedCell
+    cell_size = cell_degrees;
+    while (double(latCell(max_lat) - latCell(min_lat) + 1) * double(lonCell(max_lon) - lonCell(min_lon) + 1) >=
+           double(kExcludedCell)) {
+        cell_size *= 2;
+    }
+    first_lat_cell = latCell(min_lat);
+    first_lon_cell = lonCell(min_lon);
+    lat_cells = latCell(max_lat) - first_lat_cell + 1;
+    lon_cells = lonCell(max_lon) - first_lon_cell + 1;
+
+    std::vector<int32_t> ids(rows);
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < rows; i++) {
+        if (!std::isfinite(latitudes[i]) || !std::isfinite(longitudes[i])) {
+            ids[i] = kExcludedCell;
+            continue;
+        }
+        ids[i] = int32_t((latCell(latitudes[i]) - first_lat_cell) * lon_cells + (lonCell(longitudes[i]) - first_lon_cell));
+    }
+
+    // Points in cell order; excluded points sort last and are dropped
+    cell_rows = RadixSort::sortedOrder(ids);
+    applyRowOrder(ids, cell_rows);
+    const size_t points = size_t(std::lower_bound(ids.begin(), ids.end(), kExcludedCell) - ids.begin());
+    ids.resize(points);
+    cell_rows.resize(points);
+    cell_latitudes.resize(points);
+    cell_longitudes.resize(points);
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < points; i++) {
+        cell_latitudes[i] = latitudes[cell_rows[i]];
+        cell_longitudes[i] = longitudes[cell_rows[i]];
+    }
+
+    for (size_t i = 0; i < points; i++) {
+        if (i == 0 || ids[i] != ids[i - 1]) {
+            cell_ids.push_back(ids[i]);
+            cell_starts.push_back(uint32_t(i));
+        }
+    }
+    cell_starts.push_back(uint32_t(points));
+}
+
+template <typename FullCell, typename BoundaryCell>
+void SpatialGrid::visitCells(const GeoCircle& circle, GridScanStats& stats, FullCell full_cell,
+                             BoundaryCell boundary_cell) const {
+    stats = {};
+    if (cell_ids.empty() || circle.radius_squared < 0) return;
+
+    // Cell ranges of the circle's bounding box, clamped to the grid before converting to integers
+    auto clampCell = [&](double cell, int64_t first, int64_t count) {
+        return int64_t(std::clamp(std::floor(cell), double(first - 1), double(first + count)));
+    };
+    const int64_t lat_first = std::max(clampCell(circle.min_lat / cell_size, first_lat_cell, lat_cells), first_lat_cell);
+    const int64_t lat_last =
+        std::min(clampCell(circle.max_lat / cell_size, first_lat_cell, lat_cells), first_lat_cell + lat_cells - 1);
+    const int64_t lon_first = std::max(clampCell(circle.min_lon / cell_size, first_lon_cell, lon_cells), first_lon_cell);
+    const int64_t lon_last =
+        std::min(clampCell(circle.max_lon / cell_size, first_lon_cell, lon_cells), first_lon_cell + lon_cells - 1);
+    if (lat_first > lat_last || lon_first > lon_last) return;
+
+    const double lat = circle.lat, lon = circle.lon;
+    const double radius_squared = circle.radius_squared;
+    // Longitude scale at a point's latitude, as GeoDistance::contains computes it
+    auto lonScale = [&](double point_lat) { return circle.lon_scale + circle.lon_scale_slope * (point_lat - lat); };
+    for (int64_t lat_cell = lat_first; lat_cell <= lat_last; lat_cell++) {
+        // The cells of one grid row are contiguous in cell_ids
+        const int64_t row_base = (lat_cell - first_lat_cell) * lon_cells - first_lon_cell;
+        const int32_t last_id = int32_t(row_base + lon_last);
+        auto it = std::lower_bound(cell_ids.begin(), cell_ids.end(), int32_t(row_base + lon_first));
+        for (; it != cell_ids.end() && *it <= last_id; ++it) {
+            const size_t cell = size_t(it - cell_ids.begin());
+            const double south = double(lat_cell) * cell_size, north = south + cell_size;
+            const double west = double(*it - row_base) * cell_size, east = west + cell_size;
+
+            // The scale varies linearly across the cell, so its extremes are at the south and north edges
+            const double min_scale = std::max(0.0, std::min(lonScale(south), lonScale(north)));
+            const double max_scale = std::max(std::abs(lonScale(south)), std::abs(lonScale(north)));
+            const double near_dy = lat < south ? south - lat : (lat > north ? lat - north : 0);
+            const double near_dx = (lon < west ? west - lon : (lon > east ? lon - east : 0)) * min_scale;
+            const double far_dy = std::max(std::abs(lat - south), std::abs(lat - north));
+            const double far_dx = std::max(std::abs(lon - west), std::abs(lon - east)) * max_scale;
+            const size_t begin = cell_starts[cell], end = cell_starts[cell + 1];
+
+            stats.cells++;
+            if (near_dy * near_dy + near_dx * near_dx > radius_squared * (1 + kBoundaryMargin)) {
+                stats.skipped++;
+                continue;
+            }
+            if (far_dy * far_dy + far_dx * far_dx <= radius_squared * (1 - kBoundaryMargin)) {
+                stats.full++;
+                full_cell(begin, end);
+                continue;
+            }
+            stats.tested_points += end - begin;
+            boundary_cell(begin, end);
+        }
+    }
+}
+
+size_t SpatialGrid::countWithin(const GeoCircle& circle, GridScanStats& stats) const {
+    size_t count = 0;
+    visitCells(
+        circle, stats, [&](size_t begin, size_t end) { count += end - begin; },
+        [&](size_t begin, size_t end) {
+            count += GeoDistance::countWithin(cell_latitudes.data() + begin, cell_longitudes.data() + begin,
+                                              end - begin, circle);
+        });
+    return count;
+}
+
+std::vector<uint32_t> SpatialGrid::rowsWithin(const GeoCircle& circle, GridScanStats& stats) const {
+    std::vector<uint32_t> rows;
+    visitCells(
+        circle, stats,
+        [&](size_t begin, size_t end) {
+            rows.insert(rows.end(), cell_rows.begin() + ptrdiff_t(begin), cell_rows.begin() + ptrdiff_t(end));
+        },
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                if (GeoDistance::contains(circle, cell_latitudes[i], cell_longitudes[i])) rows.push_back(cell_rows[i]);
+            }
+        });
+    return rows;
+}
+
+size_t SpatialGrid::memoryBytes() const {
+    return cell_ids.capacity() * sizeof(int32_t) + cell_starts.capacity() * sizeof(uint32_t) +
+           (cell_latitudes.capacity() + cell_longitudes.capacity()) * sizeof(float) +
+           cell_rows.capacity() * sizeof(uint32_t);
+}
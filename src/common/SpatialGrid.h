@@ -0,0 +1,67 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "GeoDistance.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// What a radius query did with the grid cells it looked at
+struct GridScanStats {
+    size_t cells = 0;    // non-empty cells inside the query's bounding box
+    size_t skipped = 0;  // no point can be within the radius
+    size_t full = 0;     // every point is within the radius: counted from the cell size
+    size_t tested_points = 0;
+
+    [[nodiscard]] size_t tested() const { return cells - skipped - full; }
+};
+
+// Uniform lat/lon grid over the points of a table. Points are copied in cell order (only
+// non-empty cells are stored, so stray (0, 0) coordinates cost nothing), leaving the table's
+// own row order alone. A radius query visits the cells overlapping the circle's bounding
+// box, counts cells entirely inside the circle from their sizes, skips cells entirely
+// outside, and runs the GeoDistance kernel only over cells the boundary crosses.
+class SpatialGrid {
+public:
+    // ~550 m of latitude: a neighbourhood-sized query covers a few dozen cells
+    static constexpr double kDefaultCellDegrees = 0.005;
+
+    // Builds the grid in parallel. The cell size grows if the points' extent would need
+    // more than 2^31 cells.
+    void build(const std::vector<float>& latitudes, const std::vector<float>& longitudes,
+               double cell_degrees = kDefaultCellDegrees);
+
+    [[nodiscard]] bool empty() const { return cell_ids.empty(); }
+
+    // Points inside the circle; the same answer as GeoDistance::countWithin over the columns
+    [[nodiscard]] size_t countWithin(const GeoCircle& circle, GridScanStats& stats) const;
+
+    // Table rows of those points, in cell order (not sorted)
+    [[nodiscard]] std::vector<uint32_t> rowsWithin(const GeoCircle& circle, GridScanStats& stats) const;
+
+    // Heap bytes of the cell directory and the cell-ordered points
+    [[nodiscard]] size_t memoryBytes() const;
+
+private:
+    [[nodiscard]] int64_t latCell(double lat) const;
+    [[nodiscard]] int64_t lonCell(double lon) const;
+    // Calls full_cell(begin, end) for each cell inside the circle and boundary_cell(begin, end)
+    // for each cell the boundary crosses, with the cell's range of cell-ordered points
+    template <typename FullCell, typename BoundaryCell>
+    void visitCells(const GeoCircle& circle, GridScanStats& stats, FullCell full_cell, BoundaryCell boundary_cell) const;
+
+    double cell_size = kDefaultCellDegrees;
+    int64_t first_lat_cell = 0;
+    int64_t first_lon_cell = 0;
+    int64_t lat_cells = 0;
+    int64_t lon_cells = 0;
+
+    std::vector<int32_t> cell_ids;      // sorted ids of the non-empty cells: lat cell * lon_cells + lon cell
+    std::vector<uint32_t> cell_starts;  // points of cell_ids[c] are [cell_starts[c], cell_starts[c + 1])
+    std::vector<float> cell_latitudes;  // points in cell order
+    std::vector<float> cell_longitudes;
+    std::vector<uint32_t> cell_rows;    // table row of each point
+};
+
+#endif // SPATIAL_GRID_H
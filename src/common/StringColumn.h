@@ -0,0 +1,107 @@
+#ifndef STRING_COLUMN_H
+#define STRING_COLUMN_H
+
+#include "RowOrder.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Text column that either owns one std::string per row or, in zero-copy mode, stores each
+// row as a packed (offset, length) reference into a file mapping the owner keeps alive.
+class StringColumn {
+public:
+    StringColumn() = default;
+    explicit StringColumn(const char* mapping_base) : base(mapping_base) {}
+
+    [[nodiscard]] bool isZeroCopy() const { return base != nullptr; }
+    [[nodiscard]] size_t size() const { return isZeroCopy() ? refs.size() : strings.size(); }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    void reserve(size_t rows) {
+        if (isZeroCopy()) refs.reserve(rows);
+        else strings.reserve(rows);
+    }
+
+    // Zero-copy column over refs built with packRef, e.g. read back from a snapshot
+    static StringColumn fromRefs(const char* mapping_base, const uint64_t* packed_refs, size_t rows) {
+        StringColumn column(mapping_base);
+        column.refs.assign(packed_refs, packed_refs + rows);
+        return column;
+    }
+
+    // The per-row reference zero-copy mode stores: offset from the base and length
+    static uint64_t packRef(uint64_t offset, size_t length) {
+        return offset << kLengthBits | std::min<size_t>(length, kMaxLength);
+    }
+
+    // One past the last byte a packed ref points at, relative to the base
+    static uint64_t refEnd(uint64_t ref) {
+        return (ref >> kLengthBits) + (ref & kMaxLength);
+    }
+
+    // In zero-copy mode value must point into the mapping
+    void push_back(std::string_view value) {
+        if (isZeroCopy()) {
+            refs.push_back(packRef(uint64_t(value.data() - base), value.size()));
+        } else {
+            strings.emplace_back(value);
+        }
+    }
+
+    // Sizes the column for a parallel merge; threads then fill disjoint row ranges with moveSlice
+    void resize(size_t rows) {
+        if (isZeroCopy()) refs.resize(rows);
+        else strings.resize(rows);
+    }
+
+    // Moves part's rows to [offset, offset + part.size()) and frees part. Both columns must
+    // reference the same mapping (or both own their strings).
+    void moveSlice(StringColumn& part, size_t offset) {
+        if (isZeroCopy()) {
+            std::copy(part.refs.begin(), part.refs.end(), refs.begin() + offset);
+        } else {
+            std::move(part.strings.begin(), part.strings.end(), strings.begin() + offset);
+        }
+        part = StringColumn(part.base);
+    }
+
+    // Reorders the rows; in zero-copy mode only the references move
+    void permute(const RowOrder& order) {
+        if (isZeroCopy()) applyRowOrder(refs, order);
+        else applyRowOrder(strings, order);
+    }
+
+    [[nodiscard]] std::string_view operator[](size_t row) const {
+        if (!isZeroCopy()) return strings[row];
+        uint64_t ref = refs[row];
+        return std::string_view(base + (ref >> kLengthBits), ref & kMaxLength);
+    }
+
+    // Copies the row out; the only place zero-copy text gets materialized
+    [[nodiscard]] std::string materialize(size_t row) const { return std::string((*this)[row]); }
+
+    // Heap bytes held by the column (the mapping itself is not counted)
+    [[nodiscard]] size_t memoryBytes() const {
+        if (isZeroCopy()) return refs.capacity() * sizeof(uint64_t);
+        size_t bytes = strings.capacity() * sizeof(std::string);
+        for (const std::string& value : strings) {
+            // Short strings live inside the std::string object itself
+            if (value.capacity() > std::string().capacity()) bytes += value.capacity() + 1;
+        }
+        return bytes;
+    }
+
+private:
+    static constexpr int kLengthBits = 24;
+    static constexpr uint64_t kMaxLength = (uint64_t(1) << kLengthBits) - 1;
+
+    const char* base = nullptr;
+    std::vector<uint64_t> refs;
+    std::vector<std::string> strings;
+};
+
+#endif // STRING_COLUMN_H
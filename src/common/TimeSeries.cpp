@@ -0,0 +1,83 @@
+#include "TimeSeries.h"
+#include "DateParser.h"
+
+#include <algorithm>
+#include <omp.h>
+
+namespace {
+
+constexpr uint32_t kHoursPerDay = 24;
+constexpr uint32_t kMinutesPerHour = 60;
+
+// Adds the rows of the window to buckets; bucket_of(day offset, minutes) returns the bucket
+// index, or SIZE_MAX to skip the row. Templated so each bucket width gets its own loop.
+template <typename BucketOf>
+void countRows(const std::vector<int32_t>& days, const std::vector<uint16_t>& minutes, int32_t first_day,
+               int32_t last_day, std::vector<uint32_t>& buckets, BucketOf bucket_of) {
+    const size_t rows = std::min(days.size(), minutes.size());
+    const uint32_t span = uint32_t(int64_t(last_day) - first_day);
+    #pragma omp parallel
+    {
+        std::vector<uint32_t> local(buckets.size(), 0);
+        #pragma omp for schedule(static) nowait
+        for (size_t i = 0; i < rows; i++) {
+            // One unsigned compare tests both ends of the window; invalid dates fall outside it
+            const uint32_t offset = uint32_t(days[i]) - uint32_t(first_day);
+            if (offset > span || days[i] == DateParser::kInvalidDate) continue;
+            const size_t bucket = bucket_of(offset, minutes[i]);
+            if (bucket != SIZE_MAX) local[bucket]++;
+        }
+        #pragma omp critical
+        for (size_t b = 0; b < buckets.size(); b++) buckets[b] += local[b];
+    }
+}
+
+} // namespace
+
+size_t TimeSeries::bucketCount(TimeBucket bucket, int32_t first_day, int32_t last_day) {
+    if (first_day > last_day) return 0;
+    const size_t days = size_t(int64_t(last_day) - first_day) + 1;
+    switch (bucket) {
+        case TimeBucket::Hour: return days * kHoursPerDay;
+        case TimeBucket::HourOfDay: return kHoursPerDay;
+        case TimeBucket::Day: return days;
+        case TimeBucket::Week: return (days + 6) / 7;
+    }
+    return 0;
+}
+
+const char* TimeSeries::bucketName(TimeBucket bucket) {
+    switch (bucket) {
+        case TimeBucket::Hour: return "hour";
+        case TimeBucket::HourOfDay: return "hour of day";
+        case TimeBucket::Day: return "day";
+        case TimeBucket::Week: return "week";
+    }
+    return "";
+}
+
+std::vector<uint32_t> TimeSeries::histogram(const std::vector<int32_t>& days, const std::vector<uint16_t>& minutes,
+                                            int32_t first_day, int32_t last_day, TimeBucket bucket) {
+    std::vector<uint32_t> buckets(bucketCount(bucket, first_day, last_day), 0);
+    if (buckets.empty()) return buckets;
+
+    switch (bucket) {
+        case TimeBucket::Hour:
+            countRows(days, minutes, first_day, last_day, buckets, [](uint32_t offset, uint16_t time) {
+                return time == DateParser::kInvalidTime ? SIZE_MAX : size_t(offset) * kHoursPerDay + time / kMinutesPerHour;
+            });
+            break;
+        case TimeBucket::HourOfDay:
+            countRows(days, minutes, first_day, last_day, buckets, [](uint32_t, uint16_t time) {
+                return time == DateParser::kInvalidTime ? SIZE_MAX : size_t(time / kMinutesPerHour);
+            });
+            break;
+        case TimeBucket::Day:
+            countRows(days, minutes, first_day, last_day, buckets, [](uint32_t offset, uint16_t) { return size_t(offset); });
+            break;
+        case TimeBucket::Week:
+            countRows(days, minutes, first_day, last_day, buckets, [](uint32_t offset, uint16_t) { return size_t(offset / 7); });
+            break;
+    }
+    return buckets;
+}
@@ -0,0 +1,31 @@
+#ifndef TIME_SERIES_H
+#define TIME_SERIES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Width of the buckets of a crash histogram over a window of days
+enum class TimeBucket {
+    Hour,       // every hour of the window: 24 buckets a day
+    HourOfDay,  // 24 buckets, each hour summed over the days of the window
+    Day,
+    Week        // 7-day buckets from the first day of the window; the last may be shorter
+};
+
+// Histograms of rows by day (days since 1970-01-01) and time of day (minutes since midnight)
+// over a window first_day..last_day. Rows outside the window or with an invalid date are not
+// counted; rows with an invalid time count towards Day and Week buckets only.
+class TimeSeries {
+public:
+    // Buckets a histogram of the window has; 0 when first_day > last_day
+    static size_t bucketCount(TimeBucket bucket, int32_t first_day, int32_t last_day);
+    static const char* bucketName(TimeBucket bucket);
+
+    // One parallel pass over the columns: each thread fills its own bucket array, and the
+    // arrays are summed at the end
+    static std::vector<uint32_t> histogram(const std::vector<int32_t>& days, const std::vector<uint16_t>& minutes,
+                                           int32_t first_day, int32_t last_day, TimeBucket bucket);
+};
+
+#endif // TIME_SERIES_H
@@ -0,0 +1,216 @@
+#include "TopKPairs.h"
+
+#include <algorithm>
+#include <functional>
+#include <omp.h>
+#include <queue>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+struct PairKey {
+    std::string_view first, second;
+
+    bool operator==(const PairKey& other) const = default;
+    bool operator<(const PairKey& other) const {
+        return first != other.first ? first < other.first : second < other.second;
+    }
+};
+
+struct PairKeyHash {
+    size_t operator()(const PairKey& key) const {
+        const size_t first = std::hash<std::string_view>{}(key.first);
+        return first ^ (std::hash<std::string_view>{}(key.second) + 0x9e3779b97f4a7c15ULL + (first << 6) + (first >> 2));
+    }
+};
+
+using PairWeights = std::unordered_map<PairKey, uint64_t, PairKeyHash>;
+
+std::string_view trim(std::string_view text) {
+    const size_t begin = text.find_first_not_of(' ');
+    if (begin == std::string_view::npos) return {};
+    return text.substr(begin, text.find_last_not_of(' ') - begin + 1);
+}
+
+// The pair of row, trimmed and ordered; false when either value is empty
+bool pairOf(const StringColumn& first, const StringColumn& second, uint32_t row, PairKey& key) {
+    std::string_view a = trim(first[row]), b = trim(second[row]);
+    if (a.empty() || b.empty()) return false;
+    if (b < a) std::swap(a, b);
+    key = {a, b};
+    return true;
+}
+
+// Heaviest first, then by name, so results do not depend on hash or thread order
+bool heavierFirst(const std::pair<uint64_t, PairKey>& a, const std::pair<uint64_t, PairKey>& b) {
+    return a.first != b.first ? a.first > b.first : a.second < b.second;
+}
+
+// Weighted Space-Saving: at most capacity counters in an indexed min-heap on count. A pair
+// not yet counted takes over the smallest counter once all are in use, inheriting its count
+// as error.
+class SpaceSaving {
+public:
+    struct Counter {
+        PairKey key;
+        uint64_t count = 0;
+        uint64_t error = 0;
+    };
+
+    explicit SpaceSaving(size_t capacity) : capacity(std::max<size_t>(capacity, 1)) {}
+
+    void add(const PairKey& key, uint64_t weight) {
+        auto found = positions.find(key);
+        if (found != positions.end()) {
+            heap[found->second].count += weight;
+            siftDown(found->second);
+        } else if (heap.size() < capacity) {
+            positions.emplace(key, heap.size());
+            heap.push_back({key, weight, 0});
+            siftUp(heap.size() - 1);
+        } else {
+            Counter& smallest = heap.front();
+            positions.erase(smallest.key);
+            smallest = {key, smallest.count + weight, smallest.count};
+            positions.emplace(key, 0);
+            siftDown(0);
+        }
+    }
+
+    [[nodiscard]] bool full() const { return heap.size() == capacity; }
+    // What an evicted or never-seen pair may have weighed at most
+    [[nodiscard]] uint64_t minimum() const { return full() ? heap.front().count : 0; }
+    [[nodiscard]] const std::vector<Counter>& counters() const { return heap; }
+    [[nodiscard]] bool contains(const PairKey& key) const { return positions.contains(key); }
+
+private:
+    void swapCounters(size_t a, size_t b) {
+        std::swap(heap[a], heap[b]);
+        positions[heap[a].key] = a;
+        positions[heap[b].key] = b;
+    }
+
+    void siftUp(size_t index) {
+        while (index > 0 && heap[index].count < heap[(index - 1) / 2].count) {
+            swapCounters(index, (index - 1) / 2);
+            index = (index - 1) / 2;
+        }
+    }
+
+    void siftDown(size_t index) {
+        for (;;) {
+            size_t smallest = index;
+            for (size_t child = 2 * index + 1; child <= 2 * index + 2 && child < heap.size(); child++) {
+                if (heap[child].count < heap[smallest].count) smallest = child;
+            }
+            if (smallest == index) return;
+            swapCounters(index, smallest);
+            index = smallest;
+        }
+    }
+
+    size_t capacity;
+    std::vector<Counter> heap;
+    std::unordered_map<PairKey, size_t, PairKeyHash> positions;
+};
+
+TopKPair materialize(const PairKey& key, uint64_t weight, uint64_t error) {
+    return {std::string(key.first), std::string(key.second), weight, error};
+}
+
+} // namespace
+
+std::vector<TopKPair> TopKPairs::exact(const StringColumn& first, const StringColumn& second,
+                                       const std::vector<int>& weights, const std::vector<uint32_t>& rows, size_t k) {
+    std::vector<PairWeights> partials(static_cast<size_t>(omp_get_max_threads()));
+    #pragma omp parallel
+    {
+        PairWeights& local = partials[size_t(omp_get_thread_num())];
+        PairKey key;
+        #pragma omp for schedule(static)
+        for (size_t i = 0; i < rows.size(); i++) {
+            const uint32_t row = rows[i];
+            if (weights[row] > 0 && pairOf(first, second, row, key)) local[key] += uint64_t(weights[row]);
+        }
+    }
+
+    // Merge into the largest table, then keep the k heaviest in a min-heap
+    std::sort(partials.begin(), partials.end(),
+              [](const PairWeights& a, const PairWeights& b) { return a.size() > b.size(); });
+    PairWeights& merged = partials.front();
+    for (size_t t = 1; t < partials.size(); t++) {
+        for (const auto& [key, weight] : partials[t]) merged[key] += weight;
+        PairWeights().swap(partials[t]);
+    }
+
+    using Entry = std::pair<uint64_t, PairKey>;
+    std::priority_queue<Entry, std::vector<Entry>, decltype(&heavierFirst)> heaviest(&heavierFirst);
+    for (const auto& [key, weight] : merged) {
+        if (k == 0) break;
+        if (heaviest.size() < k) {
+            heaviest.emplace(weight, key);
+        } else if (heavierFirst({weight, key}, heaviest.top())) {
+            heaviest.pop();
+            heaviest.emplace(weight, key);
+        }
+    }
+
+    std::vector<TopKPair> result(heaviest.size());
+    for (size_t i = result.size(); i-- > 0; heaviest.pop()) {
+        result[i] = materialize(heaviest.top().second, heaviest.top().first, 0);
+    }
+    return result;
+}
+
+std::vector<TopKPair> TopKPairs::approximate(const StringColumn& first, const StringColumn& second,
+                                             const std::vector<int>& weights, const std::vector<uint32_t>& rows,
+                                             size_t k) {
+    if (k == 0) return {};
+    const size_t capacity = k * kCountersPerResult;
+    std::vector<SpaceSaving> sketches(static_cast<size_t>(omp_get_max_threads()), SpaceSaving(capacity));
+    #pragma omp parallel
+    {
+        SpaceSaving& local = sketches[size_t(omp_get_thread_num())];
+        PairKey key;
+        #pragma omp for schedule(static)
+        for (size_t i = 0; i < rows.size(); i++) {
+            const uint32_t row = rows[i];
+            if (weights[row] > 0 && pairOf(first, second, row, key)) local.add(key, uint64_t(weights[row]));
+        }
+    }
+
+    // A pair a sketch does not hold may have weighed up to that sketch's minimum there, which
+    // is added to both its count and its error
+    std::unordered_map<PairKey, SpaceSaving::Counter, PairKeyHash> merged;
+    for (const SpaceSaving& sketch : sketches) {
+        for (const SpaceSaving::Counter& counter : sketch.counters()) merged.try_emplace(counter.key, counter.key);
+    }
+    for (auto& [key, counter] : merged) {
+        for (const SpaceSaving& sketch : sketches) {
+            if (sketch.contains(key)) continue;
+            counter.count += sketch.minimum();
+            counter.error += sketch.minimum();
+        }
+    }
+    for (const SpaceSaving& sketch : sketches) {
+        for (const SpaceSaving::Counter& counter : sketch.counters()) {
+            merged[counter.key].count += counter.count;
+            merged[counter.key].error += counter.error;
+        }
+    }
+
+    std::vector<std::pair<uint64_t, PairKey>> entries;
+    entries.reserve(merged.size());
+    for (const auto& [key, counter] : merged) entries.emplace_back(counter.count, key);
+    const size_t kept = std::min(k, entries.size());
+    std::partial_sort(entries.begin(), entries.begin() + ptrdiff_t(kept), entries.end(), heavierFirst);
+
+    std::vector<TopKPair> result;
+    result.reserve(kept);
+    for (size_t i = 0; i < kept; i++) {
+        result.push_back(materialize(entries[i].second, entries[i].first, merged[entries[i].second].error));
+    }
+    return result;
+}
@@ -0,0 +1,40 @@
+#ifndef TOP_K_PAIRS_H
+#define TOP_K_PAIRS_H
+
+#include "StringColumn.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct TopKPair {
+    std::string first, second;  // first <= second
+    uint64_t weight = 0;
+    uint64_t error = 0;  // approximate results: weight may exceed the true sum by up to this
+};
+
+// The k text pairs (first[row], second[row]) with the largest sum of weights[row] over a
+// selection of rows, heaviest first (ties by name). Values are trimmed of surrounding spaces
+// and a pair is unordered, so "A & B" and "B & A" add up; rows where either value is empty
+// are skipped. Each thread counts its share of the rows into a private table; the tables are
+// merged at the end. The text columns must outlive the call only.
+class TopKPairs {
+public:
+    // Space-Saving counters kept per requested result by approximate
+    static constexpr size_t kCountersPerResult = 16;
+
+    // Hash tables of every distinct pair, then a size-k min-heap over the merged table
+    static std::vector<TopKPair> exact(const StringColumn& first, const StringColumn& second,
+                                       const std::vector<int>& weights, const std::vector<uint32_t>& rows, size_t k);
+
+    // Space-Saving sketches of k * kCountersPerResult counters per thread, merged by adding up
+    // each pair's counts (or a sketch's minimum where the pair was evicted). Memory stays
+    // bounded however many distinct pairs there are; heavy pairs are kept, and each result's
+    // weight is an upper bound that is at most error above the true sum.
+    static std::vector<TopKPair> approximate(const StringColumn& first, const StringColumn& second,
+                                             const std::vector<int>& weights, const std::vector<uint32_t>& rows,
+                                             size_t k);
+};
+
+#endif // TOP_K_PAIRS_H
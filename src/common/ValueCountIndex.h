@@ -0,0 +1,130 @@
+#ifndef VALUE_COUNT_INDEX_H
+#define VALUE_COUNT_INDEX_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Index of a small-domain integer column (casualty counts: almost all 0-10). Keeps the
+// number of rows per value as prefix sums, so a range count is two lookups, plus a row
+// bitmap per value bucket for listing the matching rows. Values min..min+15 get a bucket
+// each; above that buckets double in width (16-31, 32-63, ...), so rare large values don't
+// cost a bitmap apiece.
+class ValueCountIndex {
+public:
+    // Widest value range the index accepts
+    static constexpr int64_t kMaxDomain = 256;
+
+    // Indexes values; false (and an empty index) if max - min exceeds kMaxDomain
+    template <typename T>
+    bool build(const std::vector<T>& values) {
+        *this = ValueCountIndex();
+        if (values.empty()) return true;
+        const auto [min, max] = std::minmax_element(values.begin(), values.end());
+        if (int64_t(*max) - int64_t(*min) >= kMaxDomain) return false;
+        min_value = int64_t(*min);
+        row_count = values.size();
+
+        // Per-thread histograms, summed into prefix[v + 1]
+        const size_t domain = size_t(int64_t(*max) - min_value) + 1;
+        prefix.assign(domain + 1, 0);
+        #pragma omp parallel
+        {
+            std::vector<uint32_t> local(domain, 0);
+            #pragma omp for schedule(static) nowait
+            for (size_t i = 0; i < values.size(); i++) local[size_t(int64_t(values[i]) - min_value)]++;
+            #pragma omp critical
+            for (size_t v = 0; v < domain; v++) prefix[v + 1] += local[v];
+        }
+        for (size_t v = 0; v < domain; v++) prefix[v + 1] += prefix[v];
+
+        // Bitmaps only for buckets that have rows; each thread owns whole 64-row words
+        bitmaps.resize(bucketOf(domain - 1) + 1);
+        const size_t words = (row_count + 63) / 64;
+        for (size_t bucket = 0; bucket < bitmaps.size(); bucket++) {
+            const auto [first, last] = bucketValues(bucket);
+            if (prefix[std::min(last, domain - 1) + 1] > prefix[first]) bitmaps[bucket].assign(words, 0);
+        }
+        #pragma omp parallel for schedule(static)
+        for (size_t word = 0; word < words; word++) {
+            const size_t end = std::min(row_count, (word + 1) * 64);
+            for (size_t row = word * 64; row < end; row++) {
+                bitmaps[bucketOf(size_t(int64_t(values[row]) - min_value))][word] |= uint64_t(1) << (row % 64);
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool empty() const { return prefix.empty(); }
+
+    // Rows with low <= value <= high
+    [[nodiscard]] size_t count(int64_t low, int64_t high) const {
+        if (prefix.empty()) return 0;
+        const int64_t domain = int64_t(prefix.size()) - 1;
+        const int64_t first = std::max<int64_t>(low - min_value, 0);
+        const int64_t last = std::min<int64_t>(high - min_value, domain - 1);
+        if (first > last) return 0;
+        return prefix[size_t(last) + 1] - prefix[size_t(first)];
+    }
+
+    // Ascending rows with low <= value <= high. values must be the indexed column: rows of
+    // buckets only partly inside the range are checked against it.
+    template <typename T>
+    [[nodiscard]] std::vector<uint32_t> rows(const std::vector<T>& values, int64_t low, int64_t high) const {
+        std::vector<uint32_t> matches;
+        const size_t expected = count(low, high);
+        if (expected == 0) return matches;
+        matches.reserve(expected);
+
+        const size_t first = size_t(std::max<int64_t>(low - min_value, 0));
+        const size_t last = size_t(std::min<int64_t>(high - min_value, int64_t(prefix.size()) - 2));
+        std::vector<uint64_t> combined((row_count + 63) / 64, 0);
+        std::vector<uint64_t> partial(combined.size(), 0);
+        for (size_t bucket = bucketOf(first); bucket <= bucketOf(last); bucket++) {
+            if (bitmaps[bucket].empty()) continue;
+            const auto [bucket_first, bucket_last] = bucketValues(bucket);
+            std::vector<uint64_t>& target = bucket_first >= first && bucket_last <= last ? combined : partial;
+            for (size_t word = 0; word < combined.size(); word++) target[word] |= bitmaps[bucket][word];
+        }
+
+        for (size_t word = 0; word < combined.size(); word++) {
+            for (uint64_t bits = combined[word] | partial[word]; bits != 0; bits &= bits - 1) {
+                const size_t row = word * 64 + size_t(std::countr_zero(bits));
+                const bool in_range = (combined[word] >> (row % 64) & 1) ||
+                                      (int64_t(values[row]) >= low && int64_t(values[row]) <= high);
+                if (in_range) matches.push_back(uint32_t(row));
+            }
+        }
+        return matches;
+    }
+
+    // Heap bytes of the prefix sums and bitmaps
+    [[nodiscard]] size_t memoryBytes() const {
+        size_t bytes = prefix.capacity() * sizeof(uint32_t);
+        for (const std::vector<uint64_t>& bitmap : bitmaps) bytes += bitmap.capacity() * sizeof(uint64_t);
+        return bytes;
+    }
+
+private:
+    static constexpr size_t kExactBuckets = 16;
+
+    // Bucket of value - min, and the (value - min) range a bucket covers
+    static size_t bucketOf(size_t offset) {
+        return offset < kExactBuckets ? offset : kExactBuckets + size_t(std::bit_width(offset)) - 5;
+    }
+    static std::pair<size_t, size_t> bucketValues(size_t bucket) {
+        if (bucket < kExactBuckets) return {bucket, bucket};
+        const size_t first = size_t(1) << (bucket - kExactBuckets + 4);
+        return {first, 2 * first - 1};
+    }
+
+    int64_t min_value = 0;
+    size_t row_count = 0;
+    std::vector<uint32_t> prefix;                 // prefix[v] = rows with value - min < v
+    std::vector<std::vector<uint64_t>> bitmaps;  // per bucket; empty when no row falls in it
+};
+
+#endif // VALUE_COUNT_INDEX_H
@@ -0,0 +1,118 @@
+#ifndef ZONE_MAP_H
+#define ZONE_MAP_H
+
+#include "RangeCount.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// How a block's [min, max] relates to a queried range
+enum class ZoneMatch {
+    None,  // no row can match: skip the block
+    Some,  // rows must be compared one by one
+    All    // every row matches: count the block from its metadata
+};
+
+template <typename T>
+ZoneMatch matchZone(T min, T max, T low, T high) {
+    if (low > high || high < min || low > max) return ZoneMatch::None;
+    if (low <= min && max <= high) return ZoneMatch::All;
+    return ZoneMatch::Some;
+}
+
+// What a range count did with the blocks of a column
+struct ZoneScanStats {
+    size_t blocks = 0;
+    size_t skipped = 0;
+    size_t full = 0;
+
+    [[nodiscard]] size_t scanned() const { return blocks - skipped - full; }
+};
+
+// Min/max of every kBlockRows-row block of a numeric column. Range counts skip blocks that
+// cannot match and count blocks that match in full without reading their values, so narrow
+// ranges over clustered data (e.g. dates of a sorted column) touch only a few blocks.
+template <typename T>
+class ZoneMap {
+public:
+    static constexpr size_t kBlockRows = 4096;
+
+    void build(const std::vector<T>& values) {
+        row_count = values.size();
+        zones.resize((values.size() + kBlockRows - 1) / kBlockRows);
+        #pragma omp parallel for schedule(static)
+        for (size_t b = 0; b < zones.size(); b++) {
+            const auto first = values.begin() + b * kBlockRows;
+            const auto last = values.begin() + std::min(values.size(), (b + 1) * kBlockRows);
+            const auto [min, max] = std::minmax_element(first, last);
+            zones[b] = {*min, *max};
+        }
+    }
+
+    [[nodiscard]] size_t blockCount() const { return zones.size(); }
+
+    // How block b relates to [low, high]
+    [[nodiscard]] ZoneMatch matchBlock(size_t b, T low, T high) const {
+        return matchZone(zones[b].min, zones[b].max, low, high);
+    }
+
+    // Estimated fraction of rows in [low, high]: blocks that match in full or not at all count
+    // exactly, the others by how much of their [min, max] the range overlaps
+    [[nodiscard]] double estimateSelectivity(T low, T high) const {
+        if (row_count == 0) return 0;
+        double rows = 0;
+        for (size_t b = 0; b < zones.size(); b++) {
+            const double block_rows = double(std::min(kBlockRows, row_count - b * kBlockRows));
+            switch (matchBlock(b, low, high)) {
+                case ZoneMatch::None:
+                    break;
+                case ZoneMatch::All:
+                    rows += block_rows;
+                    break;
+                case ZoneMatch::Some: {
+                    const double span = double(zones[b].max) - double(zones[b].min) + 1;
+                    const double overlap = double(std::min(high, zones[b].max)) - double(std::max(low, zones[b].min)) + 1;
+                    rows += block_rows * std::min(1.0, overlap / span);
+                    break;
+                }
+            }
+        }
+        return rows / double(row_count);
+    }
+
+    // Rows of values, the column the map was built from, with low <= value <= high
+    [[nodiscard]] size_t countInRange(const std::vector<T>& values, T low, T high, ZoneScanStats& stats) const {
+        size_t count = 0, skipped = 0, full = 0;
+        #pragma omp parallel for reduction(+:count, skipped, full) schedule(static)
+        for (size_t b = 0; b < zones.size(); b++) {
+            const size_t first = b * kBlockRows;
+            const size_t rows = std::min(kBlockRows, row_count - first);
+            switch (matchZone(zones[b].min, zones[b].max, low, high)) {
+                case ZoneMatch::None:
+                    skipped++;
+                    break;
+                case ZoneMatch::All:
+                    full++;
+                    count += rows;
+                    break;
+                case ZoneMatch::Some:
+                    count += RangeCount::count(values.data() + first, rows, low, high);
+                    break;
+            }
+        }
+        stats = {zones.size(), skipped, full};
+        return count;
+    }
+
+private:
+    struct Zone {
+        T min;
+        T max;
+    };
+
+    std::vector<Zone> zones;
+    size_t row_count = 0;
+};
+
+#endif // ZONE_MAP_H
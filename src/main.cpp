@@ -1,4 +1,6 @@
 #include <iostream>
+#include <algorithm>
+#include <filesystem>
 #include "SequentialProcessor/Experiment1IfStream/ProcessorUsingIfStream.h"
 #include "SequentialProcessor/Experiment2BufferRead/ProcessorUsingBufferedFileRead.h"
 #include "SequentialProcessor/Experiment3BufferReadVectorReserve/ProcessorUsingBufferedFileReadVectorReserve.h"
@@ -11,14 +13,23 @@
 #include "OptimalProcessor/Experiment4BufferReadVectorReserveThreadLocalBuffer/ProcessorUsingThreadLocalBuffer.h"
 #include "OptimalProcessor/Experiment5BufferReadVectorReserveThreadLocalPartialRead/ProcessorUsingPartialRead.h"
 #include "OptimalProcessor/Experiment6BufferReadVectorReserveThreadLocalPartialRead/ProcessorUsingEpochTime.h"
+#include "Benchmarks/MicroBenchmarks.h"
+
+const std::string kCrashDataFile = "../motor_vehicle_collisions.csv";
 
 
 void runProcessor(std::unique_ptr<ICrashDataProcessor>& processor) {
-    std::string filename = "../motor_vehicle_collisions.csv";
+    const std::string& filename = kCrashDataFile;
 
     std::cout << "Loading data..." << std::endl;
     processor->loadData(filename);
     std::cout << "Data load duration: " << processor->getDataLoadDuration().count() << " seconds" << std::endl;
+    std::error_code size_error;
+    auto file_size = std::filesystem::file_size(filename, size_error);
+    if (!size_error && processor->getDataLoadDuration().count() > 0) {
+        std::cout << "Parse throughput: " << (file_size / (1024.0 * 1024.0)) / processor->getDataLoadDuration().count()
+                  << " MB/s" << std::endl;
+    }
 
     std::string start_date, end_date;
     std::cout << "Enter start date (MM/DD/YYYY): ";
@@ -71,14 +82,46 @@ int main() {
                      ",thread local buffer and partial file read\n";
         std::cout << "12. Optimized Multi Thread Processor- Object of Arrays, buffer file read, vector memory reserve "
                      ",thread local buffer, partial file read and epoch time\n";
-        std::cout << "13. Exit\n";
+        std::cout << "13. Optimized Multi Thread Processor- epoch time with the scalar tokenizer (baseline for option 12)\n";
+        std::cout << "14. Optimized Multi Thread Processor- epoch time, loading only the date, injury and location columns\n";
+        std::cout << "15. Optimized Multi Thread Processor- epoch time with zero-copy text columns over the retained mmap\n";
+        std::cout << "16. Optimized Multi Thread Processor- epoch time, reloading from a binary column snapshot when "
+                     "the CSV is unchanged\n";
+        std::cout << "17. Optimized Multi Thread Processor- epoch time with block-compressed date, injury and collision "
+                     "id columns\n";
+        std::cout << "18. Optimized Multi Thread Processor- epoch time with rows clustered by crash date (binary-search "
+                     "date ranges)\n";
+        std::cout << "19. Optimized Multi Thread Processor- epoch time with per-day prefix counts (O(1) date ranges, "
+                     "per-borough breakdown)\n";
+        std::cout << "20. Optimized Multi Thread Processor- epoch time with a value-count index on persons injured "
+                     "(O(1) injury ranges)\n";
+        std::cout << "21. Optimized Multi Thread Processor- epoch time with a uniform-grid spatial index for location "
+                     "queries\n";
+        std::cout << "22. Optimized Multi Thread Processor- epoch time with compressed bitmap result sets (date AND "
+                     "injury AND location queries)\n";
+        std::cout << "23. Optimized Multi Thread Processor- epoch time with conjunctive queries (borough, date, injury "
+                     "and location in one selectivity-ordered pass)\n";
+        std::cout << "24. Optimized Multi Thread Processor- epoch time with a fused date + injury + location scan "
+                     "(individual and combined counts in one pass)\n";
+        std::cout << "25. Optimized Multi Thread Processor- epoch time with a group-by of borough x contributing "
+                     "factor x year (count, injury sum/min/max/avg)\n";
+        std::cout << "26. Optimized Multi Thread Processor- epoch time with all casualty counts (killed, pedestrians, "
+                     "cyclists, motorists) as byte columns\n";
+        std::cout << "27. Optimized Multi Thread Processor- epoch time with time-bucketed series (crashes per hour of "
+                     "day and per week, scanned or from per-day x hour counts)\n";
+        std::cout << "28. Optimized Multi Thread Processor- epoch time with the top-K intersections by injuries in a "
+                     "date window (exact and Space-Saving)\n";
+        std::cout << "29. Optimized Multi Thread Processor- epoch time with result rows of a date window, "
+                     "materialized 100 at a time through a cursor\n";
+        std::cout << "30. Micro-benchmarks\n";
+        std::cout << "31. Exit\n";
         std::cout << "=====================================================\n";
         std::cout << "Select processing method: ";
 
         int choice;
         std::cin >> choice;
 
-        if (choice == 13) {
+        if (choice == 31) {
             std::cout << "Exiting program. Goodbye!\n";
             break;
         }
@@ -162,6 +205,408 @@ int main() {
             runProcessor(processor);
             break;
 
+            case 13:
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with the scalar tokenizer\n";
+            processor = std::make_unique<ProcessorUsingEpochTime>(false);
+            runProcessor(processor);
+            break;
+
+            case 14: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with projection pushdown\n";
+                auto projected = std::make_unique<ProcessorUsingEpochTime>();
+                projected->setColumnProjection(CrashColumnSet::forQueries(
+                    {CrashQueryKind::DateRange, CrashQueryKind::InjuryRange, CrashQueryKind::LocationRange}));
+                processor = std::move(projected);
+                runProcessor(processor);
+                break;
+            }
+
+            case 15: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with zero-copy text columns\n";
+                auto zero_copy = std::make_unique<ProcessorUsingEpochTime>();
+                zero_copy->setZeroCopyStrings(true);
+                processor = std::move(zero_copy);
+                runProcessor(processor);
+                break;
+            }
+
+            case 16: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with a binary column snapshot\n";
+                auto snapshot = std::make_unique<ProcessorUsingEpochTime>();
+                snapshot->setSnapshotPath(kCrashDataFile + ".snapshot");
+                processor = std::move(snapshot);
+                runProcessor(processor);
+                break;
+            }
+
+            case 17: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with compressed columns\n";
+                auto compressed = std::make_unique<ProcessorUsingEpochTime>();
+                compressed->setCompressedColumns(true);
+                processor = std::move(compressed);
+                runProcessor(processor);
+                break;
+            }
+
+            case 18: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with rows clustered by crash date\n";
+                auto clustered = std::make_unique<ProcessorUsingEpochTime>();
+                clustered->setDateClustering(true);
+                processor = std::move(clustered);
+                runProcessor(processor);
+                break;
+            }
+
+            case 19: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with per-day prefix counts\n";
+                auto daily = std::make_unique<ProcessorUsingEpochTime>();
+                daily->setDailyCounts(true);
+                ProcessorUsingEpochTime& daily_processor = *daily;
+                processor = std::move(daily);
+                runProcessor(processor);
+
+                std::string start_date, end_date;
+                std::cout << "Borough breakdown - enter start date (MM/DD/YYYY): ";
+                std::cin >> start_date;
+                std::cout << "Enter end date (MM/DD/YYYY): ";
+                std::cin >> end_date;
+                for (const auto& [name, count] : daily_processor.getCrashesInDateRangeByBorough(start_date, end_date)) {
+                    std::cout << "  " << (name.empty() ? "(unknown)" : name) << ": " << count << "\n";
+                }
+                break;
+            }
+
+            case 20: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with a value-count index\n";
+                auto indexed = std::make_unique<ProcessorUsingEpochTime>();
+                indexed->setValueIndexes(true);
+                processor = std::move(indexed);
+                runProcessor(processor);
+                break;
+            }
+
+            case 21: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with a spatial grid index\n";
+                auto gridded = std::make_unique<ProcessorUsingEpochTime>();
+                gridded->setSpatialIndex(true);
+                processor = std::move(gridded);
+                runProcessor(processor);
+                break;
+            }
+
+            case 22: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with compressed bitmap result sets\n";
+                auto bitmapped = std::make_unique<ProcessorUsingEpochTime>();
+                bitmapped->setValueIndexes(true);
+                bitmapped->setSpatialIndex(true);
+                ProcessorUsingEpochTime& bitmap_processor = *bitmapped;
+                processor = std::move(bitmapped);
+                runProcessor(processor);
+
+                std::string start_date, end_date;
+                int min_injuries, max_injuries;
+                float lat, lon, radius;
+                std::cout << "Combined query - enter start date (MM/DD/YYYY): ";
+                std::cin >> start_date;
+                std::cout << "Enter end date (MM/DD/YYYY): ";
+                std::cin >> end_date;
+                std::cout << "Enter minimum injuries: ";
+                std::cin >> min_injuries;
+                std::cout << "Enter maximum injuries: ";
+                std::cin >> max_injuries;
+                std::cout << "Enter latitude: ";
+                std::cin >> lat;
+                std::cout << "Enter longitude: ";
+                std::cin >> lon;
+                std::cout << "Enter radius (km): ";
+                std::cin >> radius;
+
+                // The second run finds all three bitmaps in the cache and only intersects them
+                for (const char* run : {"first run", "cached"}) {
+                    auto start = std::chrono::high_resolution_clock::now();
+                    auto dates = bitmap_processor.getCrashBitmapInDateRange(start_date, end_date);
+                    auto injuries = bitmap_processor.getCrashBitmapByInjuryCountRange(min_injuries, max_injuries);
+                    auto location = bitmap_processor.getCrashBitmapByLocationRange(lat, lon, radius);
+                    size_t matches = location->intersect(*injuries).intersectCount(*dates);
+                    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+                    std::cout << "Crashes matching date AND injury AND location (" << run << "): " << matches << " in "
+                              << duration.count() * 1000 << " ms\n";
+                    std::cout << "  bitmaps: date " << dates->cardinality() << " rows / " << dates->memoryBytes() / 1024
+                              << " KB, injury " << injuries->cardinality() << " rows / "
+                              << injuries->memoryBytes() / 1024 << " KB, location " << location->cardinality()
+                              << " rows / " << location->memoryBytes() / 1024 << " KB\n";
+                }
+                break;
+            }
+
+            case 23: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with conjunctive queries\n";
+                auto conjunctive = std::make_unique<ProcessorUsingEpochTime>();
+                ProcessorUsingEpochTime& query_processor = *conjunctive;
+                processor = std::move(conjunctive);
+                runProcessor(processor);
+
+                std::string borough, start_date, end_date;
+                int min_injuries, max_injuries;
+                float lat, lon, radius;
+                std::cout << "Combined query - enter borough (e.g. BROOKLYN): ";
+                std::cin >> std::ws;
+                std::getline(std::cin, borough);
+                std::cout << "Enter start date (MM/DD/YYYY): ";
+                std::cin >> start_date;
+                std::cout << "Enter end date (MM/DD/YYYY): ";
+                std::cin >> end_date;
+                std::cout << "Enter minimum injuries: ";
+                std::cin >> min_injuries;
+                std::cout << "Enter maximum injuries: ";
+                std::cin >> max_injuries;
+                std::cout << "Enter latitude: ";
+                std::cin >> lat;
+                std::cout << "Enter longitude: ";
+                std::cin >> lon;
+                std::cout << "Enter radius (km): ";
+                std::cin >> radius;
+
+                CrashQuery query;
+                query.equals(CrashColumn::Borough, borough)
+                    .dateBetween(start_date, end_date)
+                    .between(CrashColumn::PersonsInjured, min_injuries, max_injuries)
+                    .within(lat, lon, radius);
+                auto start = std::chrono::high_resolution_clock::now();
+                size_t matches = query_processor.countMatching(query);
+                std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+                std::cout << "Crashes matching all predicates: " << matches << " in " << duration.count() * 1000
+                          << " ms\n";
+                break;
+            }
+
+            case 24: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with a fused filter scan\n";
+                auto fused = std::make_unique<ProcessorUsingEpochTime>();
+                ProcessorUsingEpochTime& fused_processor = *fused;
+                processor = std::move(fused);
+                runProcessor(processor);
+
+                std::string start_date, end_date;
+                int min_injuries, max_injuries;
+                float lat, lon, radius;
+                std::cout << "Combined query - enter start date (MM/DD/YYYY): ";
+                std::cin >> start_date;
+                std::cout << "Enter end date (MM/DD/YYYY): ";
+                std::cin >> end_date;
+                std::cout << "Enter minimum injuries: ";
+                std::cin >> min_injuries;
+                std::cout << "Enter maximum injuries: ";
+                std::cin >> max_injuries;
+                std::cout << "Enter latitude: ";
+                std::cin >> lat;
+                std::cout << "Enter longitude: ";
+                std::cin >> lon;
+                std::cout << "Enter radius (km): ";
+                std::cin >> radius;
+
+                auto start = std::chrono::high_resolution_clock::now();
+                CrashFilterCounts counts = fused_processor.getCrashFilterCounts(start_date, end_date, min_injuries,
+                                                                                max_injuries, lat, lon, radius);
+                std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+                std::cout << "Date range: " << counts.date << ", injury range: " << counts.injury
+                          << ", location range: " << counts.location << ", all three: " << counts.all << " ("
+                          << duration.count() * 1000 << " ms, one pass)\n";
+                break;
+            }
+
+            case 25: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with a group-by aggregation\n";
+                auto grouping = std::make_unique<ProcessorUsingEpochTime>();
+                ProcessorUsingEpochTime& group_processor = *grouping;
+                processor = std::move(grouping);
+                runProcessor(processor);
+
+                auto start = std::chrono::high_resolution_clock::now();
+                GroupResult result = group_processor.groupBy(
+                    {CrashColumn::Borough, CrashColumn::ContributingFactorVehicle1, CrashColumn::CrashDate});
+                std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+                std::cout << "Groups: " << result.groups.size() << " in " << duration.count() * 1000 << " ms ("
+                          << (result.dense ? "dense arrays" : "hash tables") << ")\n";
+
+                std::vector<const GroupRow*> largest;
+                for (const GroupRow& group : result.groups) largest.push_back(&group);
+                const size_t shown = std::min<size_t>(10, largest.size());
+                std::partial_sort(largest.begin(), largest.begin() + ptrdiff_t(shown), largest.end(),
+                                  [](const GroupRow* a, const GroupRow* b) { return a->count > b->count; });
+                for (size_t i = 0; i < shown; i++) {
+                    const GroupRow& group = *largest[i];
+                    std::cout << "  " << result.label(group, 0) << " | " << result.label(group, 1) << " | "
+                              << result.label(group, 2) << ": " << group.count << " crashes, injured sum "
+                              << group.aggregates[0].sum << ", min " << group.aggregates[0].min << ", max "
+                              << group.aggregates[0].max << ", avg " << group.average(0);
+                    if (result.measure_names.size() > 1) {
+                        std::cout << ", " << result.measure_names[1] << " sum " << group.aggregates[1].sum;
+                    }
+                    std::cout << "\n";
+                }
+                break;
+            }
+
+            case 26: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with casualty count columns\n";
+                auto casualties = std::make_unique<ProcessorUsingEpochTime>();
+                ProcessorUsingEpochTime& casualty_processor = *casualties;
+                processor = std::move(casualties);
+                runProcessor(processor);
+
+                int min_count, max_count;
+                std::cout << "Casualty counts - enter minimum: ";
+                std::cin >> min_count;
+                std::cout << "Enter maximum: ";
+                std::cin >> max_count;
+                for (CrashColumn column : {CrashColumn::PersonsInjured, CrashColumn::PersonsKilled,
+                                           CrashColumn::PedestriansInjured, CrashColumn::PedestriansKilled,
+                                           CrashColumn::CyclistsInjured, CrashColumn::CyclistsKilled,
+                                           CrashColumn::MotoristsInjured, CrashColumn::MotoristsKilled}) {
+                    auto start = std::chrono::high_resolution_clock::now();
+                    int crash_count = casualty_processor.getCrashesByCasualtyCountRange(column, min_count, max_count);
+                    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+                    std::cout << crashColumnName(column) << " in range: " << crash_count << " ("
+                              << duration.count() * 1000 << " ms)\n";
+                }
+                break;
+            }
+
+            case 27: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with time-bucketed series\n";
+                auto series = std::make_unique<ProcessorUsingEpochTime>();
+                ProcessorUsingEpochTime& series_processor = *series;
+                series_processor.setHourlyCounts(true);
+                processor = std::move(series);
+                runProcessor(processor);
+
+                std::string start_date, end_date;
+                std::cout << "Time series - enter start date (MM/DD/YYYY): ";
+                std::cin >> start_date;
+                std::cout << "Enter end date (MM/DD/YYYY): ";
+                std::cin >> end_date;
+
+                for (TimeBucket bucket : {TimeBucket::HourOfDay, TimeBucket::Week}) {
+                    auto cube_start = std::chrono::high_resolution_clock::now();
+                    std::vector<uint32_t> from_cube = series_processor.getCrashTimeSeries(start_date, end_date, bucket);
+                    std::chrono::duration<double> cube_duration = std::chrono::high_resolution_clock::now() - cube_start;
+                    series_processor.setHourlyCounts(false);
+                    auto scan_start = std::chrono::high_resolution_clock::now();
+                    std::vector<uint32_t> scanned = series_processor.getCrashTimeSeries(start_date, end_date, bucket);
+                    std::chrono::duration<double> scan_duration = std::chrono::high_resolution_clock::now() - scan_start;
+                    series_processor.setHourlyCounts(true);
+
+                    std::cout << "Crashes per " << TimeSeries::bucketName(bucket) << ": " << scanned.size()
+                              << " buckets, scan " << scan_duration.count() * 1000 << " ms, hourly counts "
+                              << cube_duration.count() * 1000 << " ms" << (from_cube == scanned ? "" : " (MISMATCH)")
+                              << "\n";
+                    if (bucket == TimeBucket::HourOfDay) {
+                        for (size_t hour = 0; hour < scanned.size(); hour++) {
+                            std::cout << "  " << (hour < 10 ? "0" : "") << hour << ":00 " << scanned[hour] << "\n";
+                        }
+                    } else if (!scanned.empty()) {
+                        auto busiest = std::max_element(scanned.begin(), scanned.end());
+                        std::cout << "  busiest week: week " << busiest - scanned.begin() + 1 << " with " << *busiest
+                                  << " crashes\n";
+                    }
+                }
+                break;
+            }
+
+            case 28: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with top-K intersections\n";
+                auto top_k = std::make_unique<ProcessorUsingEpochTime>();
+                ProcessorUsingEpochTime& top_k_processor = *top_k;
+                processor = std::move(top_k);
+                runProcessor(processor);
+
+                std::string start_date, end_date;
+                size_t k;
+                std::cout << "Top intersections - enter start date (MM/DD/YYYY): ";
+                std::cin >> start_date;
+                std::cout << "Enter end date (MM/DD/YYYY): ";
+                std::cin >> end_date;
+                std::cout << "Enter K: ";
+                std::cin >> k;
+
+                for (bool approximate : {false, true}) {
+                    auto start = std::chrono::high_resolution_clock::now();
+                    std::vector<TopKPair> top =
+                        top_k_processor.getTopIntersectionsByInjuries(start_date, end_date, k, approximate);
+                    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+                    std::cout << (approximate ? "Space-Saving" : "Exact") << " top " << top.size() << " in "
+                              << duration.count() * 1000 << " ms:\n";
+                    for (const TopKPair& pair : top) {
+                        std::cout << "  " << pair.first << " & " << pair.second << ": " << pair.weight << " injured";
+                        if (approximate) std::cout << " (overcount at most " << pair.error << ")";
+                        std::cout << "\n";
+                    }
+                }
+                break;
+            }
+
+            case 29: {
+                std::cout << "\nOptimized Multi Thread Processor- epoch time with paged result rows\n";
+                auto paged = std::make_unique<ProcessorUsingEpochTime>();
+                ProcessorUsingEpochTime& paged_processor = *paged;
+                processor = std::move(paged);
+                runProcessor(processor);
+
+                std::string start_date, end_date;
+                std::cout << "Result rows - enter start date (MM/DD/YYYY): ";
+                std::cin >> start_date;
+                std::cout << "Enter end date (MM/DD/YYYY): ";
+                std::cin >> end_date;
+
+                auto start = std::chrono::high_resolution_clock::now();
+                std::vector<uint32_t> rows = paged_processor.getCrashRowsInDateRange(start_date, end_date);
+                std::chrono::duration<double> select_duration = std::chrono::high_resolution_clock::now() - start;
+                std::cout << rows.size() << " rows selected in " << select_duration.count() * 1000 << " ms\n";
+
+                const CrashColumnSet shown{CrashColumn::CrashDate, CrashColumn::CrashTime, CrashColumn::Borough,
+                                           CrashColumn::OnStreetName, CrashColumn::CrossStreetName,
+                                           CrashColumn::PersonsInjured, CrashColumn::PersonsKilled,
+                                           CrashColumn::CollisionId};
+                ProcessorUsingEpochTime::RowCursor cursor = paged_processor.openCursor(std::move(rows), shown);
+
+                start = std::chrono::high_resolution_clock::now();
+                std::vector<CrashRecord> page = cursor.next();
+                std::chrono::duration<double> page_duration = std::chrono::high_resolution_clock::now() - start;
+                std::cout << "First page of " << page.size() << " rows in " << page_duration.count() * 1000
+                          << " ms, first " << std::min<size_t>(page.size(), 5) << ":\n";
+                for (size_t i = 0; i < page.size() && i < 5; i++) {
+                    const CrashRecord& record = page[i];
+                    std::cout << "  " << record.collision_id << "  " << record.crash_date << " " << record.crash_time
+                              << "  " << record.borough << "  " << record.on_street_name << " & "
+                              << record.cross_street_name << "  injured " << record.persons_injured << ", killed "
+                              << record.persons_killed << "\n";
+                }
+
+                size_t pages = page.empty() ? 0 : 1;
+                start = std::chrono::high_resolution_clock::now();
+                while (!cursor.done()) {
+                    cursor.next();
+                    pages++;
+                }
+                page_duration = std::chrono::high_resolution_clock::now() - start;
+                std::cout << "Paged through all " << cursor.size() << " rows (" << pages << " pages) in "
+                          << page_duration.count() * 1000 << " ms\n";
+
+                start = std::chrono::high_resolution_clock::now();
+                std::vector<CrashRecord> all_rows = paged_processor.materializeRows(
+                    paged_processor.getCrashRowsInDateRange(start_date, end_date));
+                std::chrono::duration<double> all_duration = std::chrono::high_resolution_clock::now() - start;
+                std::cout << "Selecting and materializing every column of all " << all_rows.size() << " rows: "
+                          << all_duration.count() * 1000 << " ms\n";
+                break;
+            }
+
+            case 30:
+                std::cout << "\nRunning micro-benchmarks...\n";
+                MicroBenchmarks::runAll(kCrashDataFile);
+                break;
+
             default:
                 std::cout << "Invalid choice. Please enter a valid option.\n";
         }
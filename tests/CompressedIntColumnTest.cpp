@@ -0,0 +1,96 @@
+#include "TestSupport.h"
+#include "common/CompressedIntColumn.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Codec = CompressedIntColumn::Codec;
+constexpr size_t kBlockRows = CompressedIntColumn::kBlockRows;
+
+size_t bruteForceCount(const std::vector<int>& values, int64_t low, int64_t high) {
+    size_t count = 0;
+    for (int value : values) count += value >= low && value <= high;
+    return count;
+}
+
+// Decodes, reads single rows and counts ranges, all against the plain values
+void checkAgainstPlain(const std::vector<int>& values) {
+    const CompressedIntColumn column = CompressedIntColumn::encode(values);
+    CHECK_EQ(column.size(), values.size());
+    CHECK_EQ(column.blockCount(), (values.size() + kBlockRows - 1) / kBlockRows);
+
+    std::vector<int> decoded;
+    column.decode(decoded);
+    CHECK(decoded == values);
+    for (size_t row = 0; row < values.size(); row += 97) CHECK_EQ(column.value(row), int64_t(values[row]));
+    if (!values.empty()) CHECK_EQ(column.value(values.size() - 1), int64_t(values.back()));
+
+    int64_t min = 0, max = 0;
+    if (!values.empty()) {
+        const auto [low, high] = std::minmax_element(values.begin(), values.end());
+        min = *low;
+        max = *high;
+    }
+    const std::pair<int64_t, int64_t> ranges[] = {
+        {min, max}, {min - 10, max + 10}, {min, min}, {max, max}, {max + 1, max + 100}, {min - 100, min - 1},
+        {min + (max - min) / 3, min + 2 * (max - min) / 3}, {5, 4}, {INT64_MIN, INT64_MAX}};
+    for (const auto& [low, high] : ranges) {
+        const size_t expected = bruteForceCount(values, low, high);
+        CHECK_EQ(column.countInRange(low, high), expected);
+        ZoneScanStats stats;
+        CHECK_EQ(column.countInRange(low, high, stats), expected);
+        CHECK_EQ(stats.blocks, column.blockCount());
+    }
+}
+
+} // namespace
+
+TEST_CASE(CompressedIntColumn_codecsPerBlock) {
+    std::vector<int> values(3 * kBlockRows);
+    for (size_t i = 0; i < kBlockRows; i++) values[i] = 7;                                 // constant
+    for (size_t i = kBlockRows; i < 2 * kBlockRows; i++) values[i] = int(i % 13);          // small range
+    for (size_t i = 2 * kBlockRows; i < 3 * kBlockRows; i++) values[i] = 4000000 + int(i) * 2;  // sequential ids
+    const CompressedIntColumn column = CompressedIntColumn::encode(values);
+    CHECK_EQ(column.blockCount(Codec::Constant), size_t(1));
+    CHECK_EQ(column.blockCount(Codec::FrameOfReference), size_t(1));
+    CHECK_EQ(column.blockCount(Codec::Delta), size_t(1));
+    checkAgainstPlain(values);
+}
+
+TEST_CASE(CompressedIntColumn_roundTripSizes) {
+    std::mt19937 random(42);
+    for (size_t rows : {size_t(0), size_t(1), kBlockRows - 1, kBlockRows, kBlockRows + 1, 5 * kBlockRows + 17}) {
+        std::vector<int> values(rows);
+        std::uniform_int_distribution<int> injured(0, 12);
+        for (int& value : values) value = injured(random);
+        checkAgainstPlain(values);
+    }
+}
+
+TEST_CASE(CompressedIntColumn_roundTripDistributions) {
+    std::mt19937 random(7);
+    const size_t rows = 4 * kBlockRows + 123;
+
+    std::vector<int> wide(rows);  // the full int range, 32-bit codes
+    std::uniform_int_distribution<int> any(INT32_MIN, INT32_MAX);
+    for (int& value : wide) value = any(random);
+    checkAgainstPlain(wide);
+
+    std::vector<int> negative(rows);
+    std::uniform_int_distribution<int> around_zero(-500, 500);
+    for (int& value : negative) value = around_zero(random);
+    checkAgainstPlain(negative);
+
+    std::vector<int> descending(rows);  // negative deltas
+    for (size_t i = 0; i < rows; i++) descending[i] = 1000000 - int(i) * 3 + int(random() % 3);
+    checkAgainstPlain(descending);
+
+    std::vector<int> sparse(rows, 0);  // mostly zero, the persons_injured shape
+    for (size_t i = 0; i < rows; i += 1 + random() % 50) sparse[i] = int(1 + random() % 20);
+    checkAgainstPlain(sparse);
+}
@@ -0,0 +1,128 @@
+#include "TestSupport.h"
+#include "common/DailyCounts.h"
+#include "common/DateParser.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Crashes {
+    std::vector<int32_t> days;
+    std::vector<uint8_t> boroughs;
+};
+
+const std::vector<std::string> kBoroughs = {"BRONX", "BROOKLYN", "MANHATTAN", "QUEENS", "STATEN ISLAND"};
+
+// Days over two years of 2020..2021, with invalid dates and days nobody crashed on mixed in
+Crashes randomCrashes(size_t count, uint32_t seed) {
+    std::mt19937 random(seed);
+    const int32_t first = DateParser::parseDate("01/01/2020");
+    Crashes crashes;
+    for (size_t i = 0; i < count; i++) {
+        int32_t day = first + int32_t(random() % 730);
+        if (i % 97 == 0) day = DateParser::kInvalidDate;
+        else if ((day - first) % 30 == 7) day++;  // leave gaps in the span
+        crashes.days.push_back(day);
+        crashes.boroughs.push_back(uint8_t(random() % kBoroughs.size()));
+    }
+    return crashes;
+}
+
+size_t bruteForceCount(const Crashes& crashes, int32_t first_day, int32_t last_day, int64_t borough = -1) {
+    size_t count = 0;
+    for (size_t i = 0; i < crashes.days.size(); i++) {
+        if (crashes.days[i] == DateParser::kInvalidDate || crashes.days[i] < first_day || crashes.days[i] > last_day) continue;
+        count += borough < 0 || crashes.boroughs[i] == borough;
+    }
+    return count;
+}
+
+// Every range of a sweep across (and past both ends of) the span, in total and per borough
+size_t mismatchedRanges(const DailyCounts& counts, const Crashes& crashes, bool by_borough) {
+    const int32_t first = DateParser::parseDate("06/01/2019");
+    size_t mismatched = 0;
+    for (int32_t start = first; start < first + 1300; start += 37) {
+        for (int32_t length : {-1, 0, 1, 6, 29, 364, 2000}) {
+            mismatched += counts.count(start, start + length) != bruteForceCount(crashes, start, start + length);
+            if (!by_borough) continue;
+            for (uint32_t borough = 0; borough < kBoroughs.size(); borough++) {
+                mismatched += counts.count(start, start + length, borough) !=
+                              bruteForceCount(crashes, start, start + length, borough);
+            }
+        }
+    }
+    return mismatched;
+}
+
+} // namespace
+
+TEST_CASE(DailyCounts_buildMatchesBruteForce) {
+    const Crashes crashes = randomCrashes(50000, 1);
+    const DictionaryColumn boroughs =
+        DictionaryColumn::fromParts(kBoroughs, crashes.boroughs.data(), crashes.boroughs.size(), 1);
+
+    DailyCounts counts;
+    counts.build(crashes.days, &boroughs);
+    CHECK_EQ(counts.categoryCount(), kBoroughs.size());
+    CHECK_EQ(mismatchedRanges(counts, crashes, true), size_t(0));
+    CHECK_EQ(counts.count(DateParser::kInvalidDate, INT32_MAX), bruteForceCount(crashes, INT32_MIN, INT32_MAX));
+    CHECK_EQ(counts.count(0, 0, uint32_t(kBoroughs.size())), size_t(0));
+
+    // Categories whose size does not match the days are ignored
+    DailyCounts totals;
+    totals.build(crashes.days, nullptr);
+    CHECK_EQ(totals.categoryCount(), size_t(0));
+    CHECK_EQ(mismatchedRanges(totals, crashes, false), size_t(0));
+}
+
+TEST_CASE(DailyCounts_addMatchesBuild) {
+    // Half the rows built, the rest appended one by one: days before and after the built
+    // span grow it at either end
+    Crashes crashes = randomCrashes(20000, 2);
+    Crashes built;
+    for (size_t i = 0; i < crashes.days.size(); i++) {
+        const int32_t day = crashes.days[i];
+        if (day != DateParser::kInvalidDate && (day - crashes.days[1]) % 4 == 0) continue;
+        if (i % 2 == 0) continue;
+        built.days.push_back(day);
+        built.boroughs.push_back(crashes.boroughs[i]);
+    }
+    const DictionaryColumn boroughs =
+        DictionaryColumn::fromParts(kBoroughs, built.boroughs.data(), built.boroughs.size(), 1);
+    DailyCounts counts;
+    counts.build(built.days, &boroughs);
+
+    Crashes all = built;
+    std::mt19937 random(3);
+    for (size_t i = 0; i < crashes.days.size(); i += 2) {
+        int32_t day = crashes.days[i];
+        if (i % 500 == 0 && day != DateParser::kInvalidDate) day += int32_t(random() % 2 ? -400 : 400);
+        counts.add(day, crashes.boroughs[i]);
+        all.days.push_back(day);
+        all.boroughs.push_back(crashes.boroughs[i]);
+    }
+    CHECK_EQ(mismatchedRanges(counts, all, true), size_t(0));
+}
+
+TEST_CASE(DailyCounts_addFromEmpty) {
+    DailyCounts counts;
+    CHECK(counts.empty());
+    CHECK_EQ(counts.count(INT32_MIN, INT32_MAX), size_t(0));
+    counts.add(DateParser::kInvalidDate);
+    CHECK(counts.empty());
+
+    Crashes crashes;
+    for (int32_t day : {18500, 18500, 18490, 18520, 18300, 18800, 18501}) {
+        counts.add(day);
+        crashes.days.push_back(day);
+        crashes.boroughs.push_back(0);
+    }
+    CHECK(!counts.empty());
+    CHECK_EQ(counts.categoryCount(), size_t(0));
+    CHECK_EQ(mismatchedRanges(counts, crashes, false), size_t(0));
+    CHECK_EQ(counts.count(18500, 18500), size_t(2));
+    CHECK_EQ(counts.count(18500, 18500, 0), size_t(0));  // no categories were built
+}
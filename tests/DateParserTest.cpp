@@ -0,0 +1,78 @@
+#include "TestSupport.h"
+#include "common/DateParser.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_CASE(DateParser_knownDates) {
+    CHECK_EQ(DateParser::parseDate("01/01/1970"), 0);
+    CHECK_EQ(DateParser::parseDate("12/31/1969"), -1);
+    CHECK_EQ(DateParser::parseDate("03/01/2000"), 11017);
+    CHECK_EQ(DateParser::parseDate("2/29/2024"), DateParser::parseDate("02/29/2024"));
+    CHECK_EQ(DateParser::parseDate("07/04/2021"), 18812);
+    CHECK_EQ(DateParser::yearFromDays(DateParser::parseDate("12/31/2012")), 2012);
+    CHECK_EQ(DateParser::yearFromDays(DateParser::parseDate("01/01/2013")), 2013);
+    CHECK_EQ(DateParser::formatDate(DateParser::parseDate("7/4/2021")), std::string("07/04/2021"));
+    CHECK_EQ(DateParser::formatDate(DateParser::kInvalidDate), std::string());
+
+    CHECK_EQ(DateParser::parseTimeOfDay("0:00"), uint16_t(0));
+    CHECK_EQ(DateParser::parseTimeOfDay("23:59"), uint16_t(1439));
+    CHECK_EQ(DateParser::parseTimeOfDay("24:00"), DateParser::kInvalidTime);
+    CHECK_EQ(DateParser::parseTimeOfDay("9:5"), uint16_t(545));
+}
+
+TEST_CASE(DateParser_civilRoundTrip) {
+    // days -> (year, month, day) -> days and days -> text -> days over 1700..2300
+    size_t mismatched = 0;
+    for (int32_t days = -98000; days <= 121000; days++) {
+        int32_t year = 0;
+        uint32_t month = 0, day = 0;
+        DateParser::civilFromDays(days, year, month, day);
+        mismatched += DateParser::daysFromCivil(year, month, day) != days;
+        mismatched += DateParser::parseDate(DateParser::formatDate(days)) != days;
+        mismatched += DateParser::yearFromDays(days) != year;
+    }
+    CHECK_EQ(mismatched, size_t(0));
+}
+
+TEST_CASE(DateParser_batchMatchesScalar) {
+    std::mt19937 random(11);
+    std::vector<std::string> texts;
+    for (int i = 0; i < 5000; i++) {
+        const int32_t days = int32_t(random() % 25000);  // 1970..2038
+        std::string text = DateParser::formatDate(days);
+        switch (random() % 12) {
+            case 0: text.erase(0, text[0] == '0' ? 1 : 0); break;           // unpadded month
+            case 1: text[1] = 'x'; break;                                   // not a digit
+            case 2: text[2] = '-'; break;                                   // wrong separator
+            case 3: text.replace(0, 2, "13"); break;                        // month out of range
+            case 4: text.replace(3, 2, "00"); break;                        // day out of range
+            case 5: text += ' '; break;                                     // trailing byte
+            case 6: text.pop_back(); break;                                 // three-digit year
+            case 7: text = random() % 2 ? "" : "CRASH DATE"; break;
+            default: break;
+        }
+        texts.push_back(std::move(text));
+    }
+
+    std::vector<std::string_view> views(texts.begin(), texts.end());
+    // Every batch length up to 40 from every start, so pairs and tails land everywhere
+    for (size_t first = 0; first < 64; first++) {
+        for (size_t count = 0; count <= 40 && first + count <= views.size(); count++) {
+            std::vector<int32_t> batch(count + 1, 12345);
+            DateParser::parseDates(views.data() + first, count, batch.data());
+            size_t mismatched = batch[count] != 12345;  // nothing written past count
+            for (size_t i = 0; i < count; i++) mismatched += batch[i] != DateParser::parseDate(views[first + i]);
+            CHECK_EQ(mismatched, size_t(0));
+        }
+    }
+
+    std::vector<int32_t> all(views.size());
+    DateParser::parseDates(views.data(), views.size(), all.data());
+    size_t mismatched = 0;
+    for (size_t i = 0; i < views.size(); i++) mismatched += all[i] != DateParser::parseDate(views[i]);
+    CHECK_EQ(mismatched, size_t(0));
+}
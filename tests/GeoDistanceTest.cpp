@@ -0,0 +1,105 @@
+#include "TestSupport.h"
+#include "common/GeoDistance.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Points {
+    std::vector<float> latitudes, longitudes;
+};
+
+// Points around New York, plus the stray (0, 0) and NaN coordinates real rows carry
+Points cityPoints(size_t count, uint32_t seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> lat(40.45f, 40.95f), lon(-74.3f, -73.65f);
+    Points points;
+    for (size_t i = 0; i < count; i++) {
+        points.latitudes.push_back(lat(random));
+        points.longitudes.push_back(lon(random));
+    }
+    for (size_t i = 0; i < count; i += 37) points.latitudes[i] = points.longitudes[i] = 0;
+    points.latitudes[1] = std::numeric_limits<float>::quiet_NaN();
+    return points;
+}
+
+size_t bruteForceCount(const float* latitudes, const float* longitudes, size_t count, const GeoCircle& circle) {
+    size_t matches = 0;
+    for (size_t i = 0; i < count; i++) matches += GeoDistance::contains(circle, latitudes[i], longitudes[i]);
+    return matches;
+}
+
+} // namespace
+
+TEST_CASE(GeoDistance_kernelsMatchContains) {
+    const Points points = cityPoints(5000, 1);
+    const GeoCircle circles[] = {GeoDistance::circle(40.7, -73.9, 1), GeoDistance::circle(40.7, -73.9, 12),
+                                 GeoDistance::circle(40.7, -73.9, 500), GeoDistance::circle(0, 0, 0.5),
+                                 GeoDistance::circle(40.7, -73.9, -1)};
+    for (const GeoCircle& circle : circles) {
+        for (size_t offset : {size_t(0), size_t(5)}) {
+            for (size_t count = 0; count + offset <= points.latitudes.size(); count += count < 100 ? 1 : 613) {
+                const float* latitudes = points.latitudes.data() + offset;
+                const float* longitudes = points.longitudes.data() + offset;
+                const size_t expected = bruteForceCount(latitudes, longitudes, count, circle);
+                CHECK_EQ(GeoDistance::countWithin(latitudes, longitudes, count, circle), expected);
+
+                std::vector<uint64_t> words((count + 63) / 64, ~uint64_t(0));
+                GeoDistance::selectWithin(latitudes, longitudes, count, circle, words.data());
+                size_t mismatched = 0;
+                for (size_t i = 0; i < count; i++) {
+                    const bool selected = (words[i / 64] >> (i % 64)) & 1;
+                    mismatched += selected != GeoDistance::contains(circle, latitudes[i], longitudes[i]);
+                }
+                if (count % 64 != 0) mismatched += words.back() >> (count % 64) != 0;
+                CHECK_EQ(mismatched, size_t(0));
+            }
+        }
+
+        const size_t expected = bruteForceCount(points.latitudes.data(), points.longitudes.data(),
+                                                points.latitudes.size(), circle);
+        CHECK_EQ(GeoDistance::countWithin(points.latitudes, points.longitudes, circle), expected);
+        size_t selected = 0;
+        for (uint64_t word : GeoDistance::selectWithin(points.latitudes, points.longitudes, circle)) {
+            selected += size_t(__builtin_popcountll(word));
+        }
+        CHECK_EQ(selected, expected);
+    }
+}
+
+TEST_CASE(GeoDistance_matchesHaversine) {
+    // Points clearly inside or outside by the great-circle distance must be classified so;
+    // only a thin band around the radius (float coordinates, linearised cosine) may differ
+    const Points points = cityPoints(20000, 2);
+    size_t misclassified = 0;
+    for (double radius_km : {0.5, 2.0, 10.0, 40.0}) {
+        const double lat0 = 40.71, lon0 = -73.95;
+        const GeoCircle circle = GeoDistance::circle(lat0, lon0, radius_km);
+        const double band_km = radius_km * 1e-3 + 0.005;
+        for (size_t i = 0; i < points.latitudes.size(); i++) {
+            const double distance =
+                GeoDistance::haversineKm(lat0, lon0, points.latitudes[i], points.longitudes[i]);
+            if (std::isnan(distance) || std::abs(distance - radius_km) <= band_km) continue;
+            misclassified += GeoDistance::contains(circle, points.latitudes[i], points.longitudes[i]) !=
+                             (distance < radius_km);
+        }
+    }
+    CHECK_EQ(misclassified, size_t(0));
+}
+
+TEST_CASE(GeoDistance_invalidCircles) {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const GeoCircle circles[] = {GeoDistance::circle(40.7, -73.9, -0.1), GeoDistance::circle(nan, -73.9, 5),
+                                 GeoDistance::circle(40.7, nan, 5)};
+    for (const GeoCircle& circle : circles) {
+        CHECK(!GeoDistance::contains(circle, 40.7f, -73.9f));
+        const std::vector<float> latitudes(100, 40.7f), longitudes(100, -73.9f);
+        CHECK_EQ(GeoDistance::countWithin(latitudes, longitudes, circle), size_t(0));
+    }
+    // A zero radius still holds its own centre
+    CHECK(GeoDistance::contains(GeoDistance::circle(40.75, -73.5, 0), 40.75f, -73.5f));
+}
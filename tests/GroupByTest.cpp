@@ -0,0 +1,141 @@
+#include "TestSupport.h"
+#include "common/DateParser.h"
+#include "common/GroupBy.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <omp.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Crashes {
+    std::vector<uint16_t> streets;  // codes of a sorted dictionary of kStreets names
+    std::vector<int32_t> days;
+    std::vector<uint8_t> killed;
+    std::vector<int32_t> injured;
+};
+
+constexpr size_t kStreets = 400;
+
+std::vector<std::string> streetNames() {
+    std::vector<std::string> names;
+    char name[16];
+    for (size_t i = 0; i < kStreets; i++) {
+        std::snprintf(name, sizeof(name), "STREET %03zu", i);
+        names.emplace_back(name);
+    }
+    return names;
+}
+
+// Streets skewed towards low codes over 2012..2024, with invalid dates and negative values
+Crashes randomCrashes(size_t count, uint32_t seed) {
+    std::mt19937 random(seed);
+    const int32_t first = DateParser::parseDate("07/01/2012");
+    Crashes crashes;
+    for (size_t i = 0; i < count; i++) {
+        crashes.streets.push_back(uint16_t(random() % (random() % 2 ? 20 : kStreets)));
+        crashes.days.push_back(i % 101 == 0 ? DateParser::kInvalidDate : first + int32_t(random() % 4500));
+        crashes.killed.push_back(uint8_t(random() % 3));
+        crashes.injured.push_back(int32_t(random() % 12) - 1);
+    }
+    return crashes;
+}
+
+using Groups = std::map<std::vector<uint32_t>, GroupRow>;
+
+// Street and year per row, aggregated in a single pass over the selected rows
+Groups bruteForceGroups(const Crashes& crashes, const GroupKey& year_key, const std::vector<uint32_t>& rows) {
+    Groups groups;
+    const uint32_t invalid_year = uint32_t(year_key.cardinality() - 1);
+    for (uint32_t row : rows) {
+        const int32_t day = crashes.days[row];
+        const uint32_t year = day == DateParser::kInvalidDate
+                                  ? invalid_year
+                                  : uint32_t(DateParser::yearFromDays(day) - std::stoi(year_key.label(0)));
+        GroupRow& group = groups[{crashes.streets[row], year}];
+        group.aggregates.resize(2);
+        group.count++;
+        const int64_t values[] = {crashes.killed[row], crashes.injured[row]};
+        for (size_t m = 0; m < 2; m++) {
+            group.aggregates[m].sum += values[m];
+            group.aggregates[m].min = std::min(group.aggregates[m].min, values[m]);
+            group.aggregates[m].max = std::max(group.aggregates[m].max, values[m]);
+        }
+    }
+    return groups;
+}
+
+size_t mismatchedGroups(const GroupResult& result, const Groups& expected) {
+    size_t mismatched = result.groups.size() != expected.size();
+    std::vector<uint32_t> previous;
+    for (const GroupRow& group : result.groups) {
+        mismatched += !previous.empty() && !(previous < group.codes);  // ordered by key codes
+        previous = group.codes;
+        const auto found = expected.find(group.codes);
+        if (found == expected.end()) {
+            mismatched++;
+            continue;
+        }
+        mismatched += group.count != found->second.count;
+        for (size_t m = 0; m < 2; m++) {
+            mismatched += group.aggregates[m].sum != found->second.aggregates[m].sum ||
+                          group.aggregates[m].min != found->second.aggregates[m].min ||
+                          group.aggregates[m].max != found->second.aggregates[m].max;
+        }
+    }
+    return mismatched;
+}
+
+} // namespace
+
+TEST_CASE(GroupBy_denseFits) {
+    CHECK(GroupBy::denseFits(1, 0, 1));
+    CHECK(GroupBy::denseFits(GroupBy::kDenseGroups, 0, 1));
+    CHECK(!GroupBy::denseFits(GroupBy::kDenseGroups + 1, 0, 1));
+    // 100000 slots of a count and two aggregates are 5.6 MB a thread: 11 threads fit, 12 do not
+    CHECK(GroupBy::denseFits(100000, 2, 11));
+    CHECK(!GroupBy::denseFits(100000, 2, 12));
+    CHECK(!GroupBy::denseFits(GroupBy::kDenseGroups, 4, 64));
+    CHECK_EQ(GroupBy::denseFits(1000, 2, 0), GroupBy::denseFits(1000, 2, 1));
+}
+
+TEST_CASE(GroupBy_matchesBruteForce) {
+    const Crashes crashes = randomCrashes(120000, 1);
+    const DictionaryColumn streets =
+        DictionaryColumn::fromParts(streetNames(), crashes.streets.data(), crashes.streets.size(), 2);
+    const GroupKey year = GroupKey::year("year", crashes.days);
+    CHECK_EQ(year.cardinality(), size_t(14));  // 2012..2024 and invalid
+
+    std::vector<uint32_t> all(crashes.days.size()), selection;
+    for (uint32_t row = 0; row < all.size(); row++) {
+        all[row] = row;
+        if (row % 3 != 1) selection.push_back(row);
+    }
+
+    // With two measures the 5600 groups always take dense arrays. With 200, a thread's array is
+    // 27 MB: one thread stays dense, three or more exceed kDenseTableBytes and use hash tables
+    const int threads = omp_get_max_threads();
+    for (int thread_count : {1, 3, 16}) {
+        omp_set_num_threads(thread_count);
+        for (size_t measure_count : {size_t(2), size_t(200)}) {
+            GroupBy group_by;
+            group_by.key(GroupKey::dictionary("street", streets)).key(year);
+            group_by.measure(GroupMeasure::of("killed", crashes.killed));
+            group_by.measure(GroupMeasure::of("injured", crashes.injured));
+            // Padding measures only change the table size, and so the dense/hash choice
+            for (size_t m = 2; m < measure_count; m++) group_by.measure(GroupMeasure::of("padding", crashes.killed));
+
+            const GroupResult result = group_by.run(crashes.days.size());
+            CHECK_EQ(result.dense, measure_count == 2 || thread_count == 1);
+            CHECK_EQ(mismatchedGroups(result, bruteForceGroups(crashes, year, all)), size_t(0));
+
+            const GroupResult selected = group_by.run(crashes.days.size(), &selection);
+            CHECK_EQ(mismatchedGroups(selected, bruteForceGroups(crashes, year, selection)), size_t(0));
+        }
+    }
+    omp_set_num_threads(threads);
+}
@@ -0,0 +1,111 @@
+#include "TestSupport.h"
+#include "common/RangeCount.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Isa = RangeCount::Isa;
+constexpr Isa kIsas[] = {Isa::Scalar, Isa::Sse42, Isa::Avx2, Isa::Avx512};
+
+template <typename T>
+size_t bruteForceCount(const T* values, size_t size, T low, T high) {
+    size_t count = 0;
+    for (size_t i = 0; i < size; i++) count += values[i] >= low && values[i] <= high;
+    return count;
+}
+
+// Every supported kernel, on every length 0..160 and a long tail, from an offset start so
+// loads are unaligned, against a plain loop; select's bits against the same test per value
+template <typename T>
+void checkKernels(const std::vector<T>& values, const std::vector<std::pair<T, T>>& ranges) {
+    for (const auto& [low, high] : ranges) {
+        for (size_t offset : {size_t(0), size_t(3)}) {
+            for (size_t size = 0; size + offset <= values.size(); size += size < 160 ? 1 : 997) {
+                const T* data = values.data() + offset;
+                const size_t expected = bruteForceCount(data, size, low, high);
+                for (Isa isa : kIsas) {
+                    if (!RangeCount::supported(isa)) continue;
+                    const size_t counted = RangeCount::count(data, size, low, high, isa);
+                    if (counted != expected) {
+                        std::cerr << RangeCount::isaName(isa) << " size " << size << " offset " << offset << ": ";
+                        CHECK_EQ(counted, expected);
+                    }
+                }
+
+                std::vector<uint64_t> words((size + 63) / 64, ~uint64_t(0));
+                RangeCount::select(data, size, low, high, words.data());
+                size_t mismatched = 0;
+                for (size_t i = 0; i < size; i++) {
+                    const bool selected = (words[i / 64] >> (i % 64)) & 1;
+                    mismatched += selected != (data[i] >= low && data[i] <= high);
+                }
+                if (size % 64 != 0) mismatched += words.back() >> (size % 64) != 0;  // no bits past the end
+                CHECK_EQ(mismatched, size_t(0));
+            }
+        }
+
+        CHECK_EQ(RangeCount::countColumn(values, low, high), bruteForceCount(values.data(), values.size(), low, high));
+        const std::vector<uint64_t> column_words = RangeCount::selectColumn(values, low, high);
+        size_t selected = 0;
+        for (uint64_t word : column_words) selected += size_t(__builtin_popcountll(word));
+        CHECK_EQ(selected, bruteForceCount(values.data(), values.size(), low, high));
+    }
+}
+
+template <typename T>
+std::vector<T> randomValues(size_t size, T low, T high, uint32_t seed) {
+    std::mt19937 random(seed);
+    std::vector<T> values(size);
+    if constexpr (std::is_floating_point_v<T>) {
+        std::uniform_real_distribution<T> distribution(low, high);
+        for (T& value : values) value = distribution(random);
+    } else {
+        std::uniform_int_distribution<int64_t> distribution(low, high);
+        for (T& value : values) value = T(distribution(random));
+    }
+    return values;
+}
+
+} // namespace
+
+TEST_CASE(RangeCount_int32) {
+    constexpr int32_t kMin = std::numeric_limits<int32_t>::min(), kMax = std::numeric_limits<int32_t>::max();
+    std::vector<int32_t> values = randomValues<int32_t>(12000, -50, 50, 1);
+    values[5] = kMin;
+    values[77] = kMax;
+    checkKernels<int32_t>(values, {{-10, 10}, {0, 0}, {kMin, kMax}, {kMin, -40}, {40, kMax}, {10, -10}, {51, 90}});
+}
+
+TEST_CASE(RangeCount_int64) {
+    constexpr int64_t kMin = std::numeric_limits<int64_t>::min(), kMax = std::numeric_limits<int64_t>::max();
+    std::vector<int64_t> values = randomValues<int64_t>(12000, -3000000000LL, 3000000000LL, 2);
+    values[9] = kMin;
+    values[100] = kMax;
+    checkKernels<int64_t>(values, {{-1000000000LL, 2500000000LL}, {kMin, kMax}, {kMin, kMin}, {kMax, kMax}, {1, 0}});
+}
+
+TEST_CASE(RangeCount_float) {
+    std::vector<float> values = randomValues<float>(12000, 40.4f, 41.0f, 3);
+    values[11] = std::numeric_limits<float>::quiet_NaN();
+    values[200] = -std::numeric_limits<float>::infinity();
+    values[201] = 0.0f;
+    const float kInfinity = std::numeric_limits<float>::infinity();
+    checkKernels<float>(values, {{40.5f, 40.8f}, {-kInfinity, kInfinity}, {0.0f, 0.0f}, {40.9f, 40.6f}});
+}
+
+TEST_CASE(RangeCount_uint8) {
+    std::vector<uint8_t> values = randomValues<uint8_t>(12000, 0, 255, 4);
+    checkKernels<uint8_t>(values, {{0, 0}, {1, 3}, {0, 255}, {200, 255}, {255, 255}, {9, 8}});
+}
+
+TEST_CASE(RangeCount_uint16) {
+    std::vector<uint16_t> values = randomValues<uint16_t>(12000, 0, 1439, 5);
+    values[31] = 65535;
+    checkKernels<uint16_t>(values, {{0, 59}, {600, 1439}, {0, 65535}, {65535, 65535}, {100, 99}});
+}
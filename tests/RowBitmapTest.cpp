@@ -0,0 +1,113 @@
+#include "TestSupport.h"
+#include "common/RowBitmap.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kRows = 6 * 65536 + 1234;
+
+// Rows of [0, kRows) kept with the given probability per 65536-row container, so sets mix
+// empty, array and bitset containers
+std::vector<uint32_t> randomRows(const std::vector<double>& density, uint32_t seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> coin(0, 1);
+    std::vector<uint32_t> rows;
+    for (uint32_t row = 0; row < kRows; row++) {
+        if (coin(random) < density[(row >> 16) % density.size()]) rows.push_back(row);
+    }
+    return rows;
+}
+
+std::vector<uint64_t> toWords(const std::vector<uint32_t>& rows) {
+    std::vector<uint64_t> words((kRows + 63) / 64, 0);
+    for (uint32_t row : rows) words[row / 64] |= uint64_t(1) << (row % 64);
+    return words;
+}
+
+void checkSame(const RowBitmap& bitmap, const std::vector<uint32_t>& expected) {
+    CHECK_EQ(bitmap.cardinality(), expected.size());
+    CHECK(bitmap.rows() == expected);
+    CHECK_EQ(bitmap.arrayContainers() + bitmap.bitsetContainers() > 0, !expected.empty());
+}
+
+template <typename Operation>
+std::vector<uint32_t> combine(const std::vector<uint32_t>& left, const std::vector<uint32_t>& right, Operation op) {
+    std::vector<uint32_t> result;
+    op(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(result));
+    return result;
+}
+
+} // namespace
+
+TEST_CASE(RowBitmap_construction) {
+    const std::vector<uint32_t> rows = randomRows({0.001, 0.5, 0.0, 0.9, 0.06, 0.0625}, 1);
+    checkSame(RowBitmap::fromWords(toWords(rows)), rows);
+
+    std::vector<uint32_t> shuffled = rows;
+    shuffled.insert(shuffled.end(), rows.begin(), rows.begin() + std::min<size_t>(rows.size(), 1000));  // duplicates
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(2));
+    checkSame(RowBitmap::fromRows(shuffled), rows);
+
+    const RowBitmap bitmap = RowBitmap::fromRows(rows);
+    CHECK(bitmap.arrayContainers() > 0);
+    CHECK(bitmap.bitsetContainers() > 0);
+    size_t mismatched = 0;
+    for (uint32_t row = 0; row < kRows; row += 7) {
+        mismatched += bitmap.contains(row) != std::binary_search(rows.begin(), rows.end(), row);
+    }
+    CHECK_EQ(mismatched, size_t(0));
+
+    std::vector<uint32_t> range;
+    for (uint32_t row = 65530; row < 3 * 65536 + 5; row++) range.push_back(row);
+    checkSame(RowBitmap::range(65530, 3 * 65536 + 5), range);
+    checkSame(RowBitmap::range(10, 10), {});
+    checkSame(RowBitmap::fromRows({}), {});
+}
+
+TEST_CASE(RowBitmap_setOperations) {
+    // Every pairing of array, bitset and missing containers occurs across the containers
+    const std::vector<uint32_t> left = randomRows({0.01, 0.7, 0.0, 0.7, 0.02, 0.3, 0.5}, 3);
+    const std::vector<uint32_t> right = randomRows({0.02, 0.01, 0.6, 0.8, 0.0, 0.3, 0.05}, 4);
+    const RowBitmap a = RowBitmap::fromRows(left);
+    const RowBitmap b = RowBitmap::fromWords(toWords(right));
+
+    const auto intersection = combine(left, right, [](auto... args) { return std::set_intersection(args...); });
+    const auto united = combine(left, right, [](auto... args) { return std::set_union(args...); });
+    const auto left_only = combine(left, right, [](auto... args) { return std::set_difference(args...); });
+    const auto right_only = combine(right, left, [](auto... args) { return std::set_difference(args...); });
+
+    checkSame(a.intersect(b), intersection);
+    checkSame(b.intersect(a), intersection);
+    checkSame(a.unite(b), united);
+    checkSame(b.unite(a), united);
+    checkSame(a.subtract(b), left_only);
+    checkSame(b.subtract(a), right_only);
+    CHECK_EQ(a.intersectCount(b), intersection.size());
+    CHECK_EQ(b.intersectCount(a), intersection.size());
+
+    const RowBitmap empty = RowBitmap::fromRows({});
+    checkSame(a.intersect(empty), {});
+    checkSame(a.unite(empty), left);
+    checkSame(a.subtract(a), {});
+    CHECK_EQ(a.intersectCount(empty), size_t(0));
+}
+
+TEST_CASE(RowBitmap_containerKinds) {
+    // A container switches to a bitset above kArrayLimit rows and back below it
+    std::vector<uint32_t> at_limit, above_limit;
+    for (uint32_t i = 0; i < RowBitmap::kArrayLimit; i++) at_limit.push_back(i * 3);
+    above_limit = at_limit;
+    above_limit.push_back(RowBitmap::kArrayLimit * 3);
+    CHECK_EQ(RowBitmap::fromRows(at_limit).bitsetContainers(), size_t(0));
+    CHECK_EQ(RowBitmap::fromRows(above_limit).bitsetContainers(), size_t(1));
+
+    const RowBitmap dense = RowBitmap::range(0, 65536);
+    const RowBitmap thinned = dense.intersect(RowBitmap::fromRows(at_limit));
+    checkSame(thinned, at_limit);
+    CHECK_EQ(thinned.bitsetContainers(), size_t(0));
+}
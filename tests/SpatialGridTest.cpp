@@ -0,0 +1,77 @@
+#include "TestSupport.h"
+#include "common/SpatialGrid.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Uniform points over the city, a dense cluster, duplicates and stray (0, 0) coordinates
+void cityPoints(size_t count, uint32_t seed, std::vector<float>& latitudes, std::vector<float>& longitudes) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> lat(40.5f, 40.92f), lon(-74.25f, -73.7f);
+    std::normal_distribution<float> cluster(0.0f, 0.002f);
+    for (size_t i = 0; i < count; i++) {
+        if (i % 50 == 0) {
+            latitudes.push_back(0);
+            longitudes.push_back(0);
+        } else if (i % 3 == 0) {
+            latitudes.push_back(40.758f + cluster(random));
+            longitudes.push_back(-73.9855f + cluster(random));
+        } else if (i % 11 == 0) {
+            latitudes.push_back(latitudes.back());
+            longitudes.push_back(longitudes.back());
+        } else {
+            latitudes.push_back(lat(random));
+            longitudes.push_back(lon(random));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE(SpatialGrid_matchesColumnScan) {
+    std::vector<float> latitudes, longitudes;
+    cityPoints(60000, 1, latitudes, longitudes);
+    const GeoCircle circles[] = {
+        GeoDistance::circle(40.758, -73.9855, 0.05), GeoDistance::circle(40.758, -73.9855, 0.4),
+        GeoDistance::circle(40.7, -73.9, 1),         GeoDistance::circle(40.7, -73.9, 5),
+        GeoDistance::circle(40.6, -74.1, 25),        GeoDistance::circle(40.7, -73.9, 300),
+        GeoDistance::circle(0, 0, 1),                GeoDistance::circle(35, -80, 10),
+        GeoDistance::circle(40.7, -73.9, -1),        GeoDistance::circle(40.7, -73.9, 0)};
+
+    for (double cell_degrees : {SpatialGrid::kDefaultCellDegrees, 0.0007, 0.1, 5.0}) {
+        SpatialGrid grid;
+        grid.build(latitudes, longitudes, cell_degrees);
+        CHECK(!grid.empty());
+        for (const GeoCircle& circle : circles) {
+            const size_t expected = GeoDistance::countWithin(latitudes, longitudes, circle);
+            GridScanStats stats;
+            CHECK_EQ(grid.countWithin(circle, stats), expected);
+            CHECK_EQ(stats.tested() + stats.skipped + stats.full, stats.cells);
+
+            std::vector<uint32_t> rows = grid.rowsWithin(circle, stats);
+            std::sort(rows.begin(), rows.end());
+            std::vector<uint32_t> expected_rows;
+            for (uint32_t row = 0; row < latitudes.size(); row++) {
+                if (GeoDistance::contains(circle, latitudes[row], longitudes[row])) expected_rows.push_back(row);
+            }
+            CHECK(rows == expected_rows);
+        }
+    }
+}
+
+TEST_CASE(SpatialGrid_emptyAndTiny) {
+    SpatialGrid grid;
+    grid.build({}, {});
+    GridScanStats stats;
+    CHECK_EQ(grid.countWithin(GeoDistance::circle(40.7, -73.9, 5), stats), size_t(0));
+    CHECK(grid.rowsWithin(GeoDistance::circle(40.7, -73.9, 5), stats).empty());
+
+    SpatialGrid single;
+    single.build({40.7f}, {-73.9f});
+    CHECK_EQ(single.countWithin(GeoDistance::circle(40.7, -73.9, 0.01), stats), size_t(1));
+    CHECK_EQ(single.countWithin(GeoDistance::circle(40.8, -73.9, 0.01), stats), size_t(0));
+}
@@ -0,0 +1,34 @@
+#include "TestSupport.h"
+
+#include <string_view>
+
+std::vector<TestCase>& testCases() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+size_t& testFailures() {
+    static size_t failures = 0;
+    return failures;
+}
+
+int main(int argc, char** argv) {
+    size_t run = 0;
+    for (const TestCase& test : testCases()) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc && !selected; i++) selected = std::string_view(test.name).starts_with(argv[i]);
+        if (!selected) continue;
+
+        const size_t failures_before = testFailures();
+        test.run();
+        std::cout << (testFailures() == failures_before ? "[ OK ] " : "[FAIL] ") << test.name << "\n";
+        run++;
+    }
+
+    if (run == 0) {
+        std::cerr << "No test cases match the given names" << std::endl;
+        return 1;
+    }
+    std::cout << run << " test cases, " << testFailures() << " failed checks\n";
+    return testFailures() == 0 ? 0 : 1;
+}
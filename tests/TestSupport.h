@@ -0,0 +1,49 @@
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Minimal self-registering test cases, so the tests need no framework:
+//   TEST_CASE(CompressedIntColumn_roundTrip) { CHECK_EQ(column.size(), values.size()); }
+// crash_tests runs every case, or those whose name starts with an argument, and exits
+// non-zero if any check failed. ctest runs one suite (name prefix) per test.
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestCase>& testCases();
+size_t& testFailures();
+
+struct TestRegistrar {
+    TestRegistrar(const char* name, void (*run)()) { testCases().push_back({name, run}); }
+};
+
+#define TEST_CASE(name)                                       \
+    static void name();                                       \
+    static const TestRegistrar name##_registrar(#name, name); \
+    static void name()
+
+#define CHECK(condition)                                                                          \
+    do {                                                                                          \
+        if (!(condition)) {                                                                       \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed\n";       \
+            testFailures()++;                                                                     \
+        }                                                                                         \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                                \
+    do {                                                                                          \
+        const auto& actual_value = (actual);                                                      \
+        const auto& expected_value = (expected);                                                  \
+        if (!(actual_value == expected_value)) {                                                  \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK_EQ(" #actual ", " #expected      \
+                      << ") failed: " << actual_value << " != " << expected_value << "\n";        \
+            testFailures()++;                                                                     \
+        }                                                                                         \
+    } while (0)
+
+#endif // TEST_SUPPORT_H
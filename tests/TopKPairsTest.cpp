@@ -0,0 +1,150 @@
+#include "TestSupport.h"
+#include "common/TopKPairs.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Streets {
+    StringColumn on_street, cross_street;
+    std::vector<int> injured;
+    std::vector<uint32_t> rows;
+};
+
+void addRow(Streets& streets, const std::string& on, const std::string& cross, int injured) {
+    streets.on_street.push_back(on);
+    streets.cross_street.push_back(cross);
+    streets.injured.push_back(injured);
+    streets.rows.push_back(uint32_t(streets.rows.size()));
+}
+
+std::string trimmed(const std::string& text) {
+    const size_t begin = text.find_first_not_of(' ');
+    return begin == std::string::npos ? std::string() : text.substr(begin, text.find_last_not_of(' ') - begin + 1);
+}
+
+// Sum of weights per unordered, trimmed pair over the selected rows
+std::map<std::pair<std::string, std::string>, uint64_t> bruteForceWeights(const Streets& streets) {
+    std::map<std::pair<std::string, std::string>, uint64_t> weights;
+    for (uint32_t row : streets.rows) {
+        std::string a = trimmed(streets.on_street.materialize(row)), b = trimmed(streets.cross_street.materialize(row));
+        if (a.empty() || b.empty() || streets.injured[row] <= 0) continue;
+        if (b < a) std::swap(a, b);
+        weights[{a, b}] += uint64_t(streets.injured[row]);
+    }
+    return weights;
+}
+
+// The k heaviest, ties by name, as exact should return them
+std::vector<TopKPair> bruteForceTop(const Streets& streets, size_t k) {
+    std::vector<TopKPair> all;
+    for (const auto& [pair, weight] : bruteForceWeights(streets)) all.push_back({pair.first, pair.second, weight, 0});
+    std::sort(all.begin(), all.end(), [](const TopKPair& a, const TopKPair& b) {
+        if (a.weight != b.weight) return a.weight > b.weight;
+        return a.first != b.first ? a.first < b.first : a.second < b.second;
+    });
+    all.resize(std::min(k, all.size()));
+    return all;
+}
+
+bool samePairs(const std::vector<TopKPair>& actual, const std::vector<TopKPair>& expected, bool compare_weights) {
+    if (actual.size() != expected.size()) return false;
+    for (size_t i = 0; i < actual.size(); i++) {
+        if (actual[i].first != expected[i].first || actual[i].second != expected[i].second) return false;
+        if (compare_weights && actual[i].weight != expected[i].weight) return false;
+    }
+    return true;
+}
+
+// Results whose weight does not bracket the true sum: true <= weight <= true + error
+size_t outOfBounds(const std::vector<TopKPair>& pairs,
+                   const std::map<std::pair<std::string, std::string>, uint64_t>& truth) {
+    size_t out_of_bounds = 0;
+    for (const TopKPair& pair : pairs) {
+        const auto found = truth.find({pair.first, pair.second});
+        const uint64_t true_weight = found == truth.end() ? 0 : found->second;
+        out_of_bounds += pair.weight < true_weight || pair.weight - pair.error > true_weight;
+    }
+    return out_of_bounds;
+}
+
+// Twelve heavy intersections, each 1.5x the crashes of the next, over a long tail of single
+// crashes, with padding, swapped order, empty names and uninjured rows mixed in
+Streets skewedStreets(size_t tail_rows, uint32_t seed) {
+    std::mt19937 random(seed);
+    Streets streets;
+    for (size_t i = 0; i < tail_rows; i++) {
+        const std::string a = "STREET " + std::to_string(random() % 4000);
+        const std::string b = "AVENUE " + std::to_string(random() % 4000);
+        addRow(streets, random() % 2 ? a : " " + a + "  ", b, int(random() % 3));
+    }
+    for (int heavy = 0; heavy < 12; heavy++) {
+        const std::string a = "BROADWAY " + std::to_string(heavy), b = "MAIN ST " + std::to_string(heavy);
+        for (int i = 0; i < int(400 * std::pow(1.5, heavy)); i++) {
+            if (i % 2) addRow(streets, a, b, 1 + int(random() % 4));
+            else addRow(streets, b, a, 1 + int(random() % 4));
+        }
+    }
+    for (int i = 0; i < 500; i++) addRow(streets, i % 2 ? "" : "BROADWAY 11", i % 2 ? "MAIN ST 11" : "   ", 9);
+    std::shuffle(streets.rows.begin(), streets.rows.end(), random);
+    return streets;
+}
+
+} // namespace
+
+TEST_CASE(TopKPairs_exactMatchesBruteForce) {
+    const Streets streets = skewedStreets(30000, 1);
+    for (size_t k : {size_t(0), size_t(1), size_t(10), size_t(250), size_t(1000000)}) {
+        CHECK(samePairs(TopKPairs::exact(streets.on_street, streets.cross_street, streets.injured, streets.rows, k),
+                        bruteForceTop(streets, k), true));
+    }
+
+    // Only the selected rows count
+    Streets selected = skewedStreets(5000, 2);
+    selected.rows.resize(selected.rows.size() / 3);
+    CHECK(samePairs(TopKPairs::exact(selected.on_street, selected.cross_street, selected.injured, selected.rows, 20),
+                    bruteForceTop(selected, 20), true));
+}
+
+TEST_CASE(TopKPairs_approximateBounds) {
+    for (uint32_t seed : {3u, 4u}) {
+        const Streets streets = skewedStreets(seed == 3 ? 30000 : 100000, seed);
+        const auto truth = bruteForceWeights(streets);
+        // Up to k = 5 the gap between neighbouring heavy intersections exceeds total weight /
+        // counters, the most Space-Saving can overcount by, so they come out exactly in order
+        for (size_t k : {size_t(1), size_t(3), size_t(5)}) {
+            const std::vector<TopKPair> approximate =
+                TopKPairs::approximate(streets.on_street, streets.cross_street, streets.injured, streets.rows, k);
+            CHECK(samePairs(approximate, bruteForceTop(streets, k), false));
+
+            CHECK_EQ(outOfBounds(approximate, truth), size_t(0));
+        }
+
+        // Past the heavy ones results blur, but every weight still brackets the true sum
+        const std::vector<TopKPair> deep =
+            TopKPairs::approximate(streets.on_street, streets.cross_street, streets.injured, streets.rows, 40);
+        CHECK_EQ(outOfBounds(deep, truth), size_t(0));
+        CHECK_EQ(deep.size(), size_t(40));
+    }
+}
+
+TEST_CASE(TopKPairs_approximateIsExactWhenPairsFit) {
+    // Fewer distinct pairs than counters: nothing is evicted and the sketch is exact
+    Streets streets;
+    std::mt19937 random(5);
+    for (int i = 0; i < 5000; i++) {
+        addRow(streets, "STREET " + std::to_string(i % 8), "AVENUE " + std::to_string(i % 5), int(random() % 5));
+    }
+    const size_t k = 5;
+    const std::vector<TopKPair> approximate =
+        TopKPairs::approximate(streets.on_street, streets.cross_street, streets.injured, streets.rows, k);
+    CHECK(samePairs(approximate, bruteForceTop(streets, k), true));
+    for (const TopKPair& pair : approximate) CHECK_EQ(pair.error, uint64_t(0));
+}